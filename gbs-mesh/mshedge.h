@@ -1,19 +1,20 @@
 #pragma once
 #include <gbs/curves>
 #include <gbs/bscanalysis.h>
+#include <gbs/curvearclength.h>
 namespace gbs
 {
     template <typename T, size_t dim>
     class msh_edge
     {
-        CurveReparametrized<T,dim> m_crv;
+        CurveArcLength<T,dim> m_crv;
         BSCfunction<T> m_law;
         points_vector<T, dim> m_pts;
         T l_;
         size_t n_;
     public:
         msh_edge(const std::shared_ptr<Curve<T, dim>> &p_crv) : 
-            m_crv{p_crv, abs_curv(*p_crv)},
+            m_crv{p_crv},
             n_{2},
             m_law{
                 std::vector<T>{ 0., 1.},
@@ -25,7 +26,7 @@ namespace gbs
         }
 
         msh_edge(std::shared_ptr<Curve<T, dim>> &p_crv,std::array<T,2> bounds) : 
-            m_crv{p_crv, abs_curv(*p_crv, bounds[0], bounds[1])},
+            m_crv{p_crv, bounds[0], bounds[1]},
             n_{2},
             m_law{
                 std::vector<T>{ 0., 1.},
@@ -74,7 +75,7 @@ namespace gbs
             m_pts.front() = m_crv.begin();
             m_pts.back()  = m_crv.end();
             std::transform(
-                // execution,
+                execution,
                 std::next(ksi.begin()),
                 std::next(ksi.end(),-1),
                 std::next(m_pts.begin()),
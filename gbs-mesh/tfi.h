@@ -5,6 +5,7 @@
 #include <gbs/curvescheck.h>
 #include <gbs/extrema.h>
 #include <gbs/bscbuild.h>
+#include <Eigen/Dense>
 namespace gbs
 {
     /**
@@ -351,12 +352,13 @@ namespace gbs
         for (size_t i{}; i < ni ; i++)
         {
             auto crv = crv_lst[i];
+            ArcLengthTable<T, dim> crv_length{*crv}; // built once, shared by the segments
             for (size_t ui{}; ui < nu - 1 ; ui++) // mesh between hard points
             {
                 // mesh segment
                 auto u1 = u[ui];
                 auto u2 = u[ui + 1];
-                auto params_crv_seg = uniform_distrib_params(*crv, u1, u2, nui[ui]);
+                auto params_crv_seg = uniform_distrib_params(crv_length, u1, u2, nui[ui]);
                 if (ui != u.size() - 2) // pop end for all but last segment
                     params_crv_seg.pop_back();
                 params[i].insert(params[i].end(), params_crv_seg.begin(), params_crv_seg.end());
@@ -413,12 +415,13 @@ namespace gbs
         for (size_t i{}; i < ni ; i++)
         {
             auto crv = crv_lst[i];
+            ArcLengthTable<T, dim> crv_length{*crv}; // built once, shared by the segments
             for (size_t ui{}; ui < nu - 1 ; ui++) // mesh between hard points
             {
                 // mesh segment
                 auto u1 = u_lst[i][ui];
                 auto u2 = u_lst[i][ui + 1];
-                auto params_crv_seg = uniform_distrib_params(*crv, u1, u2, nui[ui]);
+                auto params_crv_seg = uniform_distrib_params(crv_length, u1, u2, nui[ui]);
                 if (ui != u_lst[i].size() - 2) // pop end for all but last segment
                     params_crv_seg.pop_back();
                 params[i].insert(params[i].end(), params_crv_seg.begin(), params_crv_seg.end());
@@ -591,6 +594,40 @@ namespace gbs
         return std::make_tuple(X_ksi, X_eth, X_ksi_eth, ksi, eth);
     }
 
+    template <typename T>
+    using TFIMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * Function that evaluates TFI blend functions and their derivatives once per mesh line.
+     * 
+     * @param alpha_i: The blend functions and their derivatives, as built by build_tfi_blend_function_with_derivatives.
+     * @param ksi: Function mapping mesh line's index to the blend functions' parameter.
+     * @param n: The number of mesh lines.
+     * @return: A dense n x (L P) table, the row i_ holding alpha_i[i][n](ksi(i_)) at column i * P + n.
+     */
+    template <typename T, size_t P>
+    auto build_tfi_blend_table(const std::vector<std::array<BSCfunction<T>, P>> &alpha_i, const BSCfunction<T> &ksi, size_t n) -> TFIMatrix<T>
+    {
+        auto L = alpha_i.size();
+        TFIMatrix<T> table(n, L * P);
+        auto i_range = make_range<size_t>(0, n - 1);
+        std::for_each(
+            std::execution::par,
+            i_range.begin(), i_range.end(),
+            [&](size_t i_)
+            {
+                auto ksi_i_{ksi(i_)};
+                for (size_t i{}; i < L; i++)
+                {
+                    for (size_t n_{}; n_ < P; n_++)
+                    {
+                        table(i_, i * P + n_) = alpha_i[i][n_](ksi_i_);
+                    }
+                }
+            });
+        return table;
+    }
+
     template <typename T, size_t dim, size_t P, size_t Q, bool slope_ctrl = false>
     auto tfi_mesh_2d(
         const std::vector<std::vector<std::array<point<T,dim> , P>>> &X_ksi, 
@@ -608,51 +645,73 @@ namespace gbs
         auto nj_ = X_ksi.size();
         auto L   = ksi_i.size();
         auto M   = eth_j.size();
-        
-        points_vector<T, dim> pts(ni_ * nj_);
-        auto i_range = make_range<size_t>(0, ni_ - 1);
 
-        std::for_each(
-            std::execution::par,
-            i_range.begin(), i_range.end(),
-            [&](size_t i_)
+        // blends are evaluated once per mesh line, the interpolation is then a set of matrix products
+        auto A = build_tfi_blend_table(alpha_i, ksi, ni_); // ni_ x L.P
+        auto B = build_tfi_blend_table(beta_j, eth, nj_);  // nj_ x M.Q
+
+        // per coordinate, U + V - UV = A (X_ksi^T - X_ksi_eth B^T) + X_eth B^T, W holding the bracket
+        std::array<TFIMatrix<T>, dim> W, X_e;
+        for (size_t d{}; d < dim; d++)
+        {
+            TFIMatrix<T> X_ke(L * P, M * Q);
+            W[d].resize(L * P, nj_);
+            X_e[d].resize(ni_, M * Q);
+            for (size_t j_{}; j_ < nj_; j_++)
             {
-                for (size_t j_{}; j_ < nj_; j_++)
+                for (size_t i{}; i < L; i++)
                 {
-                    point<T, dim> U{}, V{}, UV{};
-                    auto ksi_i_{ksi(i_)};
-                    auto eth_j_{eth(j_)};
-                    for(size_t i{} ; i < L; i++)
+                    for (size_t n{}; n < P; n++)
                     {
-                        for(size_t n{} ; n < P; n++)
-                        {
-                            U += alpha_i[i][n](ksi_i_) * X_ksi[j_][i][n];
-                        }
+                        W[d](i * P + n, j_) = X_ksi[j_][i][n][d];
                     }
-                    for(size_t j{} ; j < M; j++)
+                }
+            }
+            for (size_t i_{}; i_ < ni_; i_++)
+            {
+                for (size_t j{}; j < M; j++)
+                {
+                    for (size_t m{}; m < Q; m++)
                     {
-                        for(size_t m{} ; m < Q; m++)
-                        {
-                            V += beta_j[j][m](eth_j_) * X_eth[i_][j][m];
-                        }
+                        X_e[d](i_, j * Q + m) = X_eth[i_][j][m][d];
                     }
-                    for(size_t i{} ; i < L; i++)
+                }
+            }
+            for (size_t i{}; i < L; i++)
+            {
+                for (size_t j{}; j < M; j++)
+                {
+                    for (size_t n{}; n < P; n++)
                     {
-                        for(size_t j{} ; j < M; j++)
+                        for (size_t m{}; m < Q; m++)
                         {
-                            for(size_t n{} ; n < P; n++)
-                            {
-                                for(size_t m{} ; m < Q; m++)
-                                {
-                                    UV += alpha_i[i][n](ksi_i_) * beta_j[j][m](eth_j_) * X_ksi_eth[i][j][n][m];
-                                }
-                            }
+                            X_ke(i * P + n, j * Q + m) = X_ksi_eth[i][j][n][m][d];
                         }
                     }
-                    pts[j_ + nj_ * i_] = U + V - UV;
                 }
             }
-        );
+            W[d].noalias() -= X_ke * B.transpose();
+        }
+
+        // each mesh line is then a pair of row vector products
+        points_vector<T, dim> pts(ni_ * nj_);
+        auto i_range = make_range<size_t>(0, ni_ - 1);
+        std::for_each(
+            std::execution::par,
+            i_range.begin(), i_range.end(),
+            [&](size_t i_)
+            {
+                Eigen::Matrix<T, 1, Eigen::Dynamic> X(nj_);
+                for (size_t d{}; d < dim; d++)
+                {
+                    X.noalias() = A.row(i_) * W[d];
+                    X.noalias() += X_e[d].row(i_) * B.transpose();
+                    for (size_t j_{}; j_ < nj_; j_++)
+                    {
+                        pts[j_ + nj_ * i_][d] = X(j_);
+                    }
+                }
+            });
         return pts;
     }
 
@@ -0,0 +1,273 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <execution>
+#include <algorithm>
+#include <numeric>
+
+#include <gbs/knotsfunctions.h>
+#include <gbs/bscurve.h>
+#include <gbs/bssurf.h>
+
+namespace gbs
+{
+    namespace detail
+    {
+        // bounds and the knots strictly inside with their multiplicity clamped to [1,p], sorted and unique
+        template <typename T>
+        auto seed_breaks(T u1, T u2, std::vector<std::pair<T, size_t>> knots, size_t p) -> std::vector<std::pair<T, size_t>>
+        {
+            std::vector<std::pair<T, size_t>> breaks{{u1, p + 1}, {u2, p + 1}};
+            for (auto [k, m] : knots)
+                if (k > u1 + knot_eps<T> && k < u2 - knot_eps<T>)
+                    breaks.push_back({k, std::clamp<size_t>(m, 1, p)});
+            std::sort(breaks.begin(), breaks.end());
+            // the highest multiplicity is kept for duplicated knots
+            breaks.erase(breaks.begin(), std::unique(breaks.rbegin(), breaks.rend(), [](const auto &a, const auto &b) { return a.first - b.first < knot_eps<T>; }).base());
+            return breaks;
+        }
+        // flat knots, ends are clamped by the bounds' multiplicity
+        template <typename T>
+        auto breaks_flat_knots(const std::vector<std::pair<T, size_t>> &breaks) -> std::vector<T>
+        {
+            std::vector<T> k;
+            for (auto [u, m] : breaks)
+                k.insert(k.end(), m, u);
+            return k;
+        }
+        // Greville abscissae, interpolation at those parameters satisfies Schoenberg-Whitney conditions
+        template <typename T>
+        auto greville_abscissae(const std::vector<T> &k, size_t p) -> std::vector<T>
+        {
+            std::vector<T> u(k.size() - p - 1);
+            for (size_t i{}; i < u.size(); i++)
+                u[i] = std::reduce(std::next(k.begin(), i + 1), std::next(k.begin(), i + p + 1), T(0)) / p;
+            return u;
+        }
+        // LU factorization of the interpolation matrix, shared by all the right hand sides
+        template <typename T>
+        auto collocation_lu(const std::vector<T> &k, const std::vector<T> &u, size_t p)
+        {
+            MatrixX<T> N(u.size(), u.size());
+            build_poles_matrix<T, 1>(k, u, p, u.size(), N);
+            return N.partialPivLu();
+        }
+        // adds a simple knot in the middle of the spans whose error exceeds tol, returns false if none does
+        template <typename T>
+        auto split_spans(std::vector<std::pair<T, size_t>> &breaks, const std::vector<T> &errors, T tol) -> bool
+        {
+            std::vector<std::pair<T, size_t>> refined{breaks.front()};
+            for (size_t i{}; i < errors.size(); i++)
+            {
+                if (errors[i] > tol)
+                    refined.push_back({T(0.5) * (breaks[i].first + breaks[i + 1].first), 1});
+                refined.push_back(breaks[i + 1]);
+            }
+            auto split = refined.size() > breaks.size();
+            breaks = std::move(refined);
+            return split;
+        }
+    }
+    /**
+     * @brief B-Spline's knots with the multiplicity keeping, in a degree p approximation, their continuity minus lost orders.
+     * An offset loses one order.
+     *
+     * @tparam T
+     * @param k_flat : B-Spline's flat knots
+     * @param deg    : B-Spline's degree
+     * @param p      : approximation's degree
+     * @param lost   : continuity orders lost
+     * @return std::vector<std::pair<T, size_t>> knots and multiplicities
+     */
+    template <typename T>
+    auto continuity_breaks(const std::vector<T> &k_flat, size_t deg, size_t p, size_t lost) -> std::vector<std::pair<T, size_t>>
+    {
+        auto breaks = unflat_knots(k_flat);
+        for (auto &[k, m] : breaks)
+            m = p + m + lost > deg ? p + m + lost - deg : 1;
+        return breaks;
+    }
+    /**
+     * @brief Breaks of approx_adaptive matching the continuity of a B-Spline curve, see continuity_breaks.
+     * Other curves have no breaks.
+     */
+    template <typename T, size_t dim>
+    auto curve_breaks(const Curve<T, dim> &crv, size_t p, size_t lost) -> std::vector<std::pair<T, size_t>>
+    {
+        if (auto bs = dynamic_cast<const BSCurveGeneral<T, dim, false> *>(&crv))
+            return continuity_breaks(bs->knotsFlats(), bs->degree(), p, lost);
+        if (auto bsr = dynamic_cast<const BSCurveGeneral<T, dim, true> *>(&crv))
+            return continuity_breaks(bsr->knotsFlats(), bsr->degree(), p, lost);
+        return {};
+    }
+    /**
+     * @brief Breaks of approx_adaptive in both directions matching the continuity of a B-Spline surface, see continuity_breaks.
+     * Other surfaces have no breaks.
+     */
+    template <typename T, size_t dim>
+    auto surface_breaks(const Surface<T, dim> &srf, size_t p, size_t q, size_t lost) -> std::array<std::vector<std::pair<T, size_t>>, 2>
+    {
+        if (auto bs = dynamic_cast<const BSSurfaceGeneral<T, dim, false> *>(&srf))
+            return {continuity_breaks(bs->knotsFlatsU(), bs->degreeU(), p, lost), continuity_breaks(bs->knotsFlatsV(), bs->degreeV(), q, lost)};
+        if (auto bsr = dynamic_cast<const BSSurfaceGeneral<T, dim, true> *>(&srf))
+            return {continuity_breaks(bsr->knotsFlatsU(), bsr->degreeU(), p, lost), continuity_breaks(bsr->knotsFlatsV(), bsr->degreeV(), q, lost)};
+        return {};
+    }
+    /**
+     * @brief Approximates a curve by a non rational B-Spline within a given tolerance.
+     * The curve is interpolated at the Greville abscissae of the knots, the error is then measured inside every span
+     * in parallel and the spans exceeding the tolerance are split in two by a simple knot, until all of them comply.
+     * The initial breaks should hold the curve's continuity losses, with the multiplicity matching them.
+     * If max_iter is reached the last approximation is returned without meeting the tolerance.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv      : curve to approximate
+     * @param breaks   : initial inner knots and their multiplicity, curve's bounds are added
+     * @param tol      : maximal distance to the curve
+     * @param p        : approximation's degree
+     * @param max_iter : maximal number of refinement passes
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto approx_adaptive(const Curve<T, dim> &crv, const std::vector<std::pair<T, size_t>> &breaks, T tol, size_t p = 3, size_t max_iter = 16) -> BSCurve<T, dim>
+    {
+        if (p == 0)
+            throw std::invalid_argument("approx_adaptive: degree has to be at least 1.");
+        auto [u1, u2] = crv.bounds();
+        auto brk = detail::seed_breaks(u1, u2, breaks, p);
+        auto n_chk = 2 * p; // check points per span
+        for (size_t iter{1};; iter++)
+        {
+            auto k = detail::breaks_flat_knots(brk);
+            auto u = detail::greville_abscissae(k, p);
+            auto n = u.size();
+            std::vector<size_t> ids(n);
+            std::iota(ids.begin(), ids.end(), 0);
+            MatrixX<T> Q(n, dim);
+            std::for_each(std::execution::par, ids.begin(), ids.end(), [&](size_t i)
+            {
+                auto pt = crv.value(u[i]);
+                for (size_t c{}; c < dim; c++)
+                    Q(i, c) = pt[c];
+            });
+            MatrixX<T> X = detail::collocation_lu(k, u, p).solve(Q);
+            points_vector<T, dim> poles(n);
+            for (size_t i{}; i < n; i++)
+                for (size_t c{}; c < dim; c++)
+                    poles[i][c] = X(i, c);
+            BSCurve<T, dim> approx{poles, k, p};
+            if (iter >= max_iter)
+                return approx;
+
+            std::vector<T> errors(brk.size() - 1);
+            ids.resize(errors.size());
+            std::iota(ids.begin(), ids.end(), 0);
+            std::transform(std::execution::par, ids.begin(), ids.end(), errors.begin(), [&](size_t i)
+            {
+                T err{0};
+                for (size_t j{}; j < n_chk; j++)
+                {
+                    auto u_ = brk[i].first + (brk[i + 1].first - brk[i].first) * (j + T(0.5)) / n_chk;
+                    err = std::max(err, distance(crv.value(u_), approx.value(u_)));
+                }
+                return err;
+            });
+            if (!detail::split_spans(brk, errors, tol))
+                return approx;
+        }
+    }
+    /**
+     * @brief Approximates a surface by a non rational B-Spline within a given tolerance.
+     * The surface is interpolated at the Greville abscissae of the knots, the poles being solved direction after
+     * direction with a single factorization per direction. The error is measured inside every
+     * cell in parallel, the rows and columns of the cells exceeding the tolerance are split in two, until all of them comply.
+     * If max_iter is reached the last approximation is returned without meeting the tolerance.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param srf      : surface to approximate
+     * @param breaks_u : initial inner knots in u direction and their multiplicity, surface's bounds are added
+     * @param breaks_v : initial inner knots in v direction and their multiplicity, surface's bounds are added
+     * @param tol      : maximal distance to the surface
+     * @param p        : approximation's degree in u direction
+     * @param q        : approximation's degree in v direction
+     * @param max_iter : maximal number of refinement passes
+     * @return BSSurface<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto approx_adaptive(const Surface<T, dim> &srf, const std::vector<std::pair<T, size_t>> &breaks_u, const std::vector<std::pair<T, size_t>> &breaks_v, T tol, size_t p = 3, size_t q = 3, size_t max_iter = 12) -> BSSurface<T, dim>
+    {
+        if (p == 0 || q == 0)
+            throw std::invalid_argument("approx_adaptive: degrees have to be at least 1.");
+        auto [u1, u2, v1, v2] = srf.bounds();
+        auto brk_u = detail::seed_breaks(u1, u2, breaks_u, p);
+        auto brk_v = detail::seed_breaks(v1, v2, breaks_v, q);
+        auto n_chk_u = p + 1, n_chk_v = q + 1; // check points per cell and direction
+        for (size_t iter{1};; iter++)
+        {
+            auto ku = detail::breaks_flat_knots(brk_u);
+            auto kv = detail::breaks_flat_knots(brk_v);
+            auto u = detail::greville_abscissae(ku, p);
+            auto v = detail::greville_abscissae(kv, q);
+            auto nu = u.size(), nv = v.size();
+            std::vector<size_t> ids(nu * nv);
+            std::iota(ids.begin(), ids.end(), 0);
+            // column j * dim + c holds the coordinate c of the row v[j]
+            MatrixX<T> Q(nu, nv * dim);
+            std::for_each(std::execution::par, ids.begin(), ids.end(), [&](size_t id)
+            {
+                auto i = id % nu, j = id / nu;
+                auto pt = srf.value(u[i], v[j]);
+                for (size_t c{}; c < dim; c++)
+                    Q(i, j * dim + c) = pt[c];
+            });
+            MatrixX<T> R = detail::collocation_lu(ku, u, p).solve(Q);
+            MatrixX<T> Rt(nv, nu * dim);
+            for (size_t i{}; i < nu; i++)
+                for (size_t j{}; j < nv; j++)
+                    for (size_t c{}; c < dim; c++)
+                        Rt(j, i * dim + c) = R(i, j * dim + c);
+            MatrixX<T> X = detail::collocation_lu(kv, v, q).solve(Rt);
+            points_vector<T, dim> poles(nu * nv);
+            for (size_t i{}; i < nu; i++)
+                for (size_t j{}; j < nv; j++)
+                    for (size_t c{}; c < dim; c++)
+                        poles[i + j * nu][c] = X(j, i * dim + c);
+            BSSurface<T, dim> approx{poles, ku, kv, p, q};
+            if (iter >= max_iter)
+                return approx;
+
+            auto n_cu = brk_u.size() - 1, n_cv = brk_v.size() - 1;
+            std::vector<T> errors(n_cu * n_cv);
+            ids.resize(errors.size());
+            std::iota(ids.begin(), ids.end(), 0);
+            std::transform(std::execution::par, ids.begin(), ids.end(), errors.begin(), [&](size_t id)
+            {
+                auto i = id % n_cu, j = id / n_cu;
+                T err{0};
+                for (size_t a{}; a < n_chk_u; a++)
+                {
+                    auto u_ = brk_u[i].first + (brk_u[i + 1].first - brk_u[i].first) * (a + T(0.5)) / n_chk_u;
+                    for (size_t b{}; b < n_chk_v; b++)
+                    {
+                        auto v_ = brk_v[j].first + (brk_v[j + 1].first - brk_v[j].first) * (b + T(0.5)) / n_chk_v;
+                        err = std::max(err, distance(srf.value(u_, v_), approx.value(u_, v_)));
+                    }
+                }
+                return err;
+            });
+            std::vector<T> errors_u(n_cu, T(0)), errors_v(n_cv, T(0));
+            for (size_t i{}; i < n_cu; i++)
+                for (size_t j{}; j < n_cv; j++)
+                {
+                    errors_u[i] = std::max(errors_u[i], errors[i + j * n_cu]);
+                    errors_v[j] = std::max(errors_v[j], errors[i + j * n_cu]);
+                }
+            auto split_u = detail::split_spans(brk_u, errors_u, tol);
+            auto split_v = detail::split_spans(brk_v, errors_v, tol);
+            if (!split_u && !split_v)
+                return approx;
+        }
+    }
+}
@@ -0,0 +1,279 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <execution>
+#include <algorithm>
+#include <numeric>
+#include <boost/math/quadrature/gauss.hpp>
+
+#include <gbs/bscurve.h>
+
+namespace gbs
+{
+    /**
+     * @brief Arc length table of a curve, giving length from parameter and parameter from length in O(log n).
+     * The table is built lazily on first query: each knot span is integrated with Gauss-Legendre quadrature and split
+     * until cubic Hermite interpolation of length and of its inverse between nodes meets the tolerance.
+     * The table is rebuilt when the curve's revision changes, i.e. when its poles, knots or bounds are modified.
+     * The curve is not copied and has to outlive the table.
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam N : Gauss-Legendre points' number per sub-interval
+     */
+    template <typename T, size_t dim, size_t N = 10>
+    class ArcLengthTable
+    {
+        const Curve<T, dim> *m_crv;
+        T m_tol;
+        size_t m_max_depth;
+
+        mutable std::mutex m_build_mutex;
+        mutable std::atomic<size_t> m_revision{0}; // curve's revision the table was built for, 0 if not built
+        mutable std::vector<T> m_u;     // nodes' parameters
+        mutable std::vector<T> m_s;     // nodes' cumulative lengths
+        mutable std::vector<T> m_speed; // nodes' |C'(u)|
+
+        struct Node
+        {
+            T u, l, speed; // l is the length of the interval ending at u
+        };
+
+        auto speed(T u) const -> T { return norm(m_crv->value(u, 1)); }
+
+        auto integrate(T u1, T u2) const -> T
+        {
+            return boost::math::quadrature::gauss<T, N>::integrate([this](T u) { return speed(u); }, u1, u2);
+        }
+        // cubic Hermite on t in [0,1] from end values and end derivatives already scaled by interval's length
+        static auto hermite(T t, T y1, T d1, T y2, T d2) -> T
+        {
+            auto t2 = t * t, t3 = t2 * t;
+            return (2 * t3 - 3 * t2 + 1) * y1 + (t3 - 2 * t2 + t) * d1 + (-2 * t3 + 3 * t2) * y2 + (t3 - t2) * d2;
+        }
+        // du/ds scaled by interval's length, the secant slope is used where speed vanishes
+        static auto inverse_slope(T speed, T l, T h) -> T
+        {
+            return speed * h > std::numeric_limits<T>::epsilon() * l ? l / speed : h;
+        }
+
+        auto refine(T u1, T v1, T u2, T v2, T l, T tol, size_t depth, std::vector<Node> &nodes) const -> void
+        {
+            // quarters' integrals give the quadrature error estimate and the interpolation checks,
+            // the midpoint alone is blind to symmetric speed laws
+            auto h = u2 - u1;
+            std::array<T, 5> u_q{u1, u1 + T(0.25) * h, u1 + T(0.5) * h, u1 + T(0.75) * h, u2};
+            std::array<T, 5> l_q{T(0)};
+            for (size_t i{1}; i < 5; i++)
+                l_q[i] = l_q[i - 1] + integrate(u_q[i - 1], u_q[i]);
+            auto l_ = l_q[4];
+            auto err = std::fabs(l_ - l);
+            for (size_t i : {1, 3})
+            {
+                auto t = T(0.25) * i;
+                err = std::max(err, std::fabs(hermite(t, T(0), v1 * h, l_, v2 * h) - l_q[i]));
+                if (l_ > T(0))
+                    err = std::max(err, std::fabs(hermite(l_q[i] / l_, u1, inverse_slope(v1, l_, h), u2, inverse_slope(v2, l_, h)) - u_q[i]) * speed(u_q[i]));
+            }
+            if (depth == 0 || err <= tol)
+            {
+                nodes.push_back({u2, l_, v2});
+                return;
+            }
+            auto vm = speed(u_q[2]);
+            refine(u1, v1, u_q[2], vm, l_q[2], tol, depth - 1, nodes);
+            refine(u_q[2], vm, u2, v2, l_ - l_q[2], tol, depth - 1, nodes);
+        }
+
+        auto spans() const -> std::vector<T>
+        {
+            auto [u1, u2] = m_crv->bounds();
+            std::vector<T> k;
+            if (auto bs = dynamic_cast<const BSCurveGeneral<T, dim, false> *>(m_crv))
+                k = bs->knots();
+            else if (auto bsr = dynamic_cast<const BSCurveGeneral<T, dim, true> *>(m_crv))
+                k = bsr->knots();
+            std::vector<T> u{u1};
+            for (auto k_ : k)
+                if (k_ > u1 + knot_eps<T> && k_ < u2 - knot_eps<T>)
+                    u.push_back(k_);
+            u.push_back(u2);
+            return u;
+        }
+
+        auto build() const -> void
+        {
+            auto u_spans = spans();
+            auto n_spans = u_spans.size() - 1;
+            std::vector<T> speeds(u_spans.size()), lengths(n_spans);
+            std::transform(std::execution::par, u_spans.begin(), u_spans.end(), speeds.begin(), [this](T u) { return speed(u); });
+            std::vector<size_t> ids(n_spans);
+            std::iota(ids.begin(), ids.end(), 0);
+            std::transform(std::execution::par, ids.begin(), ids.end(), lengths.begin(),
+                           [&](size_t i) { return integrate(u_spans[i], u_spans[i + 1]); });
+            auto tol = m_tol * std::max(std::reduce(lengths.begin(), lengths.end()), std::numeric_limits<T>::min());
+
+            std::vector<std::vector<Node>> span_nodes(n_spans);
+            std::for_each(std::execution::par, ids.begin(), ids.end(),
+                          [&](size_t i)
+                          {
+                              refine(u_spans[i], speeds[i], u_spans[i + 1], speeds[i + 1], lengths[i], tol, m_max_depth, span_nodes[i]);
+                          });
+
+            m_u.assign(1, u_spans.front());
+            m_s.assign(1, T(0));
+            m_speed.assign(1, speeds.front());
+            for (const auto &nodes : span_nodes)
+            {
+                for (const auto &nd : nodes)
+                {
+                    m_u.push_back(nd.u);
+                    m_s.push_back(m_s.back() + nd.l);
+                    m_speed.push_back(nd.speed);
+                }
+            }
+        }
+
+        auto table() const -> void
+        {
+            auto rev = m_crv->revision();
+            if (m_revision.load(std::memory_order_acquire) == rev)
+                return;
+            std::lock_guard<std::mutex> lock{m_build_mutex};
+            if (m_revision.load(std::memory_order_relaxed) == rev)
+                return;
+            build();
+            m_revision.store(rev, std::memory_order_release);
+        }
+
+    public:
+        /**
+         * @brief Attach a table to a curve, nothing is computed before the first query
+         *
+         * @param crv       : the curve
+         * @param tol       : tolerance relative to curve's length
+         * @param max_depth : maximum split depth of a knot span
+         */
+        ArcLengthTable(const Curve<T, dim> &crv, T tol = 1e-8, size_t max_depth = 16) : m_crv{&crv}, m_tol{tol}, m_max_depth{max_depth} {}
+        ArcLengthTable(const ArcLengthTable<T, dim, N> &other) : m_crv{other.m_crv}, m_tol{other.m_tol}, m_max_depth{other.m_max_depth} {}
+        /**
+         * @brief Curve's length between its bounds
+         *
+         * @return T
+         */
+        auto length() const -> T
+        {
+            table();
+            return m_s.back();
+        }
+        /**
+         * @brief Length from curve's start to parameter u
+         *
+         * @param u
+         * @return T
+         */
+        auto length(T u) const -> T
+        {
+            table();
+            u = std::clamp(u, m_u.front(), m_u.back());
+            auto i = std::distance(m_u.begin(), std::upper_bound(std::next(m_u.begin()), std::prev(m_u.end()), u)) - 1;
+            auto h = m_u[i + 1] - m_u[i];
+            return hermite((u - m_u[i]) / h, m_s[i], m_speed[i] * h, m_s[i + 1], m_speed[i + 1] * h);
+        }
+        /**
+         * @brief Length between parameters u1 and u2
+         *
+         * @param u1
+         * @param u2
+         * @return T
+         */
+        auto length(T u1, T u2) const -> T
+        {
+            return length(u2) - length(u1);
+        }
+        /**
+         * @brief Parameter at length s from curve's start
+         *
+         * @param s
+         * @return T
+         */
+        auto parameter(T s) const -> T
+        {
+            table();
+            s = std::clamp(s, m_s.front(), m_s.back());
+            auto i = std::distance(m_s.begin(), std::upper_bound(std::next(m_s.begin()), std::prev(m_s.end()), s)) - 1;
+            auto l = m_s[i + 1] - m_s[i];
+            auto h = m_u[i + 1] - m_u[i];
+            if (l <= T(0))
+                return m_u[i];
+            return hermite((s - m_s[i]) / l, m_u[i], inverse_slope(m_speed[i], l, h), m_u[i + 1], inverse_slope(m_speed[i + 1], l, h));
+        }
+        /**
+         * @brief Batched length queries, run in parallel
+         *
+         * @param u_lst
+         * @return std::vector<T>
+         */
+        auto lengths(const std::vector<T> &u_lst) const -> std::vector<T>
+        {
+            table();
+            std::vector<T> s_lst(u_lst.size());
+            std::transform(std::execution::par, u_lst.begin(), u_lst.end(), s_lst.begin(), [this](T u) { return length(u); });
+            return s_lst;
+        }
+        /**
+         * @brief Batched parameter queries, run in parallel
+         *
+         * @param s_lst
+         * @return std::vector<T>
+         */
+        auto parameters(const std::vector<T> &s_lst) const -> std::vector<T>
+        {
+            table();
+            std::vector<T> u_lst(s_lst.size());
+            std::transform(std::execution::par, s_lst.begin(), s_lst.end(), u_lst.begin(), [this](T s) { return parameter(s); });
+            return u_lst;
+        }
+        /**
+         * @brief Parameters evenly spaced in length between u1 and u2, ends included
+         *
+         * @param u1
+         * @param u2
+         * @param n  : parameters' number
+         * @return std::vector<T>
+         */
+        auto uniformParameters(T u1, T u2, size_t n) const -> std::vector<T>
+        {
+            if (n < 2)
+                throw std::invalid_argument("ArcLengthTable: at least 2 parameters are required.");
+            auto s = make_range(length(u1), length(u2), n);
+            auto u = parameters(s);
+            u.front() = u1;
+            u.back() = u2;
+            return u;
+        }
+        /**
+         * @brief Number of nodes, built if needed
+         *
+         * @return size_t
+         */
+        auto size() const -> size_t
+        {
+            table();
+            return m_u.size();
+        }
+        /**
+         * @brief The curve the table is attached to
+         *
+         * @return const Curve<T, dim>&
+         */
+        auto curve() const -> const Curve<T, dim> & { return *m_crv; }
+        /**
+         * @brief Tolerance relative to curve's length
+         *
+         * @return T
+         */
+        auto tolerance() const -> T { return m_tol; }
+    };
+}
@@ -119,6 +119,56 @@ namespace gbs
         }
     }
 
+    /**
+     * @brief Non vanishing basis functions and their first derivatives at u in a single pass, i being u's span index in the flat knots
+     * 
+     * @tparam T 
+     * @param i  : span index, k[i] <= u < k[i+1]
+     * @param p  : degree
+     * @param u  : parameter
+     * @param k  : flat knots
+     * @param N  : basis functions N_{i-p} to N_{i}, resized to p+1
+     * @param dN : first derivatives of N, resized to p+1
+     */
+    template <typename T>
+    auto basis_funcs_d1(size_t i, size_t p, T u, const std::vector<T> &k, std::vector<T> &N, std::vector<T> &dN) -> void
+    {
+        N.resize(p + 1);
+        dN.assign(p + 1, T(0));
+        if (p == 0)
+        {
+            N[0] = T(1);
+            return;
+        }
+        // the triangular table's degree p-1 row gives the derivatives, its last step gives degree p functions
+        std::vector<T> left(p + 1), right(p + 1);
+        N[0] = T(1);
+        for (size_t j{1}; j <= p; j++)
+        {
+            if (j == p)
+            {
+                for (size_t r{}; r <= p; r++)
+                {
+                    auto l = i - p + r;
+                    if (r > 0 && k[l + p] > k[l])
+                        dN[r] += p * N[r - 1] / (k[l + p] - k[l]);
+                    if (r < p && k[l + p + 1] > k[l + 1])
+                        dN[r] -= p * N[r] / (k[l + p + 1] - k[l + 1]);
+                }
+            }
+            left[j] = u - k[i + 1 - j];
+            right[j] = k[i + j] - u;
+            T saved{};
+            for (size_t r{}; r < j; r++)
+            {
+                auto temp = N[r] / (right[r + 1] + left[j - r]);
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            N[j] = saved;
+        }
+    }
+
     template <typename T>
     auto find_span(size_t n, size_t p, T u, const std::vector<T> &k)
     {
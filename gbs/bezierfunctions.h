@@ -0,0 +1,234 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <gbs/gbslib.h>
+
+namespace gbs
+{
+    /**
+     * @brief Binomial coefficients row (n choose k) for k in [0,n], computed by Pascal's rule in T to avoid factorial overflow
+     *
+     * @tparam T
+     * @param n
+     * @return std::vector<T>
+     */
+    template <typename T>
+    auto binomial_row(size_t n) -> std::vector<T>
+    {
+        std::vector<T> row(n + 1, T(1));
+        for (size_t i{1}; i < n; i++)
+            for (size_t k{i}; k > 0; k--)
+                row[k] += row[k - 1];
+        return row;
+    }
+    /**
+     * @brief Evaluates a scalar polynomial given by its Bernstein coefficients on [0,1] using de Casteljau's algorithm
+     *
+     * @tparam T
+     * @param b : Bernstein coefficients
+     * @param t : parameter in [0,1]
+     * @return T
+     */
+    template <typename T>
+    auto bezier_value(std::vector<T> b, T t) -> T
+    {
+        for (auto n = b.size(); n > 1; n--)
+            for (size_t i{}; i < n - 1; i++)
+                b[i] = (1 - t) * b[i] + t * b[i + 1];
+        return b.front();
+    }
+    /**
+     * @brief Splits a scalar Bernstein polynomial at t, both halves are reparametrized on [0,1]
+     *
+     * @tparam T
+     * @param b : Bernstein coefficients
+     * @param t : split parameter in [0,1]
+     * @return std::pair<std::vector<T>, std::vector<T>> (left part, right part)
+     */
+    template <typename T>
+    auto bezier_split(std::vector<T> b, T t) -> std::pair<std::vector<T>, std::vector<T>>
+    {
+        auto n = b.size();
+        std::vector<T> left(n), right(n);
+        for (size_t k{}; k < n; k++)
+        {
+            left[k] = b.front();
+            right[n - 1 - k] = b[n - 1 - k];
+            for (size_t i{}; i < n - 1 - k; i++)
+                b[i] = (1 - t) * b[i] + t * b[i + 1];
+        }
+        return {left, right};
+    }
+    /**
+     * @brief Derivative of a scalar Bernstein polynomial, degree is decreased by one. A constant gives the null constant.
+     *
+     * @tparam T
+     * @param b : Bernstein coefficients
+     * @return std::vector<T>
+     */
+    template <typename T>
+    auto bezier_derivate(const std::vector<T> &b) -> std::vector<T>
+    {
+        if (b.size() < 2)
+            return {T(0)};
+        auto p = b.size() - 1;
+        std::vector<T> d(p);
+        for (size_t i{}; i < p; i++)
+            d[i] = p * (b[i + 1] - b[i]);
+        return d;
+    }
+    /**
+     * @brief Exact product of two scalar Bernstein polynomials, the result's degree is the sum of the degrees
+     *
+     * @tparam T
+     * @param f : Bernstein coefficients of degree m
+     * @param g : Bernstein coefficients of degree n
+     * @return std::vector<T> Bernstein coefficients of degree m+n
+     */
+    template <typename T>
+    auto bezier_product(const std::vector<T> &f, const std::vector<T> &g) -> std::vector<T>
+    {
+        auto m = f.size() - 1;
+        auto n = g.size() - 1;
+        auto Cm = binomial_row<T>(m);
+        auto Cn = binomial_row<T>(n);
+        auto Cmn = binomial_row<T>(m + n);
+        std::vector<T> h(m + n + 1, T(0));
+        for (size_t i{}; i <= m; i++)
+            for (size_t j{}; j <= n; j++)
+                h[i + j] += Cm[i] * Cn[j] * f[i] * g[j];
+        for (size_t k{}; k <= m + n; k++)
+            h[k] /= Cmn[k];
+        return h;
+    }
+    /**
+     * @brief Elevates the degree of a scalar Bernstein polynomial by t
+     *
+     * @tparam T
+     * @param b : Bernstein coefficients
+     * @param t : degree increment
+     * @return std::vector<T>
+     */
+    template <typename T>
+    auto bezier_elevate(const std::vector<T> &b, size_t t) -> std::vector<T>
+    {
+        if (t == 0)
+            return b;
+        return bezier_product(b, std::vector<T>(t + 1, T(1)));
+    }
+    /**
+     * @brief Linear combination a*f + b*g of scalar Bernstein polynomials, the lowest degree one is elevated
+     *
+     * @tparam T
+     * @param f
+     * @param g
+     * @param a
+     * @param b
+     * @return std::vector<T>
+     */
+    template <typename T>
+    auto bezier_combine(const std::vector<T> &f, const std::vector<T> &g, T a = T(1), T b = T(1)) -> std::vector<T>
+    {
+        auto n = std::max(f.size(), g.size());
+        auto f_ = bezier_elevate(f, n - f.size());
+        auto g_ = bezier_elevate(g, n - g.size());
+        std::vector<T> h(n);
+        for (size_t i{}; i < n; i++)
+            h[i] = a * f_[i] + b * g_[i];
+        return h;
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        auto bezier_sign_changes(const std::vector<T> &b, T eps) -> size_t
+        {
+            size_t count{};
+            int prev{};
+            for (auto c : b)
+            {
+                int s = c > eps ? 1 : (c < -eps ? -1 : 0);
+                if (s == 0)
+                    continue;
+                if (prev != 0 && s != prev)
+                    count++;
+                prev = s;
+            }
+            return count;
+        }
+
+        template <typename T>
+        auto bezier_roots_rec(const std::vector<T> &b, T t1, T t2, T tol, T eps, size_t depth, std::vector<T> &roots) -> void
+        {
+            auto changes = bezier_sign_changes(b, eps);
+            if (changes == 0)
+            {
+                if (std::fabs(b.front()) <= eps && t1 == T(0))
+                    roots.push_back(t1);
+                if (std::fabs(b.back()) <= eps)
+                    roots.push_back(t2);
+                return;
+            }
+            if (t2 - t1 < tol || depth == 0)
+            {
+                // sign changes in the coefficients don't guarantee a root, it has to be bracketed or evaluated
+                if (b.front() * b.back() < T(0) || std::fabs(bezier_value(b, T(0.5))) <= eps)
+                    roots.push_back(T(0.5) * (t1 + t2));
+                return;
+            }
+            if (changes == 1 && b.front() * b.back() < T(0))
+            {
+                // single root, bracketed: bisection on local parameter
+                T a{0}, c{1}, fa{b.front()};
+                auto tol_loc = tol / (t2 - t1);
+                while (c - a > tol_loc)
+                {
+                    auto m = T(0.5) * (a + c);
+                    auto fm = bezier_value(b, m);
+                    if ((fa < T(0)) == (fm < T(0)))
+                    {
+                        a = m;
+                        fa = fm;
+                    }
+                    else
+                        c = m;
+                }
+                roots.push_back(t1 + T(0.5) * (a + c) * (t2 - t1));
+                return;
+            }
+            auto [left, right] = bezier_split(b, T(0.5));
+            auto tm = T(0.5) * (t1 + t2);
+            bezier_roots_rec(left, t1, tm, tol, eps, depth - 1, roots);
+            bezier_roots_rec(right, tm, t2, tol, eps, depth - 1, roots);
+        }
+    }
+    /**
+     * @brief Isolates all the roots in [0,1] of a scalar Bernstein polynomial by recursive subdivision.
+     * Sub-intervals without sign change in the coefficients are discarded (variation diminishing property),
+     * those with a single bracketed root are solved by bisection. Roots closer than tol are merged.
+     * An empty or identically null polynomial returns no root.
+     *
+     * @tparam T
+     * @param b         : Bernstein coefficients
+     * @param tol       : parameter tolerance
+     * @param max_depth : maximum subdivision depth
+     * @return std::vector<T> sorted roots
+     */
+    template <typename T>
+    auto bezier_roots(const std::vector<T> &b, T tol, size_t max_depth = 64) -> std::vector<T>
+    {
+        std::vector<T> roots;
+        if (b.empty())
+            return roots;
+        auto b_max = std::fabs(*std::max_element(b.begin(), b.end(), [](T a, T c) { return std::fabs(a) < std::fabs(c); }));
+        if (b_max == T(0))
+            return roots;
+        auto eps = b_max * T(100) * std::numeric_limits<T>::epsilon();
+        detail::bezier_roots_rec(b, T(0), T(1), tol, eps, max_depth, roots);
+        std::sort(roots.begin(), roots.end());
+        roots.erase(std::unique(roots.begin(), roots.end(), [tol](T a, T c) { return c - a < tol; }), roots.end());
+        return roots;
+    }
+}
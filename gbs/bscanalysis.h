@@ -8,6 +8,8 @@
 #include "bscurve.h"
 #include "bscinterp.h"
 #include "bscapprox.h"
+#include "bezierfunctions.h"
+#include "arclength.h"
 
 // GSL_INTEG_GAUSS15
 
@@ -382,34 +384,194 @@ namespace gbs
         return uniform_distrib_params(crv,u1,u2,n,n_law);
     }
 /**
- * @brief Refines the range of curve parameters recursively based on the deviation.
+ * @brief Generate a list of uniformly distributed parameters along the curve using its cached arc length table
  * 
- * @tparam T Floating-point type
+ * @tparam T Numeric type
  * @tparam dim Dimension of the curve
- * @param crv The curve to discretize
- * @param dev_max The maximum allowed deviation
- * @param it_u1 Iterator pointing to the start of the range in the parameter list
- * @param it_u3 Iterator pointing to the end of the range in the parameter list
- * @param u_lst The list of curve parameters
+ * @tparam N Number of Gauss quadrature points of the table
+ * @param table The curve's arc length table, built on first use and reused afterwards
+ * @param u1 Starting parameter value
+ * @param u2 Ending parameter value
+ * @param n Number of parameters to generate
+ * @return std::list<T> A list of uniformly distributed parameters along the curve
+ */
+    template <typename T, size_t dim, size_t N>
+    auto uniform_distrib_params(const ArcLengthTable<T, dim, N> &table, T u1, T u2, size_t n) -> std::list<T>
+    {
+        auto u = table.uniformParameters(u1, u2, n);
+        return std::list<T>(u.begin(), u.end());
+    }
+/**
+ * @brief Curve sample used by tessellation
+ * 
+ * @tparam T 
+ * @tparam dim 
+ */
+    template <typename T, size_t dim>
+    struct CurveSample
+    {
+        T u;
+        point<T, dim> pt;
+        point<T, dim> tg; // first derivative, null if not requested
+    };
+/**
+ * @brief Curve tessellation criteria, a criterion is disabled if its value is infinite
+ * 
+ * @tparam T 
+ */
+    template <typename T>
+    struct CurveTessellationCriteria
+    {
+        T chord_height{1e-3};                              // max distance from interval's mid point to chord
+        T max_angle{std::numeric_limits<T>::infinity()};   // max angle, in radians, between tangents of interval's ends
+        T max_length{std::numeric_limits<T>::infinity()};  // max chord length
+        size_t max_depth{24};                              // max split depth per seed interval
+    };
+/**
+ * @brief Seed parameters of curve tessellation: n evenly spaced parameters between u1 and u2 plus the inner knots of B-Spline curves
+ * 
+ * @tparam T 
+ * @tparam dim 
+ * @param crv 
+ * @param u1 
+ * @param u2 
+ * @param n 
+ * @return std::vector<T> sorted parameters
  */
     template <typename T, size_t dim>
-    void refine_params_recursive(const Curve<T, dim> &crv, T dev_max, typename std::list<T>::iterator it_u1, typename std::list<T>::iterator it_u3, std::list<T> &u_lst)
+    auto tessellation_seeds(const Curve<T, dim> &crv, T u1, T u2, size_t n) -> std::vector<T>
     {
-        auto u_ = 0.5 * (*it_u1 + *it_u3);
-        auto v1 = crv(u_) - crv(*it_u1);
-        auto v2 = crv(*it_u3) - crv(*it_u1);
-        auto dev_ = norm(cross(v1, v2)) / (norm(v1) * norm(v2));
+        n = std::max<size_t>(n, 2);
+        auto u_lst = make_range(u1, u2, n);
+        std::vector<T> knots;
+        if (auto bsc = dynamic_cast<const BSCurve<T, dim> *>(&crv))
+            knots = bsc->knots();
+        else if (auto bscr = dynamic_cast<const BSCurveRational<T, dim> *>(&crv))
+            knots = bscr->knots();
+        std::copy_if(knots.begin(), knots.end(), std::back_inserter(u_lst), [u1, u2](T u) { return u > u1 && u < u2; });
+        std::sort(u_lst.begin(), u_lst.end());
+        u_lst.erase(std::unique(u_lst.begin(), u_lst.end(), [](T a, T b) { return b - a <= knot_eps<T>; }), u_lst.end());
+        u_lst.back() = u2;
+        return u_lst;
+    }
+/**
+ * @brief Adaptive refinement of curve samples. Seed intervals are refined independently in parallel, an interval is split at its
+ * mid parameter while split(start, mid, end) returns true. Ends' evaluations are shared between neighbouring intervals.
+ * 
+ * @tparam T 
+ * @tparam dim 
+ * @tparam F 
+ * @param crv 
+ * @param u_seeds   : sorted seed parameters
+ * @param split     : predicate (const CurveSample &start, const CurveSample &mid, const CurveSample &end) -> bool
+ * @param tangents  : evaluate first derivatives
+ * @param max_depth : max split depth per seed interval
+ * @return std::vector<CurveSample<T, dim>> sorted samples
+ */
+    template <typename T, size_t dim, typename F>
+    auto refine_samples(const Curve<T, dim> &crv, const std::vector<T> &u_seeds, const F &split, bool tangents, size_t max_depth) -> std::vector<CurveSample<T, dim>>
+    {
+        using Sample = CurveSample<T, dim>;
+        auto sample = [&crv, tangents](T u) { return Sample{u, crv(u), tangents ? crv(u, 1) : point<T, dim>{}}; };
+        std::vector<Sample> seeds(u_seeds.size());
+        std::transform(std::execution::par, u_seeds.begin(), u_seeds.end(), seeds.begin(), sample);
+        if (seeds.size() < 2)
+            return seeds;
 
-        if ((dev_ > dev_max) && (std::abs(*it_u3-*it_u1) > knot_eps<T>))
+        std::vector<std::vector<Sample>> refined(seeds.size() - 1);
+        std::vector<size_t> ids(refined.size());
+        std::iota(ids.begin(), ids.end(), 0);
+        std::for_each(
+            std::execution::par,
+            ids.begin(), ids.end(),
+            [&](size_t i)
+            {
+                // depth first, left interval on top so that samples are produced in order
+                std::vector<std::tuple<Sample, Sample, size_t>> stack{{seeds[i], seeds[i + 1], 0}};
+                while (!stack.empty())
+                {
+                    auto [s1, s2, depth] = stack.back();
+                    stack.pop_back();
+                    if (depth < max_depth && s2.u - s1.u > knot_eps<T>)
+                    {
+                        auto sm = sample(T(0.5) * (s1.u + s2.u));
+                        if (split(s1, sm, s2))
+                        {
+                            stack.push_back({sm, s2, depth + 1});
+                            stack.push_back({s1, sm, depth + 1});
+                            continue;
+                        }
+                    }
+                    refined[i].push_back(s2);
+                }
+            });
+
+        std::vector<Sample> samples{seeds.front()};
+        samples.reserve(std::transform_reduce(refined.begin(), refined.end(), size_t(1), std::plus<>{}, [](const auto &r) { return r.size(); }));
+        for (const auto &r : refined)
+            samples.insert(samples.end(), r.begin(), r.end());
+        return samples;
+    }
+/**
+ * @brief Adaptive curve tessellation with chord height, angle and length criteria. Seeds are n evenly spaced parameters plus
+ * B-Spline's knots, each seed interval is refined in parallel.
+ * 
+ * @tparam T 
+ * @tparam dim 
+ * @param crv 
+ * @param u1       : start parameter
+ * @param u2       : end parameter
+ * @param criteria : refinement criteria
+ * @param n        : seed parameters' number
+ * @param tangents : store first derivatives in samples, always evaluated if angle criterion is active
+ * @return std::vector<CurveSample<T, dim>> sorted samples
+ */
+    template <typename T, size_t dim>
+    auto tessellate(const Curve<T, dim> &crv, T u1, T u2, const CurveTessellationCriteria<T> &criteria, size_t n = 2, bool tangents = false) -> std::vector<CurveSample<T, dim>>
+    {
+        using Sample = CurveSample<T, dim>;
+        auto angle = [](const point<T, dim> &a, const point<T, dim> &b)
         {
-            auto it_u2 = u_lst.insert(it_u3, u_);
-            refine_params_recursive(crv, dev_max, it_u1, it_u2, u_lst);
-            refine_params_recursive(crv, dev_max, it_u2, it_u3, u_lst);
-        }
+            auto n_ab = norm(a) * norm(b);
+            return n_ab > T(0) ? std::acos(std::clamp((a * b) / n_ab, T(-1), T(1))) : T(0);
+        };
+        auto split = [&criteria, &angle](const Sample &s1, const Sample &sm, const Sample &s2)
+        {
+            auto chord = s2.pt - s1.pt;
+            auto l2 = sq_norm(chord);
+            if (l2 > criteria.max_length * criteria.max_length)
+                return true;
+            auto v = sm.pt - s1.pt;
+            auto h = l2 > T(0) ? norm(v - ((v * chord) / l2) * chord) : norm(v);
+            if (h > criteria.chord_height)
+                return true;
+            return std::isfinite(criteria.max_angle) &&
+                   std::max(angle(s1.tg, sm.tg), angle(sm.tg, s2.tg)) > T(0.5) * criteria.max_angle;
+        };
+        auto with_tangents = tangents || std::isfinite(criteria.max_angle);
+        return refine_samples(crv, tessellation_seeds(crv, u1, u2, n), split, with_tangents, criteria.max_depth);
+    }
+/**
+ * @brief Adaptive tessellation of the whole curve, see tessellate(crv, u1, u2, criteria, n, tangents)
+ * 
+ * @tparam T 
+ * @tparam dim 
+ * @param crv 
+ * @param criteria 
+ * @param n 
+ * @param tangents 
+ * @return std::vector<CurveSample<T, dim>> 
+ */
+    template <typename T, size_t dim>
+    auto tessellate(const Curve<T, dim> &crv, const CurveTessellationCriteria<T> &criteria, size_t n = 2, bool tangents = false) -> std::vector<CurveSample<T, dim>>
+    {
+        auto [u1, u2] = crv.bounds();
+        return tessellate(crv, u1, u2, criteria, n, tangents);
     }
 
 /**
- * @brief Generates a list of curve parameters based on deviation using a recursive approach.
+ * @brief Generates a list of curve parameters based on deviation, i.e. the sine of the angle between the interval's chord and
+ * the chord from its start to its mid point. Intervals are refined with refine_samples.
  * 
  * @tparam T Floating-point type
  * @tparam dim Dimension of the curve
@@ -418,52 +580,22 @@ namespace gbs
  * @param u2 End value of the parameter range
  * @param n Initial number of points to create
  * @param dev_max The maximum allowed deviation
- * @param n_max_pts Maximum number of points allowed
+ * @param n_max_pts Maximum number of seed points allowing refinement
  * @return A list of curve parameters with the refined deviation
  */
     template <typename T, size_t dim>
     auto deviation_based_params(const Curve<T, dim> &crv, T u1, T u2, size_t n, T dev_max, size_t n_max_pts = 5000) -> std::list<T>
     {
-
-        // Create initial list of parameters
-        std::list<T> u_lst;
-        for (size_t i{}; i < n; i++)
-            u_lst.push_back(u1 + (u2 - u1) * i / (n - 1.0));
-
-        // Try to cast to a B-spline curve
-        auto *bsc = dynamic_cast<const BSCurve<T, dim>*>(&crv);
-        auto *bscr= dynamic_cast<const BSCurveRational<T, dim>*>(&crv);
-        // Add potentially hard points to the list
-        std::vector<T> knots;
-
-        if(bsc  != nullptr) knots = bsc->knots();
-        if(bscr != nullptr) knots = bscr->knots();
-
-        for (auto u : knots) // Non flat knots
-        {
-            if( u > u1 && u < u2)
-            {
-                u_lst.push_back(u);
-            }
-        }
-
-
-        // Sort the list
-        u_lst.sort();
-
-        // Refine the list recursively if the maximum number of points is not reached
-        if (u_lst.size() < n_max_pts)
+        auto u_seeds = tessellation_seeds(crv, u1, u2, n);
+        auto split = [dev_max](const auto &s1, const auto &sm, const auto &s2)
         {
-            auto it_u1 = u_lst.begin();
-            auto it_u3 = std::next(it_u1);
-            while (it_u3 != u_lst.end())
-            {
-                refine_params_recursive(crv, dev_max, it_u1, it_u3, u_lst);
-
-                it_u1 = it_u3;
-                it_u3 = std::next(it_u1);
-            }
-        }
+            auto v1 = sm.pt - s1.pt;
+            auto v2 = s2.pt - s1.pt;
+            return norm(cross(v1, v2)) / (norm(v1) * norm(v2)) > dev_max;
+        };
+        auto samples = refine_samples(crv, u_seeds, split, false, u_seeds.size() < n_max_pts ? 64 : 0);
+        std::list<T> u_lst;
+        std::transform(samples.begin(), samples.end(), std::back_inserter(u_lst), [](const auto &s) { return s.u; });
         return u_lst;
     }
 
@@ -715,6 +847,156 @@ namespace gbs
         return max_curvature_pos(crv, u1, u2, tol_x, solver);
 
     }
+/**
+ * @brief Curve's curvature at given parameter, signed for planar curves (positive when turning left)
+ *
+ * @tparam T
+ * @tparam dim
+ * @param crv
+ * @param u
+ * @return T
+ */
+    template <typename T, size_t dim>
+    auto curvature(const Curve<T,dim> &crv, T u) -> T
+    {
+        static_assert(dim == 2 || dim == 3, "curvature is only defined for 2d and 3d curves");
+        auto d1 = crv(u, 1);
+        auto d2 = crv(u, 2);
+        auto n1 = norm(d1);
+        if constexpr (dim == 2)
+            return (d1[0] * d2[1] - d1[1] * d2[0]) / (n1 * n1 * n1);
+        else
+            return norm(d1 ^ d2) / (n1 * n1 * n1);
+    }
+/**
+ * @brief Bernstein coefficients, on the span's local parameter, of the polynomials whose roots are the curvature's extrema
+ * and, for planar curves, the inflections. With W = C'^C'', S = C'.C' and D = C'.C'':
+ *  - extrema: W' S - 3 W D of degree 4p-6 in 2d (W is scalar), (W.W') S - 3 (W.W) D of degree 6p-9 in 3d
+ *  - inflections: W, of degree 2p-3 (2d only, left empty in 3d)
+ * The scaling from local to global parameter is the same for all terms, hence doesn't move the roots.
+ *
+ * @tparam T
+ * @tparam dim
+ * @param poles : Bezier span's poles
+ * @return std::array<std::vector<T>,2> (extrema numerator, inflections numerator)
+ */
+    template <typename T, size_t dim>
+    auto curvature_span_numerators(const std::vector<std::array<T,dim>> &poles) -> std::array<std::vector<T>,2>
+    {
+        static_assert(dim == 2 || dim == 3, "curvature is only defined for 2d and 3d curves");
+        std::array<std::array<std::vector<T>, dim>, 3> d; // 1st to 3rd derivatives' components
+        for (size_t k{}; k < dim; k++)
+        {
+            std::vector<T> c(poles.size());
+            std::transform(poles.begin(), poles.end(), c.begin(), [k](const auto &p_) { return p_[k]; });
+            d[0][k] = bezier_derivate(c);
+            d[1][k] = bezier_derivate(d[0][k]);
+            d[2][k] = bezier_derivate(d[1][k]);
+        }
+        auto dot = [](const auto &a, const auto &b)
+        {
+            auto r = bezier_product(a[0], b[0]);
+            for (size_t k{1}; k < a.size(); k++)
+                r = bezier_combine(r, bezier_product(a[k], b[k]));
+            return r;
+        };
+        auto cross = [](const auto &a, const auto &b)
+        {
+            if constexpr (dim == 2)
+            {
+                return std::array<std::vector<T>, 1>{
+                    bezier_combine(bezier_product(a[0], b[1]), bezier_product(a[1], b[0]), T(1), T(-1))};
+            }
+            else
+            {
+                std::array<std::vector<T>, 3> r;
+                for (size_t k{}; k < 3; k++)
+                    r[k] = bezier_combine(bezier_product(a[(k + 1) % 3], b[(k + 2) % 3]), bezier_product(a[(k + 2) % 3], b[(k + 1) % 3]), T(1), T(-1));
+                return r;
+            }
+        };
+        auto W  = cross(d[0], d[1]);
+        auto Wd = cross(d[0], d[2]); // W' = C'^C'''
+        auto S  = dot(d[0], d[0]);
+        auto D  = dot(d[0], d[1]);
+        if constexpr (dim == 2) // signed curvature W / S^(3/2)
+            return {bezier_combine(bezier_product(Wd[0], S), bezier_product(W[0], D), T(1), T(-3)), W[0]};
+        else // squared curvature W.W / S^3
+            return {bezier_combine(bezier_product(dot(W, Wd), S), bezier_product(dot(W, W), D), T(1), T(-3)), {}};
+    }
+/**
+ * @brief Finds all the curvature's extrema and, for planar curves, inflections of a polynomial B-Spline curve.
+ * Roots of the curvature numerators are isolated by Bernstein subdivision independently on each Bezier span, spans are processed in parallel.
+ * Curvature discontinuities at knots and curve's ends are not reported. Straight parts and arcs of constant curvature have no isolated root and are skipped.
+ *
+ * @tparam T
+ * @tparam dim
+ * @param crv
+ * @param tol_x : parameter tolerance
+ * @return std::pair<std::vector<std::array<T,2>>, std::vector<T>> (sorted extrema {u, curvature}, sorted inflections' parameters)
+ */
+    template <typename T, size_t dim>
+    auto curvature_critical_points(const BSCurve<T,dim> &crv, T tol_x = 1e-8) -> std::pair<std::vector<std::array<T,2>>, std::vector<T>>
+    {
+        std::pair<std::vector<std::array<T,2>>, std::vector<T>> res;
+        if (crv.degree() < 2)
+            return res;
+        auto segments = bezier_segments(crv.knotsFlats(), crv.poles(), crv.degree());
+        std::vector<std::array<std::vector<T>, 2>> seg_roots(segments.size());
+        std::transform(
+            std::execution::par,
+            segments.begin(), segments.end(),
+            seg_roots.begin(),
+            [tol_x](const auto &seg)
+            {
+                auto [u1, u2] = seg.second;
+                auto tol_loc = tol_x / (u2 - u1);
+                auto [extrema, inflections] = curvature_span_numerators(seg.first);
+                std::array<std::vector<T>, 2> roots{bezier_roots(extrema, tol_loc), bezier_roots(inflections, tol_loc)};
+                for (auto &r : roots)
+                    std::transform(r.begin(), r.end(), r.begin(), [u1, u2](T t) { return u1 + t * (u2 - u1); });
+                return roots;
+            });
+        auto [u_start, u_end] = crv.bounds();
+        auto is_inner = [u_start, u_end, tol_x](T u) { return u - u_start > tol_x && u_end - u > tol_x; };
+        for (const auto &roots : seg_roots)
+        {
+            for (auto u : roots[0])
+                if (is_inner(u) && (res.first.empty() || u - res.first.back()[0] > tol_x))
+                    res.first.push_back({u, curvature(crv, u)});
+            for (auto u : roots[1])
+                if (is_inner(u) && (res.second.empty() || u - res.second.back() > tol_x))
+                    res.second.push_back(u);
+        }
+        return res;
+    }
+/**
+ * @brief Finds all the curvature's extrema of a polynomial B-Spline curve, see curvature_critical_points
+ *
+ * @tparam T
+ * @tparam dim
+ * @param crv
+ * @param tol_x : parameter tolerance
+ * @return std::vector<std::array<T,2>> sorted extrema {u, curvature}
+ */
+    template <typename T, size_t dim>
+    auto curvature_extrema(const BSCurve<T,dim> &crv, T tol_x = 1e-8) -> std::vector<std::array<T,2>>
+    {
+        return curvature_critical_points(crv, tol_x).first;
+    }
+/**
+ * @brief Finds all the inflections of a planar polynomial B-Spline curve, see curvature_critical_points
+ *
+ * @tparam T
+ * @param crv
+ * @param tol_x : parameter tolerance
+ * @return std::vector<T> sorted inflections' parameters
+ */
+    template <typename T>
+    auto inflection_points(const BSCurve<T,2> &crv, T tol_x = 1e-8) -> std::vector<T>
+    {
+        return curvature_critical_points(crv, tol_x).second;
+    }
 
     template <typename T>
     auto compute_rolling_ball(const Curve<T, 2> &crv1, const Curve<T, 2> &crv2, T u1)
@@ -770,4 +1052,126 @@ namespace gbs
         );
     }
 
+/**
+ * @brief Rolling ball contact between two planar curves
+ * 
+ * @tparam T 
+ */
+    template <typename T>
+    struct RollingBall
+    {
+        T u1;              // contact parameter on curve 1
+        T u2;              // contact parameter on curve 2
+        point<T, 2> center;
+        T radius;
+        bool parallel;     // curves are parallel at contact, the center is the contact points' middle
+    };
+/**
+ * @brief Compute the rolling ball contact between two 2D curves crv1 and crv2 given a parameter value u1, the contact on crv2 
+ * is solved by secant iterations started from u2_0. If the iterations fail, the global solve of compute_rolling_ball is used.
+ * 
+ * @tparam T 
+ * @param crv1 
+ * @param crv2 
+ * @param u1    : parameter on crv1
+ * @param u2_0  : initial guess on crv2, typically neighbour's solution
+ * @param tol_x : parameter tolerance
+ * @param it_max : maximum secant iterations number
+ * @return RollingBall<T> 
+ */
+    template <typename T>
+    auto rolling_ball(const Curve<T, 2> &crv1, const Curve<T, 2> &crv2, T u1, T u2_0, T tol_x = 1e-6, size_t it_max = 30) -> RollingBall<T>
+    {
+        auto p1 = crv1(u1);
+        auto n1 = normal_direction(crv1, u1);
+        // signed distances s, t to the normals' intersection and the equidistance residual s^2 - t^2
+        auto contact = [&](T u2)
+        {
+            auto p2 = crv2(u2);
+            auto n2 = normal_direction(crv2, u2);
+            auto d = p2 - p1;
+            auto det = n2[0] * n1[1] - n1[0] * n2[1];
+            auto s = (n2[0] * d[1] - n2[1] * d[0]) / det;
+            auto t = (n1[0] * d[1] - n1[1] * d[0]) / det;
+            return std::make_tuple(s * s - t * t, s);
+        };
+
+        auto [u2_min, u2_max] = crv2.bounds();
+        auto clamp = [u2_min, u2_max](T u) { return std::clamp(u, u2_min, u2_max); };
+        auto x0 = clamp(u2_0);
+        auto x1 = clamp(x0 + T(1e-3) * (u2_max - u2_min));
+        if (x1 == x0)
+            x1 = x0 - T(1e-3) * (u2_max - u2_min);
+        auto [g0, s0] = contact(x0);
+        auto [g1, s1] = contact(x1);
+        for (size_t it{}; it < it_max && std::isfinite(g0) && std::isfinite(g1) && g1 != g0; it++)
+        {
+            auto x2 = clamp(x1 - g1 * (x1 - x0) / (g1 - g0));
+            x0 = x1; g0 = g1;
+            x1 = x2;
+            std::tie(g1, s1) = contact(x1);
+            if (std::fabs(x1 - x0) < tol_x && std::isfinite(g1) && x1 > u2_min && x1 < u2_max)
+                return RollingBall<T>{u1, x1, p1 + s1 * n1, std::fabs(s1), false};
+        }
+
+        auto [u2, center, parallel] = compute_rolling_ball(crv1, crv2, u1);
+        return RollingBall<T>{u1, u2, center, distance(center, p1), parallel};
+    }
+/**
+ * @brief Batched rolling ball contacts computation between two 2D curves. Parameters are split into chunks solved in parallel, 
+ * inside a chunk each contact is warm-started from its predecessor's solution, hence consecutive parameters should be close.
+ * 
+ * @tparam T 
+ * @param crv1 
+ * @param crv2 
+ * @param u1_lst     : parameters on crv1
+ * @param tol_x      : parameter tolerance
+ * @param chunk_size : number of contacts solved sequentially by a task
+ * @return std::vector<RollingBall<T>> contacts, in u1_lst order
+ */
+    template <typename T>
+    auto rolling_balls(const Curve<T, 2> &crv1, const Curve<T, 2> &crv2, const std::vector<T> &u1_lst, T tol_x = 1e-6, size_t chunk_size = 32) -> std::vector<RollingBall<T>>
+    {
+        std::vector<RollingBall<T>> balls(u1_lst.size());
+        chunk_size = std::max<size_t>(1, chunk_size);
+        std::vector<size_t> chunks((u1_lst.size() + chunk_size - 1) / chunk_size);
+        std::iota(chunks.begin(), chunks.end(), 0);
+        std::for_each(
+            std::execution::par,
+            chunks.begin(), chunks.end(),
+            [&](size_t c)
+            {
+                auto i1 = c * chunk_size;
+                auto i2 = std::min(i1 + chunk_size, u1_lst.size());
+                auto u2 = extrema_curve_point(crv2, crv1(u1_lst[i1]), tol_x)[0];
+                for (auto i = i1; i < i2; i++)
+                {
+                    balls[i] = rolling_ball(crv1, crv2, u1_lst[i], u2, tol_x);
+                    u2 = balls[i].u2;
+                }
+            });
+        return balls;
+    }
+/**
+ * @brief Builds the camber line, locus of the rolling ball's center between two 2D curves, by approximating the batched contacts' centers
+ * 
+ * @tparam T 
+ * @param crv1 
+ * @param crv2 
+ * @param u1_lst : parameters on crv1
+ * @param p      : camber line's degree
+ * @param d_max  : max approximation deviation
+ * @param d_avg  : average approximation deviation
+ * @param tol_x  : contacts' parameter tolerance
+ * @return BSCurve<T, 2> 
+ */
+    template <typename T>
+    auto rolling_ball_camber(const Curve<T, 2> &crv1, const Curve<T, 2> &crv2, const std::vector<T> &u1_lst, size_t p = 3, T d_max = 1e-4, T d_avg = 1e-5, T tol_x = 1e-6) -> BSCurve<T, 2>
+    {
+        auto balls = rolling_balls(crv1, crv2, u1_lst, tol_x);
+        points_vector<T, 2> centers(balls.size());
+        std::transform(balls.begin(), balls.end(), centers.begin(), [](const auto &b) { return b.center; });
+        return approx(centers, p, KnotsCalcMode::CHORD_LENGTH, true, d_max, d_avg);
+    }
+
 } // namespace gbs
\ No newline at end of file
@@ -0,0 +1,431 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <execution>
+#include <algorithm>
+
+#include <gbs/bscurve.h>
+#include <gbs/bssurf.h>
+#include <gbs/bsctools.h>
+#include <gbs/bezierfunctions.h>
+
+namespace gbs
+{
+    namespace detail
+    {
+        template <typename T, size_t dim>
+        auto bezier_component(const std::vector<std::array<T, dim>> &poles, size_t c) -> std::vector<T>
+        {
+            std::vector<T> b(poles.size());
+            std::transform(poles.begin(), poles.end(), b.begin(), [c](const auto &P) { return P[c]; });
+            return b;
+        }
+
+        template <typename T, size_t dim>
+        auto check_arithmetic_operand(const BSCurve<T, dim> &crv) -> void
+        {
+            if (crv.degree() == 0)
+                throw std::invalid_argument("B-Spline arithmetic requires curves of degree 1 at least.");
+        }
+        // unique knots of both curves, which have to share their bounds
+        template <typename T, size_t dim1, size_t dim2>
+        auto merged_breaks(const BSCurve<T, dim1> &crv1, const BSCurve<T, dim2> &crv2) -> std::vector<T>
+        {
+            auto [u1, u2] = crv1.bounds();
+            auto [v1, v2] = crv2.bounds();
+            if (std::fabs(u1 - v1) > knot_eps<T> || std::fabs(u2 - v2) > knot_eps<T>)
+                throw std::invalid_argument("B-Spline arithmetic requires operands defined on the same bounds.");
+            auto breaks = crv1.knots();
+            auto k2 = crv2.knots();
+            breaks.insert(breaks.end(), k2.begin(), k2.end());
+            std::sort(breaks.begin(), breaks.end());
+            breaks.erase(std::unique(breaks.begin(), breaks.end(), [](T a, T b) { return b - a < knot_eps<T>; }), breaks.end());
+            return breaks;
+        }
+        // Bezier segments' poles on the given breaks, which have to contain curve's knots
+        template <typename T, size_t dim>
+        auto bezier_segments_on(const BSCurve<T, dim> &crv, const std::vector<T> &breaks) -> std::vector<std::vector<std::array<T, dim>>>
+        {
+            auto k = crv.knotsFlats();
+            auto poles = crv.poles();
+            for (size_t i{1}; i + 1 < breaks.size(); i++)
+                if (multiplicity(k, breaks[i]) == 0)
+                    insert_knots(breaks[i], crv.degree(), 1, k, poles);
+            auto segments = bezier_segments(k, poles, crv.degree());
+            std::vector<std::vector<std::array<T, dim>>> seg_poles(segments.size());
+            std::transform(segments.begin(), segments.end(), seg_poles.begin(), [](auto &seg) { return std::move(seg.first); });
+            return seg_poles;
+        }
+        // C0 join of Bezier segments of degree p, interior knots are then removed as far as the exact continuity allows
+        template <typename T, size_t dim>
+        auto join_bezier_segments(const std::vector<std::vector<std::array<T, dim>>> &segments, const std::vector<T> &breaks, size_t p) -> BSCurve<T, dim>
+        {
+            std::vector<std::array<T, dim>> poles{segments.front()};
+            std::vector<T> k(p + 1, breaks.front());
+            for (size_t s{1}; s < segments.size(); s++)
+            {
+                poles.insert(poles.end(), std::next(segments[s].begin()), segments[s].end());
+                k.insert(k.end(), p, breaks[s]);
+            }
+            k.insert(k.end(), p + 1, breaks.back());
+            T scale{1};
+            for (const auto &P : poles)
+                scale = std::max(scale, norm(P));
+            auto tol = T(1e4) * std::numeric_limits<T>::epsilon() * scale;
+            for (size_t i{1}; i + 1 < breaks.size(); i++)
+                remove_knot(breaks[i], p, p, k, poles, tol);
+            return BSCurve<T, dim>{poles, k, p};
+        }
+        // pieces of a Bezier segment defined on [t1, t2] whose components each lie in a single span of their breaks:
+        // {local Bernstein coefficients per component, end parameter, span per component}
+        template <typename T>
+        struct BezierPiece
+        {
+            std::vector<std::vector<T>> b;
+            T u2;
+            std::vector<size_t> spans;
+        };
+        template <typename T>
+        auto bezier_pieces(const std::vector<std::vector<T>> &fb, const std::vector<const std::vector<T> *> &comp_breaks, T t1, T t2, T tol_x) -> std::vector<BezierPiece<T>>
+        {
+            auto tol_loc = tol_x / (t2 - t1);
+            std::vector<T> cuts;
+            for (size_t c{}; c < fb.size(); c++)
+            {
+                const auto &breaks = *comp_breaks[c];
+                for (size_t j{1}; j + 1 < breaks.size(); j++)
+                {
+                    std::vector<T> shifted(fb[c].size());
+                    std::transform(fb[c].begin(), fb[c].end(), shifted.begin(), [&](T v) { return v - breaks[j]; });
+                    for (auto t : bezier_roots(shifted, tol_loc))
+                        if (t > tol_loc && t < 1 - tol_loc)
+                            cuts.push_back(t);
+                }
+            }
+            std::sort(cuts.begin(), cuts.end());
+            cuts.erase(std::unique(cuts.begin(), cuts.end(), [tol_loc](T a, T b) { return b - a < tol_loc; }), cuts.end());
+            cuts.push_back(T(1));
+            std::vector<BezierPiece<T>> pieces;
+            T t_prev{0};
+            auto rest = fb;
+            for (auto t : cuts)
+            {
+                // rest is defined on [t_prev, 1]
+                BezierPiece<T> pc{{}, t1 + t * (t2 - t1), {}};
+                for (size_t c{}; c < fb.size(); c++)
+                {
+                    auto [left, right] = t < T(1) ? bezier_split(rest[c], (t - t_prev) / (1 - t_prev)) : std::make_pair(rest[c], rest[c]);
+                    const auto &breaks = *comp_breaks[c];
+                    auto it = std::upper_bound(std::next(breaks.begin()), std::prev(breaks.end()), bezier_value(left, T(0.5)));
+                    pc.spans.push_back(size_t(std::distance(breaks.begin(), it) - 1));
+                    pc.b.push_back(std::move(left));
+                    rest[c] = std::move(right);
+                }
+                pieces.push_back(std::move(pc));
+                t_prev = t;
+            }
+            return pieces;
+        }
+        // pieces of all segments in a row, with the breaks between them
+        template <typename T>
+        auto flat_pieces(const std::vector<std::vector<BezierPiece<T>>> &seg_pieces, const std::vector<T> &seg_breaks) -> std::pair<std::vector<const BezierPiece<T> *>, std::vector<T>>
+        {
+            std::vector<const BezierPiece<T> *> pieces;
+            std::vector<T> breaks{seg_breaks.front()};
+            for (const auto &seg : seg_pieces)
+                for (const auto &pc : seg)
+                {
+                    pieces.push_back(&pc);
+                    breaks.push_back(pc.u2);
+                }
+            breaks.back() = seg_breaks.back();
+            return {pieces, breaks};
+        }
+        // Bernstein coefficients of the span's local parameter s = (x - x1) / (x2 - x1) and of 1 - s
+        template <typename T>
+        auto local_parameter(const std::vector<T> &x, T x1, T x2) -> std::pair<std::vector<T>, std::vector<T>>
+        {
+            std::vector<T> s(x.size()), one_minus_s(x.size());
+            std::transform(x.begin(), x.end(), s.begin(), [&](T v) { return (v - x1) / (x2 - x1); });
+            std::transform(s.begin(), s.end(), one_minus_s.begin(), [](T v) { return 1 - v; });
+            return {s, one_minus_s};
+        }
+        // de Casteljau with polynomial coefficients b evaluated at the polynomial s
+        template <typename T>
+        auto bezier_substitute(std::vector<std::vector<T>> b, const std::vector<T> &s, const std::vector<T> &one_minus_s) -> std::vector<T>
+        {
+            auto q = b.size() - 1;
+            for (size_t r{1}; r <= q; r++)
+                for (size_t i{}; i <= q - r; i++)
+                    b[i] = bezier_combine(bezier_product(one_minus_s, b[i]), bezier_product(s, b[i + 1]));
+            return b.front();
+        }
+        // Bezier product of curves of dim1 and dim2 on a common segmentation, op combines the segments' poles
+        template <typename T, size_t dim, size_t dim1, size_t dim2, typename Op>
+        auto bezier_arithmetic(const BSCurve<T, dim1> &crv1, const BSCurve<T, dim2> &crv2, const Op &op) -> BSCurve<T, dim>
+        {
+            check_arithmetic_operand(crv1);
+            check_arithmetic_operand(crv2);
+            auto breaks = merged_breaks(crv1, crv2);
+            auto seg1 = bezier_segments_on(crv1, breaks);
+            auto seg2 = bezier_segments_on(crv2, breaks);
+            std::vector<std::vector<std::array<T, dim>>> segments(seg1.size());
+            std::transform(std::execution::par, seg1.begin(), seg1.end(), seg2.begin(), segments.begin(), op);
+            return join_bezier_segments(segments, breaks, crv1.degree() + crv2.degree());
+        }
+    }
+    /**
+     * @brief Exact product of a scalar function by a curve, evaluated without resampling.
+     * Both operands are split into Bezier segments on their merged knots, segments are multiplied in the Bernstein basis
+     * and joined back. The result is of degree p+q and keeps the lowest continuity of the operands at each knot.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param f : scalar function, as a 1d curve
+     * @param g : curve, defined on the same bounds as f
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto product(const BSCurve<T, 1> &f, const BSCurve<T, dim> &g) -> BSCurve<T, dim>
+    {
+        return detail::bezier_arithmetic<T, dim>(f, g, [](const auto &f_seg, const auto &g_seg)
+        {
+            auto fb = detail::bezier_component(f_seg, 0);
+            std::vector<std::vector<T>> h(dim);
+            for (size_t c{}; c < dim; c++)
+                h[c] = bezier_product(fb, detail::bezier_component(g_seg, c));
+            std::vector<std::array<T, dim>> poles(h.front().size());
+            for (size_t i{}; i < poles.size(); i++)
+                for (size_t c{}; c < dim; c++)
+                    poles[i][c] = h[c][i];
+            return poles;
+        });
+    }
+    /**
+     * @brief Exact product of a scalar function by a curve, see product(const BSCurve<T, 1> &, const BSCurve<T, dim> &)
+     *
+     * @tparam T
+     * @tparam dim
+     * @param f
+     * @param g
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto product(const BSCfunction<T> &f, const BSCurve<T, dim> &g) -> BSCurve<T, dim>
+    {
+        return product(f.basisCurve(), g);
+    }
+    /**
+     * @brief Exact product of two scalar functions, see product(const BSCurve<T, 1> &, const BSCurve<T, dim> &)
+     *
+     * @tparam T
+     * @param f
+     * @param g
+     * @return BSCfunction<T>
+     */
+    template <typename T>
+    auto product(const BSCfunction<T> &f, const BSCfunction<T> &g) -> BSCfunction<T>
+    {
+        return BSCfunction<T>{product(f.basisCurve(), g.basisCurve())};
+    }
+    /**
+     * @brief Exact dot product of two curves as a scalar function of degree p+q
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv1
+     * @param crv2 : curve defined on the same bounds as crv1
+     * @return BSCfunction<T>
+     */
+    template <typename T, size_t dim>
+    auto dot_product(const BSCurve<T, dim> &crv1, const BSCurve<T, dim> &crv2) -> BSCfunction<T>
+    {
+        return BSCfunction<T>{detail::bezier_arithmetic<T, 1>(crv1, crv2, [](const auto &seg1, const auto &seg2)
+        {
+            auto h = bezier_product(detail::bezier_component(seg1, 0), detail::bezier_component(seg2, 0));
+            for (size_t c{1}; c < dim; c++)
+                h = bezier_combine(h, bezier_product(detail::bezier_component(seg1, c), detail::bezier_component(seg2, c)));
+            std::vector<std::array<T, 1>> poles(h.size());
+            std::transform(h.begin(), h.end(), poles.begin(), [](T v) { return std::array<T, 1>{v}; });
+            return poles;
+        })};
+    }
+    /**
+     * @brief Exact linear combination alpha * crv1 + beta * crv2, operands are brought to the same degree and knots
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv1
+     * @param crv2  : curve defined on the same bounds as crv1
+     * @param alpha
+     * @param beta
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto sum(const BSCurve<T, dim> &crv1, const BSCurve<T, dim> &crv2, T alpha = T(1), T beta = T(1)) -> BSCurve<T, dim>
+    {
+        detail::merged_breaks(crv1, crv2); // bounds check
+        std::vector<BSCurveInfo<T, dim>> infos{crv1.info(), crv2.info()};
+        unify_degree(infos);
+        unify_knots(infos);
+        auto &[poles1, k1, p1] = infos.front();
+        const auto &poles2 = std::get<0>(infos.back());
+        for (size_t i{}; i < poles1.size(); i++)
+            for (size_t c{}; c < dim; c++)
+                poles1[i][c] = alpha * poles1[i][c] + beta * poles2[i][c];
+        return BSCurve<T, dim>{poles1, k1, p1};
+    }
+    /**
+     * @brief Exact linear combination alpha * f + beta * g of two scalar functions
+     *
+     * @tparam T
+     * @param f
+     * @param g     : function defined on the same bounds as f
+     * @param alpha
+     * @param beta
+     * @return BSCfunction<T>
+     */
+    template <typename T>
+    auto sum(const BSCfunction<T> &f, const BSCfunction<T> &g, T alpha = T(1), T beta = T(1)) -> BSCfunction<T>
+    {
+        return BSCfunction<T>{sum(f.basisCurve(), g.basisCurve(), alpha, beta)};
+    }
+    /**
+     * @brief Curve multiplied by a scalar, i.e. with scaled poles
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv
+     * @param s
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto scaled(const BSCurve<T, dim> &crv, T s) -> BSCurve<T, dim>
+    {
+        return BSCurve<T, dim>{scaled_poles(crv.poles(), s), crv.knotsFlats(), crv.degree()};
+    }
+    /**
+     * @brief Exact composition crv(f(u)), for instance a reparametrization. The result is of degree p*q and defined on f's bounds.
+     * f's Bezier segments are split where f crosses crv's knots, each piece is then composed in the Bernstein basis
+     * by a symbolic de Casteljau's algorithm. f's values have to lie in crv's bounds.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv   : curve of degree q
+     * @param f     : scalar function of degree p
+     * @param tol_x : parameter tolerance of f's crossings with crv's knots
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto compose(const BSCurve<T, dim> &crv, const BSCfunction<T> &f, T tol_x = 1e-12) -> BSCurve<T, dim>
+    {
+        const auto &fc = f.basisCurve();
+        detail::check_arithmetic_operand(crv);
+        detail::check_arithmetic_operand(fc);
+        auto p = fc.degree(), q = crv.degree();
+        auto crv_breaks = crv.knots();
+        auto crv_segments = detail::bezier_segments_on(crv, crv_breaks);
+        auto f_breaks = fc.knots();
+        auto f_segments = detail::bezier_segments_on(fc, f_breaks);
+
+        std::vector<std::vector<detail::BezierPiece<T>>> seg_pieces(f_segments.size());
+        std::vector<size_t> ids(f_segments.size());
+        std::iota(ids.begin(), ids.end(), 0);
+        std::transform(std::execution::par, ids.begin(), ids.end(), seg_pieces.begin(), [&](size_t s)
+        {
+            return detail::bezier_pieces<T>({detail::bezier_component(f_segments[s], 0)}, {&crv_breaks}, f_breaks[s], f_breaks[s + 1], tol_x);
+        });
+        auto [pieces, breaks] = detail::flat_pieces(seg_pieces, f_breaks);
+
+        std::vector<std::vector<std::array<T, dim>>> segments(pieces.size());
+        std::transform(std::execution::par, pieces.begin(), pieces.end(), segments.begin(), [&](const detail::BezierPiece<T> *pc)
+        {
+            auto [s, one_minus_s] = detail::local_parameter(pc->b[0], crv_breaks[pc->spans[0]], crv_breaks[pc->spans[0] + 1]);
+            const auto &P = crv_segments[pc->spans[0]];
+            std::vector<std::array<T, dim>> poles;
+            for (size_t c{}; c < dim; c++)
+            {
+                std::vector<std::vector<T>> b(q + 1);
+                for (size_t i{}; i <= q; i++)
+                    b[i] = {P[i][c]};
+                auto h = detail::bezier_substitute(b, s, one_minus_s);
+                poles.resize(h.size());
+                for (size_t i{}; i < poles.size(); i++)
+                    poles[i][c] = h[i];
+            }
+            return poles;
+        });
+        return detail::join_bezier_segments(segments, breaks, p * q);
+    }
+    /**
+     * @brief Exact curve on surface srf(crv(u)) as a single B-Spline of degree (p+q)*d, defined on crv's bounds.
+     * crv's Bezier segments are split where they cross srf's knots, each piece is then composed with the matching
+     * Bezier patch by a symbolic tensor de Casteljau's algorithm. crv's values have to lie in srf's bounds.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param srf   : non rational surface of degrees p, q
+     * @param crv   : parametric curve of degree d
+     * @param tol_x : parameter tolerance of crv's crossings with srf's knots
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto compose(const BSSurface<T, dim> &srf, const BSCurve<T, 2> &crv, T tol_x = 1e-12) -> BSCurve<T, dim>
+    {
+        detail::check_arithmetic_operand(crv);
+        auto p = srf.degreeU(), q = srf.degreeV(), d = crv.degree();
+        if (p == 0 || q == 0)
+            throw std::invalid_argument("B-Spline arithmetic requires surfaces of degree 1 at least.");
+        // Bezier patches
+        auto bz = srf;
+        auto ku = srf.knotsU(), kv = srf.knotsV();
+        auto mu = srf.multsU(), mv = srf.multsV();
+        for (size_t i{1}; i + 1 < ku.size(); i++)
+            if (mu[i] < p)
+                bz.insertKnotU(ku[i], p - mu[i]);
+        for (size_t j{1}; j + 1 < kv.size(); j++)
+            if (mv[j] < q)
+                bz.insertKnotV(kv[j], q - mv[j]);
+
+        const auto &bz_poles = bz.poles();
+        auto nu = bz.nPolesU();
+
+        auto crv_breaks = crv.knots();
+        auto crv_segments = detail::bezier_segments_on(crv, crv_breaks);
+        std::vector<std::vector<detail::BezierPiece<T>>> seg_pieces(crv_segments.size());
+        std::vector<size_t> ids(crv_segments.size());
+        std::iota(ids.begin(), ids.end(), 0);
+        std::transform(std::execution::par, ids.begin(), ids.end(), seg_pieces.begin(), [&](size_t s)
+        {
+            return detail::bezier_pieces<T>({detail::bezier_component(crv_segments[s], 0), detail::bezier_component(crv_segments[s], 1)}, {&ku, &kv}, crv_breaks[s], crv_breaks[s + 1], tol_x);
+        });
+        auto [pieces, breaks] = detail::flat_pieces(seg_pieces, crv_breaks);
+
+        std::vector<std::vector<std::array<T, dim>>> segments(pieces.size());
+        std::transform(std::execution::par, pieces.begin(), pieces.end(), segments.begin(), [&](const detail::BezierPiece<T> *pc)
+        {
+            auto iu = pc->spans[0], iv = pc->spans[1];
+            auto [s, one_minus_s] = detail::local_parameter(pc->b[0], ku[iu], ku[iu + 1]);
+            auto [t, one_minus_t] = detail::local_parameter(pc->b[1], kv[iv], kv[iv + 1]);
+            std::vector<std::array<T, dim>> poles;
+            for (size_t c{}; c < dim; c++)
+            {
+                // rows along u first, then the column of rows along v
+                std::vector<std::vector<T>> col(q + 1);
+                for (size_t j{}; j <= q; j++)
+                {
+                    std::vector<std::vector<T>> row(p + 1);
+                    for (size_t i{}; i <= p; i++)
+                        row[i] = {bz_poles[iu * p + i + (iv * q + j) * nu][c]};
+                    col[j] = detail::bezier_substitute(row, s, one_minus_s);
+                }
+                auto h = detail::bezier_substitute(col, t, one_minus_t);
+                poles.resize(h.size());
+                for (size_t i{}; i < poles.size(); i++)
+                    poles[i][c] = h[i];
+            }
+            return poles;
+        });
+        return detail::join_bezier_segments(segments, breaks, (p + q) * d);
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <gbs/bscurve.h>
 #include <gbs/transform.h>
+#include <numbers>
 
 namespace gbs
 {
@@ -98,6 +99,51 @@ namespace gbs
     {
         return build_ellipse(radius,radius,center);
     }
+    /**
+     * @brief Build NURBS definition of a circle's arc from angle a1 to angle a2, if dim > 2 the arc is in the xy plane.
+     * The arc is split into the same quadratic rational segments as build_circle, none spanning more than a quarter of turn.
+     * The parametrization goes from 0. to 1., knots are evenly spaced in angle.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param radius
+     * @param a1 : start angle
+     * @param a2 : end angle
+     * @param center
+     * @return BSCurveRational<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto build_arc(T radius, T a1, T a2, const std::array<T, dim> &center = std::array<T, dim>{}) -> BSCurveRational<T, dim>
+    {
+        if (a2 <= a1)
+            throw std::invalid_argument("Arc's end angle must be greater than its start angle.");
+        auto n = std::max<size_t>(1, static_cast<size_t>(std::ceil((a2 - a1) / (0.5 * std::numbers::pi) - 1e-10)));
+        auto da = (a2 - a1) / n;
+        auto wi = std::cos(0.5 * da);
+
+        std::vector<T> k(2 * n + 4);
+        k[0] = k[1] = k[2] = 0.;
+        for (size_t i{1}; i < n; i++)
+            k[2 * i + 1] = k[2 * i + 2] = T(i) / n;
+        k[2 * n + 1] = k[2 * n + 2] = k[2 * n + 3] = 1.;
+
+        std::vector<std::array<T, dim + 1>> poles(2 * n + 1);
+        for (size_t i{}; i <= 2 * n; i++)
+        {
+            auto a = a1 + 0.5 * da * i;
+            auto w = i % 2 ? wi : T(1);
+            auto r = i % 2 ? radius / wi : radius;
+            poles[i][0] = w * r * std::cos(a);
+            poles[i][1] = w * r * std::sin(a);
+            for (size_t d{2}; d < dim; d++)
+                poles[i][d] = 0.;
+            poles[i].back() = w;
+            for (size_t d{}; d < dim; d++)
+                poles[i][d] += w * center[d];
+        }
+
+        return BSCurveRational<T, dim>(poles, k, 2);
+    }
     /**
      * @brief Builds the derivate curve, aka 
      *  d C(u)
@@ -111,27 +157,8 @@ namespace gbs
     template <typename T, size_t dim>
     auto build_derivate(const BSCurve<T,dim> &crv) -> BSCurve<T,dim>
     {
-        auto poles = crv.poles();
-        auto knots = crv.knotsFlats();
-        points_vector<T, dim> new_poles{crv.poles().size() - 1};
-        auto p = crv.degree();
-        auto n = new_poles.size();
-        // std::vector<size_t> chunck(n);
-        // std::generate(chunck.begin(), chunck.end(), [&, i = -1]() mutable {i++;return i; });
-        // std::transform(
-        //     std::execution::par,
-        //     chunck.begin(), chunck.end(),
-        //     new_poles.begin(),
-        //     [&](const auto i) {
-        //         return T(p) * (poles[i + 1] - poles[i]) / (knots[i + p + 1] - knots[i + 1]);
-        //     });
-        for(auto i = 0 ; i < n ; i++)
-        {
-            new_poles[i] = T(p) * (poles[i+1]-poles[i]) / (knots[i+p+1]-knots[i+1]);
-        }
-        knots.pop_back();
-        knots.erase(knots.begin());
-        return BSCurve<T,dim>(new_poles,knots,p-1);
+        auto [poles, knots] = hodograph(crv.knotsFlats(), crv.poles(), crv.degree());
+        return BSCurve<T,dim>(poles, knots, crv.degree() > 0 ? crv.degree() - 1 : 0);
     }
     /**
      * @brief Builds the integral curve from point P0 aka
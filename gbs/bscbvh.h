@@ -0,0 +1,308 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <limits>
+
+#include <gbs/bscurve.h>
+#include <gbs/extrema.h>
+
+namespace gbs
+{
+    /**
+     * @brief Axis aligned bounding box {min corner, max corner}
+     *
+     * @tparam T
+     * @tparam dim
+     */
+    template <typename T, size_t dim>
+    using bounding_box = std::array<point<T, dim>, 2>;
+
+    /**
+     * @brief Bounding box of a points set
+     *
+     * @tparam T
+     * @tparam dim
+     * @param pts
+     * @return bounding_box<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto points_bounding_box(const points_vector<T, dim> &pts) -> bounding_box<T, dim>
+    {
+        bounding_box<T, dim> bx;
+        bx[0].fill( std::numeric_limits<T>::max());
+        bx[1].fill(-std::numeric_limits<T>::max());
+        for (const auto &pt : pts)
+        {
+            for (size_t i{}; i < dim; i++)
+            {
+                bx[0][i] = std::min(bx[0][i], pt[i]);
+                bx[1][i] = std::max(bx[1][i], pt[i]);
+            }
+        }
+        return bx;
+    }
+    /**
+     * @brief Bounding box of the curve's control polygon, by convex hull property the curve lies inside.
+     * Rational poles are projected, the property then requires positive weights.
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam rational
+     * @param crv
+     * @return bounding_box<T, dim>
+     */
+    template <typename T, size_t dim, bool rational>
+    auto poles_bounding_box(const BSCurveGeneral<T, dim, rational> &crv) -> bounding_box<T, dim>
+    {
+        if constexpr (rational)
+            return points_bounding_box(poles_projected<T, dim>(crv.poles()));
+        else
+            return points_bounding_box(crv.poles());
+    }
+    /**
+     * @brief Smallest box containing both boxes
+     *
+     * @tparam T
+     * @tparam dim
+     * @param bx1
+     * @param bx2
+     * @return bounding_box<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto merged_boxes(const bounding_box<T, dim> &bx1, const bounding_box<T, dim> &bx2) -> bounding_box<T, dim>
+    {
+        bounding_box<T, dim> bx;
+        for (size_t i{}; i < dim; i++)
+        {
+            bx[0][i] = std::min(bx1[0][i], bx2[0][i]);
+            bx[1][i] = std::max(bx1[1][i], bx2[1][i]);
+        }
+        return bx;
+    }
+    /**
+     * @brief Square distance from point to box, null if the point is inside
+     *
+     * @tparam T
+     * @tparam dim
+     * @param bx
+     * @param pt
+     * @return T
+     */
+    template <typename T, size_t dim>
+    auto sq_distance(const bounding_box<T, dim> &bx, const point<T, dim> &pt) -> T
+    {
+        T d{};
+        for (size_t i{}; i < dim; i++)
+        {
+            auto delta = std::max({bx[0][i] - pt[i], T(0), pt[i] - bx[1][i]});
+            d += delta * delta;
+        }
+        return d;
+    }
+
+    /**
+     * @brief Bounding volume hierarchy over a B-Spline curves set, used to speed up nearest curve queries.
+     * Boxes are built on control polygons so the curves are guaranteed to lie inside.
+     * Curves are not copied, they have to outlive the hierarchy.
+     *
+     * @tparam T
+     * @tparam dim
+     */
+    template <typename T, size_t dim>
+    class CurvesBVH
+    {
+        struct Node
+        {
+            bounding_box<T, dim> box;
+            size_t first;  // first curve in m_ids if leaf, else left child
+            size_t count;  // number of curves if leaf, 0 for internal nodes
+            size_t right;  // right child for internal nodes
+        };
+
+        std::vector<const Curve<T, dim> *> m_curves;
+        std::vector<bounding_box<T, dim>> m_boxes;
+        std::vector<size_t> m_ids;
+        std::vector<Node> m_nodes;
+        size_t m_leaf_size;
+
+        auto build(size_t first, size_t last) -> size_t
+        {
+            auto box = m_boxes[m_ids[first]];
+            bounding_box<T, dim> centers_box{center(box), center(box)};
+            for (auto i = first + 1; i < last; i++)
+            {
+                box = merged_boxes(box, m_boxes[m_ids[i]]);
+                auto c = center(m_boxes[m_ids[i]]);
+                centers_box = merged_boxes(centers_box, {c, c});
+            }
+            auto id = m_nodes.size();
+            m_nodes.push_back({box, first, last - first, 0});
+            if (last - first <= m_leaf_size)
+                return id;
+            // split along the largest centers' extent at median
+            auto extent = centers_box[1] - centers_box[0];
+            auto axis = std::distance(extent.begin(), std::max_element(extent.begin(), extent.end()));
+            auto mid = first + (last - first) / 2;
+            std::nth_element(
+                std::next(m_ids.begin(), first),
+                std::next(m_ids.begin(), mid),
+                std::next(m_ids.begin(), last),
+                [this, axis](size_t i1, size_t i2)
+                {
+                    return m_boxes[i1][0][axis] + m_boxes[i1][1][axis] < m_boxes[i2][0][axis] + m_boxes[i2][1][axis];
+                });
+            auto left = build(first, mid);
+            auto right = build(mid, last);
+            m_nodes[id].first = left;
+            m_nodes[id].count = 0;
+            m_nodes[id].right = right;
+            return id;
+        }
+
+        static auto center(const bounding_box<T, dim> &bx) -> point<T, dim>
+        {
+            return T(0.5) * (bx[0] + bx[1]);
+        }
+
+    public:
+        /**
+         * @brief Build the hierarchy from a range of curves, or of pointers (raw or smart) to curves
+         *
+         * @tparam ForwardIt
+         * @param first
+         * @param last
+         * @param leaf_size : maximum number of curves per leaf
+         */
+        template <typename ForwardIt>
+        CurvesBVH(ForwardIt first, ForwardIt last, size_t leaf_size = 4) : m_leaf_size{std::max<size_t>(1, leaf_size)}
+        {
+            auto n = std::distance(first, last);
+            if (n == 0)
+                throw std::invalid_argument("CurvesBVH: empty curves set.");
+            m_curves.reserve(n);
+            m_boxes.reserve(n);
+            std::for_each(first, last, [this](const auto &c)
+            {
+                const auto &crv = [&c]() -> const auto & {
+                    if constexpr (requires { c->bounds(); }) return *c;
+                    else return c;
+                }();
+                m_curves.push_back(&crv);
+                m_boxes.push_back(poles_bounding_box(crv));
+            });
+            m_ids.resize(n);
+            std::iota(m_ids.begin(), m_ids.end(), 0);
+            m_nodes.reserve(2 * n / m_leaf_size + 1);
+            build(0, n);
+        }
+        /**
+         * @brief Finds the closest curve to point, candidates are pruned by box distance before projection
+         *
+         * @param pt    : the point
+         * @param tol_x : projection tolerance
+         * @return std::tuple<size_t, T, T> (curve index in construction range, parameter on curve, distance)
+         */
+        auto closest(const point<T, dim> &pt, T tol_x = 1e-6) const -> std::tuple<size_t, T, T>
+        {
+            using item = std::pair<T, size_t>; // (box square distance, node id)
+            std::priority_queue<item, std::vector<item>, std::greater<item>> queue;
+            queue.push({sq_distance(m_nodes.front().box, pt), 0});
+
+            auto best = std::make_tuple(m_curves.size(), T{}, std::numeric_limits<T>::max());
+            auto best_sq_d = std::numeric_limits<T>::max();
+            while (!queue.empty())
+            {
+                auto [sq_d, id] = queue.top();
+                queue.pop();
+                if (sq_d >= best_sq_d)
+                    break; // remaining boxes are farther
+                const auto &node = m_nodes[id];
+                if (node.count == 0)
+                {
+                    queue.push({sq_distance(m_nodes[node.first].box, pt), node.first});
+                    queue.push({sq_distance(m_nodes[node.right].box, pt), node.right});
+                    continue;
+                }
+                for (auto i = node.first; i < node.first + node.count; i++)
+                {
+                    auto ic = m_ids[i];
+                    if (sq_distance(m_boxes[ic], pt) >= best_sq_d)
+                        continue;
+                    const auto &crv = *m_curves[ic];
+                    auto u = extrema_curve_point(crv, pt, tol_x)[0];
+                    auto sq_d = sq_distance(crv(u), pt);
+                    if (sq_d < best_sq_d)
+                    {
+                        best_sq_d = sq_d;
+                        best = std::make_tuple(ic, u, std::sqrt(sq_d));
+                    }
+                }
+            }
+            return best;
+        }
+        /**
+         * @brief Batched closest curve queries, run in parallel
+         *
+         * @param pts   : the points
+         * @param tol_x : projection tolerance
+         * @return std::vector<std::tuple<size_t, T, T>> for each point (curve index, parameter on curve, distance)
+         */
+        auto closest(const points_vector<T, dim> &pts, T tol_x = 1e-6) const -> std::vector<std::tuple<size_t, T, T>>
+        {
+            std::vector<std::tuple<size_t, T, T>> res(pts.size());
+            std::transform(
+                std::execution::par,
+                pts.begin(), pts.end(),
+                res.begin(),
+                [this, tol_x](const auto &pt)
+                { return closest(pt, tol_x); });
+            return res;
+        }
+        /**
+         * @brief Number of curves in the hierarchy
+         *
+         * @return size_t
+         */
+        auto size() const noexcept -> size_t { return m_curves.size(); }
+        /**
+         * @brief Access curve by its index in the construction range
+         *
+         * @param i
+         * @return const Curve<T, dim>&
+         */
+        auto curve(size_t i) const -> const Curve<T, dim> & { return *m_curves.at(i); }
+        /**
+         * @brief Control polygon box of curve i
+         *
+         * @param i
+         * @return const bounding_box<T, dim>&
+         */
+        auto box(size_t i) const -> const bounding_box<T, dim> & { return m_boxes.at(i); }
+        /**
+         * @brief Box containing all the curves
+         *
+         * @return const bounding_box<T, dim>&
+         */
+        auto bounds() const -> const bounding_box<T, dim> & { return m_nodes.front().box; }
+    };
+
+    /**
+     * @brief Batched closest curves queries using a bounding volume hierarchy built over the curves range
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam ForwardIt
+     * @param pts         : the points
+     * @param curve_begin : curves, or curves' pointers, range start
+     * @param curve_end   : curves, or curves' pointers, range end
+     * @param tol
+     * @return std::vector<std::tuple<size_t, T, T>> for each point (curve index, parameter on curve, distance)
+     */
+    template <typename T, size_t dim, typename ForwardIt>
+    auto closest_curves(const points_vector<T, dim> &pts, ForwardIt curve_begin, ForwardIt curve_end, T tol = 1e-6)
+    {
+        CurvesBVH<T, dim> bvh{curve_begin, curve_end};
+        return bvh.closest(pts, tol);
+    }
+}
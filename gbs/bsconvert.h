@@ -0,0 +1,84 @@
+#pragma once
+#include <gbs/bscarithmetic.h>
+#include <gbs/bscbuild.h>
+#include <gbs/adaptiveapprox.h>
+#include <gbs/surfaceofrevolution.h>
+#include <gbs/curveonsurface.h>
+
+namespace gbs
+{
+    /**
+     * @brief NURBS definition of a surface of revolution, the profile swept by build_arc's rational arcs.
+     * B-Spline profiles, rational or not, are converted exactly, other profiles are first approximated within tolerance, see approx_adaptive.
+     * The result is geometrically exact: u is the profile's parameter and v matches the rotation angle at v knots, which are evenly spaced on the angle span.
+     *
+     * @tparam T
+     * @param srf : the surface of revolution
+     * @param tol : approximation tolerance of a non B-Spline profile
+     * @param p   : approximation degree of a non B-Spline profile
+     * @return BSSurfaceRational<T, 3>
+     */
+    template <typename T>
+    auto to_bs_surface(const SurfaceOfRevolution<T> &srf, T tol = 1e-6, size_t p = 3) -> BSSurfaceRational<T, 3>
+    {
+        const auto &p_crv = srf.basisCurve();
+        std::shared_ptr<const BSCurveRational<T, 2>> profile = std::dynamic_pointer_cast<const BSCurveRational<T, 2>>(p_crv);
+        if (!profile)
+        {
+            auto p_bs = std::dynamic_pointer_cast<const BSCurve<T, 2>>(p_crv);
+            profile = std::make_shared<BSCurveRational<T, 2>>(p_bs ? *p_bs : approx_adaptive<T, 2>(*p_crv, curve_breaks(*p_crv, p, 0), tol, p));
+        }
+        auto [v1, v2] = srf.boundsV();
+        auto arc = build_arc<T, 2>(1., v1, v2);
+
+        const auto &ax = srf.axis()[1];
+        const auto &poles_u = profile->poles();
+        const auto &poles_v = arc.poles();
+        auto nu = poles_u.size();
+        auto nv = poles_v.size();
+        points_vector<T, 4> poles(nu * nv);
+        for (size_t i{}; i < nu; i++)
+        {
+            // profile's pole in the sweeping frame, rotated the same way as SurfaceOfRevolution::value
+            const auto &Pw = poles_u[i];
+            auto Q = add_dimension<T, 2>(point<T, 2>{Pw[0] / Pw[2], Pw[1] / Pw[2]}, 0.);
+            transform(Q, srf.transformation());
+            auto C = ax * (ax * Q);
+            auto r = Q - C;
+            auto n = ax ^ r;
+            for (size_t j{}; j < nv; j++)
+            {
+                const auto &Aw = poles_v[j];
+                auto w = Pw[2] * Aw[2];
+                auto P = C + r * (Aw[0] / Aw[2]) + n * (Aw[1] / Aw[2]);
+                poles[i + j * nu] = {w * P[0], w * P[1], w * P[2], w};
+            }
+        }
+        auto kv = arc.knotsFlats();
+        std::transform(kv.begin(), kv.end(), kv.begin(), [v1, v2](T k) { return v1 + k * (v2 - v1); });
+        return BSSurfaceRational<T, 3>{poles, profile->knotsFlats(), kv, profile->degree(), 2};
+    }
+    /**
+     * @brief B-Spline definition of a curve on surface.
+     * When both the parametric curve and the surface are non rational B-Splines, the result is their exact composition of degree (p+q)*d, see compose.
+     * Otherwise, the curve is approximated within tolerance, see approx_adaptive.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv   : the curve on surface
+     * @param tol   : approximation tolerance, if not exact
+     * @param p     : approximation degree, if not exact
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto to_bs_curve(const CurveOnSurface<T, dim> &crv, T tol = 1e-6, size_t p = 3) -> BSCurve<T, dim>
+    {
+        auto p_uv = dynamic_cast<const BSCurve<T, 2> *>(&crv.basisCurve());
+        auto p_srf = dynamic_cast<const BSSurface<T, dim> *>(&crv.basisSurface());
+        if (p_uv && p_srf)
+        {
+            return compose(*p_srf, *p_uv);
+        }
+        return approx_adaptive<T, dim>(crv, curve_breaks(crv.basisCurve(), p, 0), tol, p);
+    }
+}
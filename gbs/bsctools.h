@@ -2,6 +2,7 @@
 #include <gbs/bscurve.h>
 #include <gbs/bscanalysis.h>
 #include <gbs/bscinterp.h>
+#include <gbs/adaptiveapprox.h>
 #include <gbs/vecop.h>
 #include <gbs/transform.h>
 #include <numbers>
@@ -458,6 +459,102 @@ namespace gbs
         using crvType = typename std::conditional<rational1 || rational2,BSCurveRational<T,dim>,BSCurve<T,dim>>::type;
         return std::make_unique<crvType>(join(*crv1,*crv2));
     }
+    /**
+     * @brief join a sequence of curves' definitions at tail/head in a single pass, degrees are unified once for the whole
+     * sequence. Each curve is shifted to start where the previous one ends, junction poles are averaged.
+     * Rational definitions are scaled to match the junction weights, which preserves their geometry.
+     *
+     * @tparam T
+     * @tparam dim : poles' dimension, weight included for rational definitions
+     * @param curves_info : curves' definitions, in order
+     * @param rational    : poles hold weights as last coordinate
+     * @return BSCurveInfo<T, dim>
+     */
+    template <std::floating_point T, size_t dim>
+    auto join(std::vector<BSCurveInfo<T, dim>> curves_info, bool rational) -> BSCurveInfo<T, dim>
+    {
+        if (curves_info.empty())
+            throw std::invalid_argument("join: at least one curve is required.");
+        unify_degree(curves_info);
+        auto [poles, k, p] = std::move(curves_info.front());
+        auto n_poles = std::transform_reduce(curves_info.begin(), curves_info.end(), size_t{}, std::plus<>{}, [](const auto &C) { return std::get<0>(C).size(); });
+        poles.reserve(n_poles);
+        k.reserve(n_poles + p + 1);
+        for (auto it = std::next(curves_info.begin()); it != curves_info.end(); ++it)
+        {
+            auto &[poles2, k2, p2] = *it;
+            if (rational) // same junction weight, averaging homogeneous poles then averages the points
+                scale_poles(poles2, poles.back().back() / poles2.front().back());
+            poles.back() = T(0.5) * (poles.back() + poles2.front());
+            poles.insert(poles.end(), std::next(poles2.begin()), poles2.end());
+            auto shift = k.back() - k2.front();
+            k.pop_back();
+            std::transform(std::next(k2.begin(), p + 1), k2.end(), std::back_inserter(k), [shift](T k_) { return k_ + shift; });
+        }
+        return {poles, k, p};
+    }
+    /**
+     * @brief join a sequence of curves at tail/head in a single pass, see join(std::vector<BSCurveInfo<T, dim>>, bool)
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv_lst : curves, in order
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto join(const std::vector<BSCurve<T, dim>> &crv_lst) -> BSCurve<T, dim>
+    {
+        std::vector<BSCurveInfo<T, dim>> curves_info(crv_lst.size());
+        std::transform(crv_lst.begin(), crv_lst.end(), curves_info.begin(), [](const auto &crv) { return crv.info(); });
+        return std::make_from_tuple<BSCurve<T, dim>>(join(std::move(curves_info), false));
+    }
+    /**
+     * @brief join a sequence of rational curves at tail/head in a single pass, see join(std::vector<BSCurveInfo<T, dim>>, bool)
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv_lst : curves, in order
+     * @return BSCurveRational<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto join(const std::vector<BSCurveRational<T, dim>> &crv_lst) -> BSCurveRational<T, dim>
+    {
+        std::vector<BSCurveInfo<T, dim + 1>> curves_info(crv_lst.size());
+        std::transform(crv_lst.begin(), crv_lst.end(), curves_info.begin(), [](const auto &crv) { return crv.info(); });
+        return std::make_from_tuple<BSCurveRational<T, dim>>(join(std::move(curves_info), true));
+    }
+    /**
+     * @brief Joins a sequence of curves into a single B-Spline, each curve starts where the previous one ends.
+     * BSCurve segments are joined exactly, the other ones are approximated within tol at degree p, see approx_adaptive.
+     * Degrees are unified once for the whole sequence.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param crv_lst : curves, in order
+     * @param tol     : approximation tolerance of the non BSCurve segments
+     * @param p       : approximation degree of the non BSCurve segments
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim>
+    auto flatten(const std::vector<std::shared_ptr<Curve<T, dim>>> &crv_lst, T tol, size_t p = 3) -> BSCurve<T, dim>
+    {
+        std::vector<BSCurveInfo<T, dim>> curves_info(crv_lst.size());
+        std::transform(std::execution::par, crv_lst.begin(), crv_lst.end(), curves_info.begin(), [tol, p](const auto &crv) -> BSCurveInfo<T, dim>
+        {
+            if (auto bs = dynamic_cast<const BSCurve<T, dim> *>(crv.get()))
+            {
+                auto [u1, u2] = bs->bounds();
+                const auto &k = bs->knotsFlats();
+                if (u1 == k.front() && u2 == k.back())
+                    return bs->info();
+                auto bs_trimmed = *bs;
+                bs_trimmed.trim(u1, u2);
+                return bs_trimmed.info();
+            }
+            return approx_adaptive(*crv, curve_breaks(*crv, p, 0), tol, p).info();
+        });
+        return std::make_from_tuple<BSCurve<T, dim>>(join(std::move(curves_info), false));
+    }
 
 
     template <typename T, size_t dim>
@@ -8,16 +8,124 @@
 #include <vector>
 #include <array>
 #include <any>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cassert>
 #include <type_traits>
 #include <iostream>
 namespace gbs
 {
+    /**
+     * @brief Lazily built and thread safe storage of data derived from a geometry's definition, rebuilt when the geometry's
+     * revision changes. The storage is only allocated once the cache is enabled, a disabled cache is a null pointer.
+     * Copies and assignments don't carry the content, it is rebuilt on demand.
+     * 
+     * @tparam Content 
+     */
+    template <typename Content>
+    class RevisionCache
+    {
+        struct Storage
+        {
+            std::mutex mutex;
+            std::atomic<size_t> revision{0}; // geometry's revision the content was built for, 0 if not built
+            Content content;
+        };
+        std::unique_ptr<Storage> m_storage;
+
+    public:
+        RevisionCache() = default;
+        RevisionCache(const RevisionCache &other) : m_storage{other.enabled() ? std::make_unique<Storage>() : nullptr} {}
+        RevisionCache(RevisionCache &&) noexcept = default;
+        auto operator=(const RevisionCache &other) -> RevisionCache &
+        {
+            if (this != &other)
+                m_storage = other.enabled() ? std::make_unique<Storage>() : nullptr;
+            return *this;
+        }
+        auto operator=(RevisionCache &&) noexcept -> RevisionCache & = default;
+        /**
+         * @brief Allocates the storage if needed, the content is then built on next access
+         * 
+         */
+        auto enable() -> void
+        {
+            if (m_storage)
+                reset();
+            else
+                m_storage = std::make_unique<Storage>();
+        }
+        /**
+         * @brief Releases the storage and its content
+         * 
+         */
+        auto disable() -> void { m_storage.reset(); }
+        auto enabled() const noexcept -> bool { return static_cast<bool>(m_storage); }
+        /**
+         * @brief Forces the content to be rebuilt on next access
+         * 
+         */
+        auto reset() -> void
+        {
+            if (m_storage)
+                m_storage->revision.store(0, std::memory_order_release);
+        }
+        /**
+         * @brief Content built for the given revision, build is called if the stored content is outdated.
+         * The cache has to be enabled.
+         * 
+         * @tparam Builder 
+         * @param revision : geometry's current revision
+         * @param build    : callable returning the content
+         * @return const Content& 
+         */
+        template <typename Builder>
+        auto get(size_t revision, Builder &&build) const -> const Content &
+        {
+            assert(m_storage);
+            auto &s = *m_storage;
+            if (s.revision.load(std::memory_order_acquire) != revision)
+            {
+                std::lock_guard<std::mutex> lock{s.mutex};
+                if (s.revision.load(std::memory_order_relaxed) != revision)
+                {
+                    s.content = build();
+                    s.revision.store(revision, std::memory_order_release);
+                }
+            }
+            return s.content;
+        }
+    };
+
     template <typename T, size_t dim>
     class Geom
     {
         static_assert(std::is_floating_point<T>::value, "Only real value permitted" );
+        size_t m_revision{nextRevision()};
+
+        static auto nextRevision() -> size_t
+        {
+            static std::atomic<size_t> counter{0};
+            return ++counter;
+        }
+
+    protected:
+        /**
+         * @brief To be called by derived classes each time geometry's definition changes
+         * 
+         */
+        auto markModified() -> void { m_revision = nextRevision(); }
+
         public:
         virtual ~Geom() = default;
+        /**
+         * @brief Stamp identifying geometry's definition state, it changes whenever the geometry is modified.
+         * Caches built on the geometry compare it to know if they are outdated.
+         * 
+         * @return size_t 
+         */
+        auto revision() const noexcept -> size_t { return m_revision; }
     };
     // TODO add bounded curves
     template <typename T, size_t dim>
@@ -297,7 +405,9 @@ namespace gbs
          */
         auto insertKnot(T u, size_t m = 1) //Fail safe, i.e. if fails, curve stays in previous state
         {
-            return insert_knots(u, m_deg, m, m_knotsFlats, m_poles);
+            auto ik = insert_knots(u, m_deg, m, m_knotsFlats, m_poles);
+            this->markModified();
+            return ik;
         }
         /**
          * @brief Insert knots up to the given multiplicities
@@ -323,6 +433,7 @@ namespace gbs
         auto removeKnot(T u, T tol, size_t m = 1) -> void //Fail safe, i.e. if fails, curve stays in previous state
         {
             remove_knot(u, m_deg, m, m_knotsFlats, m_poles, tol);
+            this->markModified();
         }
         /**
          * @brief Curve's poles
@@ -347,6 +458,7 @@ namespace gbs
                 throw std::length_error("BSCurveGeneral: wrong pole vector length.");
             }
             m_poles = poles;
+            this->markModified();
         }
         /**
          * @brief Move pole vector, , throw std::length_error is thrown if lengths are not the same
@@ -360,6 +472,7 @@ namespace gbs
                 throw std::length_error("BSCurveGeneral: wrong pole vector length.");
             }
             m_poles = std::move(poles);
+            this->markModified();
         }
         /**
         //  * @brief Access specific pole with bond check (can throw std::out_of_range)
@@ -376,20 +489,37 @@ namespace gbs
             return m_poles[id];
         }
         /**
-        //  * @brief Access specific pole with bond check (can throw std::out_of_range)
+         * @brief Access specific pole with bond check (can throw std::out_of_range), the curve is marked modified
+         * before the pole is, so derived data rebuilt in between a write through the reference goes stale.
          * 
          * @param id : pole index
-         * @return const std::array<T,dim + rational>& 
+         * @return std::array<T,dim + rational>& 
         **/
+        [[deprecated("use setPole, a write through the returned reference may leave cached data stale")]]
         auto pole(size_t id) -> std::array<T,dim + rational>&
         {
-            // return const_cast<std::array<T,dim + rational>&>(std::as_const(*this).pole(id));
             if(id>=m_poles.size())
             {
                 throw std::out_of_range("BSCurveGeneral::pole(size_t id) out of bounds index.");
             }
+            this->markModified(); // pole is likely to be modified
             return m_poles[id];
         }
+        /**
+         * @brief Replace specific pole with bond check (can throw std::out_of_range)
+         * 
+         * @param id : pole index
+         * @param P  : new pole
+        **/
+        auto setPole(size_t id, const std::array<T,dim + rational> &P) -> void
+        {
+            if(id>=m_poles.size())
+            {
+                throw std::out_of_range("BSCurveGeneral::setPole(size_t id, P) out of bounds index.");
+            }
+            m_poles[id] = P;
+            this->markModified();
+        }
         /**
          * @brief Replace curve's knots
          * 
@@ -402,6 +532,7 @@ namespace gbs
 
             std::copy(flatKnots.begin(),flatKnots.end(),m_knotsFlats.begin());
             m_bounds = {flatKnots.front(),flatKnots.back()};
+            this->markModified();
         }
 
         /**
@@ -419,6 +550,7 @@ namespace gbs
                            [&](const auto k_) {
                                return k1 + k2 - k_;
                            });
+            this->markModified();
         }
 
         /**
@@ -446,6 +578,7 @@ namespace gbs
             {
                 gbs::trim(m_deg, m_knotsFlats, m_poles, u1, u2);
             }
+            this->markModified();
         }
         /**
          * @brief Change parametrization to fit between k1 and k2
@@ -457,6 +590,7 @@ namespace gbs
         {
             change_bounds(k1,k2,m_knotsFlats);
             m_bounds = {k1,k2};
+            this->markModified();
         }
         /**
          * @brief Change parametrization to fit between b[0] and b[1]
@@ -467,6 +601,7 @@ namespace gbs
         {
             m_bounds = b;
             change_bounds(b[0],b[1],m_knotsFlats);
+            this->markModified();
         }
 
         virtual auto bounds() const -> std::array<T,2> override
@@ -479,6 +614,7 @@ namespace gbs
         {
             increase_degree(m_knotsFlats, m_poles, m_deg, step);
             m_deg+=step;
+            this->markModified();
         }
 
     };
@@ -487,6 +623,25 @@ namespace gbs
     class BSCurve : public BSCurveGeneral<T, dim, false>
     {
         using BSCurveGeneral<T, dim, false>::BSCurveGeneral;
+        size_t m_hodographs_order{};
+        RevisionCache<std::vector<BSCurve<T, dim>>> m_hodographs;
+
+        auto hodographs() const -> const std::vector<BSCurve<T, dim>> &
+        {
+            return m_hodographs.get(this->revision(), [this]()
+            {
+                std::vector<BSCurve<T, dim>> chain;
+                chain.reserve(m_hodographs_order);
+                const BSCurveGeneral<T, dim, false> *crv = this;
+                for (size_t d{1}; d <= m_hodographs_order; d++)
+                {
+                    auto [poles, knots] = gbs::hodograph(crv->knotsFlats(), crv->poles(), crv->degree());
+                    chain.emplace_back(poles, knots, crv->degree() > 0 ? crv->degree() - 1 : 0);
+                    crv = &chain.back();
+                }
+                return chain;
+            });
+        }
     public:
         BSCurve(const BSCurveGeneral<T, dim, false> &bsc) : BSCurveGeneral<T, dim, false>(bsc.poles(), bsc.knotsFlats(), bsc.degree()) {}
         virtual auto value(T u, size_t d = 0) const -> std::array<T, dim> override
@@ -495,8 +650,46 @@ namespace gbs
             {
                 throw OutOfBoundsCurveEval(u,this->bounds());
             }
+            if (d > 0 && d <= m_hodographs_order)
+            {
+                const auto &h = hodographs()[d - 1];
+                return eval_value_decasteljau(u, h.knotsFlats(), h.poles(), h.degree());
+            }
             return eval_value_decasteljau(u, this->knotsFlats(), this->poles(), this->degree(), d);
         }
+        /**
+         * @brief Makes the curve keep the chain of its hodographs up to the given order, they are built on first use and
+         * rebuilt after curve's modifications. Derivatives up to this order are then evaluated as order 0 values of
+         * lower degree curves, which benefits to all the derivative based algorithms using the curve.
+         * 
+         * @param max_order : highest derivative order kept, 0 disables the cache
+         */
+        auto enableHodographs(size_t max_order = 3) -> void
+        {
+            m_hodographs_order = max_order;
+            if (max_order > 0)
+                m_hodographs.enable();
+            else
+                m_hodographs.disable();
+        }
+        /**
+         * @brief Highest derivative order kept in the hodographs' cache, 0 if disabled
+         * 
+         * @return size_t 
+         */
+        auto hodographsOrder() const noexcept -> size_t { return m_hodographs_order; }
+        /**
+         * @brief Cached hodograph, i.e. exact derivative curve, of order d
+         * 
+         * @param d : derivative order, in [1, hodographsOrder()]
+         * @return const BSCurve<T, dim>& 
+         */
+        auto hodograph(size_t d) const -> const BSCurve<T, dim> &
+        {
+            if (d == 0 || d > m_hodographs_order)
+                throw std::out_of_range("BSCurve::hodograph(size_t d) derivative order not kept in cache.");
+            return hodographs()[d - 1];
+        }
 
     };
 
@@ -1,5 +1,11 @@
 #pragma once
 #include <list>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <limits>
 #include <gbs/bssurf.h>
 namespace gbs
 {
@@ -169,4 +175,329 @@ namespace gbs
         return v_lst;
     }
 
-}
\ No newline at end of file
+/**
+ * @brief Criteria driving the adaptive surface tessellation, a cell is split in four while any of them is exceeded
+ *
+ * @tparam T
+ */
+    template <typename T>
+    struct SurfaceTessellationCriteria
+    {
+        T chord_height{1e-3};                             // maximum distance between surface and cell's bilinear interpolation
+        T max_angle{std::numeric_limits<T>::infinity()};  // maximum angle, in radians, between cell's center normal and other sampled normals (3d only)
+        T max_length{std::numeric_limits<T>::infinity()}; // maximum chord length of cell's edges
+        size_t max_depth{12};                             // maximum split depth of a root cell
+    };
+
+    namespace detail
+    {
+        template <typename T, size_t dim>
+        struct SurfaceSample
+        {
+            std::array<T, 2> uv;
+            point<T, dim> pt;
+            point<T, dim> n; // not normalized, only evaluated in 3d for the angle criterion
+        };
+
+        template <typename T, size_t dim>
+        struct SurfaceCell
+        {
+            std::array<SurfaceSample<T, dim>, 4> corners; // (u1,v1) (u2,v1) (u2,v2) (u1,v2)
+            SurfaceSample<T, dim> center;
+        };
+
+        // first derivatives' cross product, rational surfaces are derived from their homogeneous surface by the quotient rule
+        template <typename T>
+        auto surface_normal(const Surface<T, 3> &srf, T u, T v) -> point<T, 3>
+        {
+            if (auto bsr = dynamic_cast<const BSSurfaceGeneral<T, 3, true> *>(&srf))
+            {
+                auto eval = [&](size_t du, size_t dv)
+                {
+                    return eval_value_decasteljau(u, v, bsr->knotsFlatsU(), bsr->knotsFlatsV(), bsr->poles(), bsr->degreeU(), bsr->degreeV(), du, dv);
+                };
+                auto A = eval(0, 0), A_u = eval(1, 0), A_v = eval(0, 1);
+                point<T, 3> S_u, S_v;
+                for (size_t d{}; d < 3; d++)
+                {
+                    S_u[d] = (A_u[d] - A_u[3] * A[d] / A[3]) / A[3];
+                    S_v[d] = (A_v[d] - A_v[3] * A[d] / A[3]) / A[3];
+                }
+                return S_u ^ S_v;
+            }
+            return srf(u, v, 1, 0) ^ srf(u, v, 0, 1);
+        }
+
+        template <typename T, size_t dim>
+        auto surface_sample(const Surface<T, dim> &srf, T u, T v, bool normal) -> SurfaceSample<T, dim>
+        {
+            SurfaceSample<T, dim> s{{u, v}, srf(u, v), {}};
+            if constexpr (dim == 3)
+                if (normal)
+                    s.n = surface_normal(srf, u, v);
+            return s;
+        }
+
+        template <typename T, size_t dim>
+        auto surface_knots(const Surface<T, dim> &srf) -> std::array<std::vector<T>, 2>
+        {
+            if (auto bs = dynamic_cast<const BSSurfaceGeneral<T, dim, false> *>(&srf))
+                return {bs->knotsU(), bs->knotsV()};
+            if (auto bsr = dynamic_cast<const BSSurfaceGeneral<T, dim, true> *>(&srf))
+                return {bsr->knotsU(), bsr->knotsV()};
+            return {};
+        }
+        // n evenly spaced parameters merged with inner knots
+        template <typename T>
+        auto surface_seeds(T u1, T u2, size_t n, const std::vector<T> &knots) -> std::vector<T>
+        {
+            auto u = make_range(u1, u2, std::max<size_t>(n, 2));
+            for (auto k : knots)
+                if (k > u1 + knot_eps<T> && k < u2 - knot_eps<T>)
+                    u.push_back(k);
+            std::sort(u.begin(), u.end());
+            u.erase(std::unique(u.begin(), u.end(), [](T a, T b) { return b - a < knot_eps<T>; }), u.end());
+            u.back() = u2;
+            return u;
+        }
+
+        template <typename T, size_t dim>
+        auto split_surface_cell(const SurfaceCell<T, dim> &cell, const std::array<SurfaceSample<T, dim>, 4> &mids, const SurfaceTessellationCriteria<T> &criteria) -> bool
+        {
+            const auto &c = cell.corners;
+            const auto &m = cell.center;
+            auto dev = distance(m.pt, T(0.25) * (c[0].pt + c[1].pt + c[2].pt + c[3].pt));
+            for (size_t i{}; i < 4; i++)
+            {
+                const auto &a = c[i].pt;
+                const auto &b = c[(i + 1) % 4].pt;
+                dev = std::max(dev, distance(mids[i].pt, T(0.5) * (a + b)));
+                if (distance(a, b) > criteria.max_length)
+                    return true;
+            }
+            if (dev > criteria.chord_height)
+                return true;
+            if constexpr (dim == 3)
+            {
+                if (criteria.max_angle < std::numeric_limits<T>::infinity() && sq_norm(m.n) > T(0))
+                {
+                    auto angle = [&m](const auto &s) { return std::atan2(norm(m.n ^ s.n), m.n * s.n); };
+                    for (size_t i{}; i < 4; i++)
+                    {
+                        // degenerated normals, at poles for instance, are ignored
+                        if (sq_norm(c[i].n) > T(0) && angle(c[i]) > criteria.max_angle)
+                            return true;
+                        if (sq_norm(mids[i].n) > T(0) && angle(mids[i]) > criteria.max_angle)
+                            return true;
+                    }
+                }
+            }
+            return false;
+        }
+        // quadtree refinement of a root cell, each split reuses the checks' samples as children's corners
+        template <typename T, size_t dim>
+        auto refine_surface_cell(const Surface<T, dim> &srf, const SurfaceCell<T, dim> &root, const SurfaceTessellationCriteria<T> &criteria) -> std::vector<SurfaceCell<T, dim>>
+        {
+            // normals only feed the angle criterion
+            bool normal = criteria.max_angle < std::numeric_limits<T>::infinity();
+            std::vector<SurfaceCell<T, dim>> leaves;
+            std::vector<std::pair<SurfaceCell<T, dim>, size_t>> stack{{root, 0}};
+            while (!stack.empty())
+            {
+                auto [cell, depth] = stack.back();
+                stack.pop_back();
+                const auto &c = cell.corners;
+                const auto &m = cell.center;
+                auto [u1, v1] = c[0].uv;
+                auto [u2, v2] = c[2].uv;
+                auto [um, vm] = m.uv;
+                std::array<SurfaceSample<T, dim>, 4> mids{
+                    surface_sample(srf, um, v1, normal),
+                    surface_sample(srf, u2, vm, normal),
+                    surface_sample(srf, um, v2, normal),
+                    surface_sample(srf, u1, vm, normal)};
+                if (depth >= criteria.max_depth || !split_surface_cell(cell, mids, criteria))
+                {
+                    leaves.push_back(cell);
+                    continue;
+                }
+                auto child = [&srf, normal](const SurfaceSample<T, dim> &a, const SurfaceSample<T, dim> &b, const SurfaceSample<T, dim> &c_, const SurfaceSample<T, dim> &d)
+                {
+                    return SurfaceCell<T, dim>{{a, b, c_, d}, surface_sample(srf, T(0.5) * (a.uv[0] + c_.uv[0]), T(0.5) * (a.uv[1] + c_.uv[1]), normal)};
+                };
+                stack.push_back({child(c[0], mids[0], m, mids[3]), depth + 1});
+                stack.push_back({child(mids[0], c[1], mids[1], m), depth + 1});
+                stack.push_back({child(m, mids[1], c[2], mids[2]), depth + 1});
+                stack.push_back({child(mids[3], m, mids[2], c[3]), depth + 1});
+            }
+            return leaves;
+        }
+    }
+/**
+ * @brief Adaptive tessellation of a surface's parametric rectangle into an indexed triangle mesh.
+ * The root grid is made of n_u x n_v evenly spaced lines merged with the knot lines of B-Spline surfaces.
+ * Root cells are refined in parallel as quadtrees using chord height, edge length and normal deviation criteria.
+ * Cells sharing an edge may be refined to different depths: each leaf is bounded by all the vertices lying on
+ * its edges, including the neighbours' ones, and is fanned around its center when it has such hanging vertices.
+ * Hence triangles sharing an edge share its vertices and the mesh is free of cracks.
+ *
+ * @tparam T
+ * @tparam dim
+ * @param srf      : the surface
+ * @param u1       : rectangle's start in u
+ * @param u2       : rectangle's end in u
+ * @param v1       : rectangle's start in v
+ * @param v2       : rectangle's end in v
+ * @param criteria : refinement criteria
+ * @param n_u      : minimal number of root grid lines in u
+ * @param n_v      : minimal number of root grid lines in v
+ * @return SurfaceTessellation<T, dim>
+ */
+    template <typename T, size_t dim>
+    auto tessellate(const Surface<T, dim> &srf, T u1, T u2, T v1, T v2, const SurfaceTessellationCriteria<T> &criteria, size_t n_u = 2, size_t n_v = 2) -> SurfaceTessellation<T, dim>
+    {
+        auto [knots_u, knots_v] = detail::surface_knots(srf);
+        auto u = detail::surface_seeds(u1, u2, n_u, knots_u);
+        auto v = detail::surface_seeds(v1, v2, n_v, knots_v);
+        auto nu = u.size(), nv = v.size();
+
+        std::vector<size_t> ids(nu * nv);
+        std::iota(ids.begin(), ids.end(), 0);
+        bool normal = criteria.max_angle < std::numeric_limits<T>::infinity();
+        std::vector<detail::SurfaceSample<T, dim>> grid(nu * nv);
+        std::transform(std::execution::par, ids.begin(), ids.end(), grid.begin(),
+                       [&](size_t k) { return detail::surface_sample(srf, u[k % nu], v[k / nu], normal); });
+
+        auto n_roots = (nu - 1) * (nv - 1);
+        ids.resize(n_roots);
+        std::vector<std::vector<detail::SurfaceCell<T, dim>>> root_leaves(n_roots);
+        std::transform(std::execution::par, ids.begin(), ids.end(), root_leaves.begin(),
+                       [&](size_t k)
+                       {
+                           auto i = k % (nu - 1), j = k / (nu - 1);
+                           detail::SurfaceCell<T, dim> root{
+                               {grid[i + nu * j], grid[i + 1 + nu * j], grid[i + 1 + nu * (j + 1)], grid[i + nu * (j + 1)]},
+                               detail::surface_sample(srf, T(0.5) * (u[i] + u[i + 1]), T(0.5) * (v[j] + v[j + 1]), normal)};
+                           return detail::refine_surface_cell(srf, root, criteria);
+                       });
+        std::vector<detail::SurfaceCell<T, dim>> leaves;
+        for (auto &l : root_leaves)
+            leaves.insert(leaves.end(), std::make_move_iterator(l.begin()), std::make_move_iterator(l.end()));
+
+        // vertices, children's parameters are computed the same way on both sides of an edge, hence compare exactly
+        std::vector<const detail::SurfaceSample<T, dim> *> vertices;
+        vertices.reserve(4 * leaves.size());
+        for (const auto &l : leaves)
+            for (const auto &c : l.corners)
+                vertices.push_back(&c);
+        auto uv_less = [](const auto *a, const auto *b) { return a->uv < b->uv; };
+        std::sort(std::execution::par, vertices.begin(), vertices.end(), uv_less);
+        vertices.erase(std::unique(vertices.begin(), vertices.end(), [](const auto *a, const auto *b) { return a->uv == b->uv; }), vertices.end());
+        auto n_vertices = vertices.size();
+
+        // vertices' indices sorted along iso u lines (u,v) and along iso v lines (v,u)
+        std::vector<size_t> by_u(n_vertices), by_v(n_vertices);
+        std::iota(by_u.begin(), by_u.end(), 0);
+        std::iota(by_v.begin(), by_v.end(), 0);
+        auto vu = [&vertices](size_t k) { return std::array<T, 2>{vertices[k]->uv[1], vertices[k]->uv[0]}; };
+        std::sort(std::execution::par, by_v.begin(), by_v.end(), [&vu](size_t a, size_t b) { return vu(a) < vu(b); });
+        // vertices on the iso line (first fixed) between second1 (included) and second2 (excluded), sorted from second1 to second2
+        auto on_line = [](const std::vector<size_t> &idx, const auto &key, T fixed, T second1, T second2, std::vector<size_t> &poly)
+        {
+            auto cmp = [&key](size_t k, const std::array<T, 2> &x) { return key(k) < x; };
+            auto cmp_r = [&key](const std::array<T, 2> &x, size_t k) { return x < key(k); };
+            if (second1 < second2)
+            {
+                auto it1 = std::lower_bound(idx.begin(), idx.end(), std::array<T, 2>{fixed, second1}, cmp);
+                auto it2 = std::lower_bound(it1, idx.end(), std::array<T, 2>{fixed, second2}, cmp);
+                poly.insert(poly.end(), it1, it2);
+            }
+            else
+            {
+                auto it1 = std::upper_bound(idx.begin(), idx.end(), std::array<T, 2>{fixed, second2}, cmp_r);
+                auto it2 = std::upper_bound(it1, idx.end(), std::array<T, 2>{fixed, second1}, cmp_r);
+                poly.insert(poly.end(), std::make_reverse_iterator(it2), std::make_reverse_iterator(it1));
+            }
+        };
+        auto uv_key = [&vertices](size_t k) { return vertices[k]->uv; };
+
+        // leaves' boundaries, counterclockwise from (u1,v1)
+        std::vector<std::vector<size_t>> polygons(leaves.size());
+        std::transform(std::execution::par, leaves.begin(), leaves.end(), polygons.begin(),
+                       [&](const detail::SurfaceCell<T, dim> &l)
+                       {
+                           auto [ua, va] = l.corners[0].uv;
+                           auto [ub, vb] = l.corners[2].uv;
+                           std::vector<size_t> poly;
+                           on_line(by_v, vu, va, ua, ub, poly);
+                           on_line(by_u, uv_key, ub, va, vb, poly);
+                           on_line(by_v, vu, vb, ub, ua, poly);
+                           on_line(by_u, uv_key, ua, vb, va, poly);
+                           return poly;
+                       });
+
+        // plain quads give 2 triangles, leaves with hanging vertices get a center vertex and a fan
+        std::vector<size_t> n_centers(leaves.size()), n_triangles(leaves.size());
+        std::transform(polygons.begin(), polygons.end(), n_centers.begin(), [](const auto &p) { return p.size() > 4 ? 1 : 0; });
+        std::transform(polygons.begin(), polygons.end(), n_triangles.begin(), [](const auto &p) { return p.size() > 4 ? p.size() : 2; });
+        auto n_total = std::reduce(n_centers.begin(), n_centers.end(), n_vertices);
+        auto n_tri_total = std::reduce(n_triangles.begin(), n_triangles.end(), size_t{});
+        std::exclusive_scan(n_centers.begin(), n_centers.end(), n_centers.begin(), n_vertices);
+        std::exclusive_scan(n_triangles.begin(), n_triangles.end(), n_triangles.begin(), size_t{});
+
+        SurfaceTessellation<T, dim> mesh;
+        mesh.points.resize(n_total);
+        mesh.uv.resize(n_total);
+        mesh.triangles.resize(n_tri_total);
+        for (size_t k{}; k < n_vertices; k++)
+        {
+            mesh.points[k] = vertices[k]->pt;
+            mesh.uv[k] = vertices[k]->uv;
+        }
+        ids.resize(leaves.size());
+        std::iota(ids.begin(), ids.end(), 0);
+        std::for_each(std::execution::par, ids.begin(), ids.end(),
+                      [&](size_t k)
+                      {
+                          const auto &poly = polygons[k];
+                          auto tri = std::next(mesh.triangles.begin(), n_triangles[k]);
+                          if (poly.size() > 4)
+                          {
+                              auto ic = n_centers[k];
+                              mesh.points[ic] = leaves[k].center.pt;
+                              mesh.uv[ic] = leaves[k].center.uv;
+                              for (size_t i{}; i < poly.size(); i++)
+                                  *tri++ = {poly[i], poly[(i + 1) % poly.size()], ic};
+                          }
+                          else if (distance(mesh.points[poly[0]], mesh.points[poly[2]]) <= distance(mesh.points[poly[1]], mesh.points[poly[3]]))
+                          {
+                              *tri++ = {poly[0], poly[1], poly[2]};
+                              *tri = {poly[0], poly[2], poly[3]};
+                          }
+                          else
+                          {
+                              *tri++ = {poly[0], poly[1], poly[3]};
+                              *tri = {poly[1], poly[2], poly[3]};
+                          }
+                      });
+        return mesh;
+    }
+/**
+ * @brief Adaptive tessellation of a whole surface into an indexed triangle mesh, see tessellate(srf, u1, u2, v1, v2, criteria, n_u, n_v)
+ *
+ * @tparam T
+ * @tparam dim
+ * @param srf      : the surface
+ * @param criteria : refinement criteria
+ * @param n_u      : minimal number of root grid lines in u
+ * @param n_v      : minimal number of root grid lines in v
+ * @return SurfaceTessellation<T, dim>
+ */
+    template <typename T, size_t dim>
+    auto tessellate(const Surface<T, dim> &srf, const SurfaceTessellationCriteria<T> &criteria = {}, size_t n_u = 2, size_t n_v = 2) -> SurfaceTessellation<T, dim>
+    {
+        auto [u1, u2, v1, v2] = srf.bounds();
+        return tessellate(srf, u1, u2, v1, v2, criteria, n_u, n_v);
+    }
+
+}
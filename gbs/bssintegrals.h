@@ -0,0 +1,288 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <numeric>
+#include <execution>
+#include <boost/math/quadrature/gauss.hpp>
+
+#include <gbs/bssurf.h>
+
+namespace gbs
+{
+    /**
+     * @brief Integral properties of a surface. Moments are taken about the origin.
+     * Volume terms are computed by the divergence theorem from the surface's normal Su^Sv, they are the properties of the
+     * enclosed solid for a closed surface oriented outward, of the cone spanned from the origin otherwise.
+     * Properties of a closed set of surfaces are obtained by summing those of the faces.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    struct SurfaceIntegrals
+    {
+        T area{};
+        point<T, 3> area_moment{};                          // integral of x dA
+        std::array<point<T, 3>, 3> area_second_moments{};   // integral of x_i x_j dA
+        T volume{};
+        point<T, 3> volume_moment{};                        // integral of x dV
+        std::array<point<T, 3>, 3> volume_second_moments{}; // integral of x_i x_j dV
+
+        auto operator+=(const SurfaceIntegrals<T> &other) -> SurfaceIntegrals<T> &
+        {
+            area += other.area;
+            volume += other.volume;
+            for (size_t i{}; i < 3; i++)
+            {
+                area_moment[i] += other.area_moment[i];
+                volume_moment[i] += other.volume_moment[i];
+                for (size_t j{}; j < 3; j++)
+                {
+                    area_second_moments[i][j] += other.area_second_moments[i][j];
+                    volume_second_moments[i][j] += other.volume_second_moments[i][j];
+                }
+            }
+            return *this;
+        }
+
+        friend auto operator+(SurfaceIntegrals<T> a, const SurfaceIntegrals<T> &b) -> SurfaceIntegrals<T>
+        {
+            return a += b;
+        }
+    };
+    /**
+     * @brief Gauss-Legendre rule mapped on [0,1]
+     *
+     * @tparam T
+     * @tparam N : points' number
+     * @return std::array<std::array<T, 2>, N> sorted {abscissa, weight}
+     */
+    template <typename T, size_t N>
+    auto gauss_legendre_rule() -> std::array<std::array<T, 2>, N>
+    {
+        using boost::math::quadrature::gauss;
+        // boost stores the non negative half of the symmetric rule
+        const auto &x = gauss<T, N>::abscissa();
+        const auto &w = gauss<T, N>::weights();
+        std::array<std::array<T, 2>, N> rule;
+        size_t k{};
+        for (auto i = x.size(); i-- > N % 2;)
+            rule[k++] = {T(0.5) * (1 - x[i]), T(0.5) * w[i]};
+        for (size_t i{}; i < x.size(); i++)
+            rule[k++] = {T(0.5) * (1 + x[i]), T(0.5) * w[i]};
+        return rule;
+    }
+
+    namespace detail
+    {
+        // point and first derivatives from the non vanishing basis functions of span (i,j), projected if rational
+        template <typename T, size_t dim, bool rational>
+        auto eval_d1_span(const points_vector<T, dim + rational> &poles, size_t nu, size_t i, size_t j, size_t p, size_t q,
+                          const std::vector<T> &Nu, const std::vector<T> &dNu, const std::vector<T> &Nv, const std::vector<T> &dNv) -> std::array<point<T, dim>, 3>
+        {
+            std::array<point<T, dim + rational>, 3> d{};
+            for (size_t b{}; b <= q; b++)
+            {
+                for (size_t a{}; a <= p; a++)
+                {
+                    const auto &P = poles[i - p + a + nu * (j - q + b)];
+                    auto N00 = Nu[a] * Nv[b];
+                    auto N10 = dNu[a] * Nv[b];
+                    auto N01 = Nu[a] * dNv[b];
+                    for (size_t c{}; c < dim + rational; c++)
+                    {
+                        d[0][c] += N00 * P[c];
+                        d[1][c] += N10 * P[c];
+                        d[2][c] += N01 * P[c];
+                    }
+                }
+            }
+            if constexpr (rational)
+            {
+                // S = A / w, dS = (dA - dw S) / w
+                std::array<point<T, dim>, 3> r;
+                auto w = d[0][dim];
+                for (size_t c{}; c < dim; c++)
+                    r[0][c] = d[0][c] / w;
+                for (size_t k : {1, 2})
+                    for (size_t c{}; c < dim; c++)
+                        r[k][c] = (d[k][c] - d[k][dim] * r[0][c]) / w;
+                return r;
+            }
+            else
+                return d;
+        }
+    }
+    /**
+     * @brief Surface's point and first derivatives at {u,v}, basis functions and their derivatives are evaluated in a single pass.
+     * Unlike value(u, v, du, dv), rational surfaces are supported.
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam rational
+     * @param srf
+     * @param u
+     * @param v
+     * @return std::array<point<T, dim>, 3> {S, dS/du, dS/dv}
+     */
+    template <typename T, size_t dim, bool rational>
+    auto eval_d1(const BSSurfaceGeneral<T, dim, rational> &srf, T u, T v) -> std::array<point<T, dim>, 3>
+    {
+        const auto &ku = srf.knotsFlatsU();
+        const auto &kv = srf.knotsFlatsV();
+        auto p = srf.degreeU(), q = srf.degreeV();
+        auto nu = srf.nPolesU();
+        auto i = std::min<size_t>(find_span(nu, p, u, ku) - ku.begin(), ku.size() - p - 2);
+        auto j = std::min<size_t>(find_span(srf.nPolesV(), q, v, kv) - kv.begin(), kv.size() - q - 2);
+        std::vector<T> Nu, dNu, Nv, dNv;
+        basis_funcs_d1(i, p, u, ku, Nu, dNu);
+        basis_funcs_d1(j, q, v, kv, Nv, dNv);
+        return detail::eval_d1_span<T, dim, rational>(srf.poles(), nu, i, j, p, q, Nu, dNu, Nv, dNv);
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        auto accumulate_integrals(SurfaceIntegrals<T> &res, const point<T, 3> &x, const point<T, 3> &n, T w) -> void
+        {
+            auto dA = norm(n) * w;
+            res.area += dA;
+            res.volume += (x * n) * w / 3;
+            for (size_t i{}; i < 3; i++)
+            {
+                res.area_moment[i] += x[i] * dA;
+                res.volume_moment[i] += T(0.5) * x[i] * x[i] * n[i] * w;
+                for (size_t j{}; j < 3; j++)
+                {
+                    res.area_second_moments[i][j] += x[i] * x[j] * dA;
+                    // div(x_i^3/3 e_i) = x_i^2 and div(x_i^2 x_j/2 e_i) = x_i x_j
+                    res.volume_second_moments[i][j] += (i == j ? x[i] * x[i] * x[i] / 3 : T(0.5) * x[i] * x[i] * x[j]) * n[i] * w;
+                }
+            }
+        }
+
+        template <typename T>
+        auto integration_spans(const std::vector<T> &knots, size_t n_sub) -> std::vector<T>
+        {
+            std::vector<T> u{knots.front()};
+            for (size_t i{1}; i < knots.size(); i++)
+                for (size_t k{1}; k <= n_sub; k++)
+                    u.push_back(k == n_sub ? knots[i] : knots[i - 1] + (knots[i] - knots[i - 1]) * k / n_sub);
+            return u;
+        }
+    }
+    /**
+     * @brief Surface's area, volume and their first and second moments, see SurfaceIntegrals.
+     * Each knot span cell, optionally subdivided, is integrated with a tensor product Gauss-Legendre rule, which is exact
+     * for the volume terms of polynomial surfaces when N is large enough. Cells are integrated in parallel and summed in
+     * a fixed order, hence the result doesn't depend on threads' scheduling.
+     *
+     * @tparam T
+     * @tparam rational
+     * @tparam N    : Gauss-Legendre points' number per direction and cell
+     * @param srf
+     * @param n_sub : subdivisions of each knot span, for accuracy on area terms
+     * @return SurfaceIntegrals<T>
+     */
+    template <typename T, bool rational, size_t N = 10>
+    auto surface_integrals(const BSSurfaceGeneral<T, 3, rational> &srf, size_t n_sub = 1) -> SurfaceIntegrals<T>
+    {
+        if (n_sub == 0)
+            throw std::invalid_argument("surface_integrals: at least one subdivision per span is required.");
+        const auto rule = gauss_legendre_rule<T, N>();
+        auto u = detail::integration_spans(srf.knotsU(), n_sub);
+        auto v = detail::integration_spans(srf.knotsV(), n_sub);
+        const auto &ku = srf.knotsFlatsU();
+        const auto &kv = srf.knotsFlatsV();
+        auto p = srf.degreeU(), q = srf.degreeV();
+        auto nu = srf.nPolesU(), nv = srf.nPolesV();
+        const auto &poles = srf.poles();
+
+        auto n_cells_u = u.size() - 1;
+        std::vector<size_t> ids(n_cells_u * (v.size() - 1));
+        std::iota(ids.begin(), ids.end(), 0);
+        std::vector<SurfaceIntegrals<T>> cells(ids.size());
+        std::transform(
+            std::execution::par,
+            ids.begin(), ids.end(),
+            cells.begin(),
+            [&](size_t id)
+            {
+                auto u1 = u[id % n_cells_u], u2 = u[id % n_cells_u + 1];
+                auto v1 = v[id / n_cells_u], v2 = v[id / n_cells_u + 1];
+                // span indices from cell's center, nodes are strictly inside
+                auto i = std::min<size_t>(find_span(nu, p, T(0.5) * (u1 + u2), ku) - ku.begin(), ku.size() - p - 2);
+                auto j = std::min<size_t>(find_span(nv, q, T(0.5) * (v1 + v2), kv) - kv.begin(), kv.size() - q - 2);
+                std::array<std::vector<T>, N> Nu, dNu, Nv, dNv;
+                for (size_t a{}; a < N; a++)
+                {
+                    basis_funcs_d1(i, p, u1 + rule[a][0] * (u2 - u1), ku, Nu[a], dNu[a]);
+                    basis_funcs_d1(j, q, v1 + rule[a][0] * (v2 - v1), kv, Nv[a], dNv[a]);
+                }
+                SurfaceIntegrals<T> res;
+                for (size_t b{}; b < N; b++)
+                {
+                    for (size_t a{}; a < N; a++)
+                    {
+                        auto [x, xu, xv] = detail::eval_d1_span<T, 3, rational>(poles, nu, i, j, p, q, Nu[a], dNu[a], Nv[b], dNv[b]);
+                        detail::accumulate_integrals(res, x, xu ^ xv, rule[a][1] * rule[b][1] * (u2 - u1) * (v2 - v1));
+                    }
+                }
+                return res;
+            });
+        return std::accumulate(cells.begin(), cells.end(), SurfaceIntegrals<T>{});
+    }
+    /**
+     * @brief Batched surfaces' integrals, surfaces are processed in parallel, see surface_integrals
+     *
+     * @tparam T
+     * @tparam N         : Gauss-Legendre points' number per direction and cell
+     * @tparam ForwardIt
+     * @param first : surfaces, or surfaces' pointers, range start
+     * @param last  : surfaces, or surfaces' pointers, range end
+     * @param n_sub : subdivisions of each knot span
+     * @return std::vector<SurfaceIntegrals<T>>
+     */
+    template <typename T, size_t N = 10, typename ForwardIt>
+    auto surfaces_integrals(ForwardIt first, ForwardIt last, size_t n_sub = 1) -> std::vector<SurfaceIntegrals<T>>
+    {
+        std::vector<SurfaceIntegrals<T>> res(std::distance(first, last));
+        std::transform(
+            std::execution::par,
+            first, last,
+            res.begin(),
+            [n_sub](const auto &s)
+            {
+                auto integrals = [n_sub]<bool rational>(const BSSurfaceGeneral<T, 3, rational> &srf) { return surface_integrals<T, rational, N>(srf, n_sub); };
+                if constexpr (requires { s->bounds(); })
+                    return integrals(*s);
+                else
+                    return integrals(s);
+            });
+        return res;
+    }
+    /**
+     * @brief Inertia tensor from second moments, either about the origin or about the centroid
+     *
+     * @tparam T
+     * @param second_moments : integral of x_i x_j
+     * @param moment         : integral of x
+     * @param mass           : area or volume
+     * @param centered       : moves the tensor to the centroid
+     * @return std::array<point<T, 3>, 3>
+     */
+    template <typename T>
+    auto inertia_tensor(const std::array<point<T, 3>, 3> &second_moments, const point<T, 3> &moment, T mass, bool centered = true) -> std::array<point<T, 3>, 3>
+    {
+        auto M = second_moments;
+        if (centered)
+            for (size_t i{}; i < 3; i++)
+                for (size_t j{}; j < 3; j++)
+                    M[i][j] -= moment[i] * moment[j] / mass;
+        auto tr = M[0][0] + M[1][1] + M[2][2];
+        std::array<point<T, 3>, 3> I;
+        for (size_t i{}; i < 3; i++)
+            for (size_t j{}; j < 3; j++)
+                I[i][j] = (i == j ? tr : T(0)) - M[i][j];
+        return I;
+    }
+}
@@ -463,6 +463,7 @@ namespace gbs
 
             m_knotsFlatsU = std::move(knots_flatsU_);
             m_poles = std::move(poles_);
+            this->markModified();
             return ik;
         }
 
@@ -498,6 +499,7 @@ namespace gbs
 
             m_knotsFlatsV = std::move(knots_flatsV_);
             m_poles = std::move(poles_);
+            this->markModified();
             return ik;
         }
 
@@ -512,13 +514,15 @@ namespace gbs
         }
 
         /**
-         * @brief Accesses a specific control point on the surface by its indices.
+         * @brief Accesses a specific control point on the surface by its indices, the surface is marked modified
+         * before the pole is, so derived data rebuilt in between a write through the reference goes stale.
          * 
          * @param i The index in the U direction.
          * @param j The index in the V direction.
          * @return point<T, dim + rational>& A reference to the specified control point.
          * @throws std::out_of_range If the indices are out of bounds.
          */
+        [[deprecated("use setPole, a write through the returned reference may leave cached data stale")]]
         auto pole(size_t i, size_t j) -> point<T, dim + rational> &
         {
             auto n = nPolesU();
@@ -527,11 +531,32 @@ namespace gbs
             {
                 throw std::out_of_range("BSSurfaceGeneral::pole(size_t i, size_t j) out of bounds index.");
             }
+            this->markModified(); // pole is likely to be modified
             return m_poles[id];
         }
 
         /**
-         * @brief Const overload of the pole access method.
+         * @brief Replaces a specific control point on the surface by its indices.
+         * 
+         * @param i The index in the U direction.
+         * @param j The index in the V direction.
+         * @param P The new control point.
+         * @throws std::out_of_range If the indices are out of bounds.
+         */
+        auto setPole(size_t i, size_t j, const point<T, dim + rational> &P) -> void
+        {
+            auto n = nPolesU();
+            auto id = j + i * n;
+            if(id>=m_poles.size())
+            {
+                throw std::out_of_range("BSSurfaceGeneral::setPole(size_t i, size_t j, P) out of bounds index.");
+            }
+            m_poles[id] = P;
+            this->markModified();
+        }
+
+        /**
+         * @brief Accesses a specific control point on the surface by its indices.
          * 
          * @param i The index in the U direction.
          * @param j The index in the V direction.
@@ -638,6 +663,7 @@ namespace gbs
                 throw std::length_error("BSSurfaceGeneral: wrong pole vector length.");
             }
             m_poles = poles;
+            this->markModified();
         }
         /**
          * @brief Move pole vector, , throw std::length_error is thrown if lengths are not the same
@@ -651,6 +677,7 @@ namespace gbs
                 throw std::length_error("BSSurfaceGeneral: wrong pole vector length.");
             }
             m_poles = std::move(poles);
+            this->markModified();
         }
 
         /**
@@ -676,6 +703,7 @@ namespace gbs
             change_bounds(k1, k2, m_knotsFlatsU);
             m_bounds[0] = k1;
             m_bounds[1] = k2;
+            this->markModified();
         }
 
         /**
@@ -691,6 +719,7 @@ namespace gbs
             change_bounds(k1, k2, m_knotsFlatsV);
             m_bounds[2] = k1;
             m_bounds[3] = k2;
+            this->markModified();
         }
 
         /**
@@ -723,6 +752,7 @@ namespace gbs
             m_poles = std::move(poles_new);
             m_knotsFlatsU = std::move(ku_new);
             m_degU++;
+            this->markModified();
         }
 
         /**
@@ -748,6 +778,7 @@ namespace gbs
             std::swap(m_knotsFlatsU,m_knotsFlatsV);
             std::swap(m_degU,m_degV);
             m_bounds = {m_knotsFlatsU.front(), m_knotsFlatsU.back(), m_knotsFlatsV.front(), m_knotsFlatsV.back()};
+            this->markModified();
         }
 
         /**
@@ -771,6 +802,7 @@ namespace gbs
             {
                 std::reverse(std::next(m_poles.begin(), i * nu), std::next(m_poles.begin(), i * nu + nu));
             }
+            this->markModified();
         }
 
         /**
@@ -818,6 +850,7 @@ namespace gbs
 
             m_bounds[0] = u1; 
             m_bounds[1] = u2;
+            this->markModified();
         }
 
         /**
@@ -883,6 +916,17 @@ namespace gbs
     template <typename T, size_t dim>
     class BSSurface : public BSSurfaceGeneral<T, dim, false>
     {
+        RevisionCache<std::vector<BSSurface<T, dim>>> m_hodographs; // d/du, d/dv, d2/dudv
+
+        auto hodographs() const -> const std::vector<BSSurface<T, dim>> &
+        {
+            return m_hodographs.get(this->revision(), [this]()
+            {
+                std::vector<BSSurface<T, dim>> patches{hodograph_u(*this), hodograph_v(*this)};
+                patches.push_back(hodograph_v(patches.front()));
+                return patches;
+            });
+        }
     public:
         using BSSurfaceGeneral<T, dim, false>::BSSurfaceGeneral;
         BSSurface(const BSSurfaceGeneral<T, dim, false> &s)  : BSSurfaceGeneral<T, dim, false>{s} {}
@@ -893,10 +937,87 @@ namespace gbs
             if (v < this->bounds()[2] - knot_eps<T> || v > this->bounds()[3] + knot_eps<T>)
                 throw OutOfBoundsSurfaceVEval<T>(v,this->boundsV());
 
+            if (m_hodographs.enabled() && du <= 1 && dv <= 1 && du + dv > 0)
+            {
+                const auto &h = hodographs()[du + 2 * dv - 1];
+                return eval_value_decasteljau(u, v, h.knotsFlatsU(), h.knotsFlatsV(), h.poles(), h.degreeU(), h.degreeV());
+            }
             return eval_value_decasteljau(u, v, this->knotsFlatsU(), this->knotsFlatsV(), this->poles(), this->degreeU(), this->degreeV(), du, dv);
         }
+        /**
+         * @brief Makes the surface keep its first derivative patches d/du, d/dv and d2/dudv, they are built on first use
+         * and rebuilt after surface's modifications. These derivatives are then evaluated as order 0 values of lower degree surfaces.
+         * 
+         * @param enable 
+         */
+        auto enableHodographs(bool enable = true) -> void
+        {
+            if (enable)
+                m_hodographs.enable();
+            else
+                m_hodographs.disable();
+        }
+        /**
+         * @brief Tells if derivative patches are kept
+         * 
+         * @return bool
+         */
+        auto hodographsEnabled() const noexcept -> bool { return m_hodographs.enabled(); }
+        /**
+         * @brief Cached derivative patch
+         * 
+         * @param du : u derivative order, 0 or 1
+         * @param dv : v derivative order, 0 or 1
+         * @return const BSSurface<T, dim>& 
+         */
+        auto hodograph(size_t du, size_t dv) const -> const BSSurface<T, dim> &
+        {
+            if (!m_hodographs.enabled() || du > 1 || dv > 1 || du + dv == 0)
+                throw std::out_of_range("BSSurface::hodograph(size_t du, size_t dv) derivative not kept in cache.");
+            return hodographs()[du + 2 * dv - 1];
+        }
     };
 
+    /**
+     * @brief Exact u derivative patch of a non rational surface, see hodograph
+     * 
+     * @tparam T 
+     * @tparam dim 
+     * @param srf 
+     * @return BSSurface<T, dim> 
+     */
+    template <typename T, size_t dim>
+    auto hodograph_u(const BSSurfaceGeneral<T, dim, false> &srf) -> BSSurface<T, dim>
+    {
+        points_vector<T, dim> poles;
+        std::vector<T> knots;
+        for (size_t j{}; j < srf.nPolesV(); j++)
+        {
+            auto [poles_j, knots_j] = hodograph(srf.knotsFlatsU(), srf.polesU(j), srf.degreeU());
+            poles.insert(poles.end(), poles_j.begin(), poles_j.end());
+            knots = std::move(knots_j);
+        }
+        auto p = srf.degreeU();
+        return BSSurface<T, dim>{poles, knots, srf.knotsFlatsV(), p > 0 ? p - 1 : 0, srf.degreeV()};
+    }
+    /**
+     * @brief Exact v derivative patch of a non rational surface, see hodograph
+     * 
+     * @tparam T 
+     * @tparam dim 
+     * @param srf 
+     * @return BSSurface<T, dim> 
+     */
+    template <typename T, size_t dim>
+    auto hodograph_v(const BSSurfaceGeneral<T, dim, false> &srf) -> BSSurface<T, dim>
+    {
+        BSSurface<T, dim> srf_t{srf};
+        srf_t.invertUV();
+        auto d = hodograph_u(srf_t);
+        d.invertUV();
+        return d;
+    }
+
     template <typename T, size_t dim>
     class BSSurfaceRational : public BSSurfaceGeneral<T, dim, true>
     {
@@ -953,6 +1074,20 @@ namespace gbs
         }
     };
 
+    /**
+     * @brief Indexed triangle mesh of a surface, vertices are shared between triangles
+     *
+     * @tparam T
+     * @tparam dim
+     */
+    template <typename T, size_t dim>
+    struct SurfaceTessellation
+    {
+        points_vector<T, dim> points;                 // vertices' positions
+        std::vector<std::array<T, 2>> uv;             // vertices' parameters
+        std::vector<std::array<size_t, 3>> triangles; // counterclockwise in the parametric plane
+    };
+
     template <typename T>
     class BSSfunction
     {
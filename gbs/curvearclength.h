@@ -0,0 +1,129 @@
+#pragma once
+#include <gbs/arclength.h>
+
+namespace gbs
+{
+    /**
+     * @brief Curve parametrized by its arc length, from 0 to the length between basis curve's bounds.
+     * The law from arc length to basis curve's parameter is the ArcLengthTable's Hermite interpolation, built once at construction.
+     * Derivatives are computed in closed form from basis curve's ones, with du/ds = 1 / |C'(u)|, hence the first derivative is the unit tangent.
+     *
+     * @tparam T
+     * @tparam dim
+     */
+    template <typename T, size_t dim>
+    class CurveArcLength : public Curve<T, dim>
+    {
+        const std::shared_ptr<Curve<T, dim>> m_p_crv;
+        ArcLengthTable<T, dim> m_table;
+        T m_s1;
+        T m_length;
+        std::array<T, 2> m_u_bounds;
+
+    public:
+        using Curve<T, dim>::values;
+        /**
+         * @brief Arc length parametrization of the basis curve between parameters u1 and u2
+         *
+         * @param crv : basis curve
+         * @param u1
+         * @param u2
+         * @param tol : law's tolerance relative to curve's length, bounded by type's precision
+         */
+        CurveArcLength(const std::shared_ptr<Curve<T, dim>> &crv, T u1, T u2, T tol = 1e-8) : m_p_crv{crv},
+                                                                                                m_table{*crv, std::max(tol, T(64) * std::numeric_limits<T>::epsilon())},
+                                                                                                m_s1{m_table.length(u1)},
+                                                                                                m_length{m_table.length(u2) - m_s1},
+                                                                                                m_u_bounds{u1, u2}
+        {
+        }
+        CurveArcLength(const std::shared_ptr<Curve<T, dim>> &crv, T tol = 1e-8) : CurveArcLength{crv, crv->bounds()[0], crv->bounds()[1], tol} {}
+        CurveArcLength(const CurveArcLength<T, dim> &crv) : CurveArcLength{crv.m_p_crv, crv.m_u_bounds[0], crv.m_u_bounds[1], crv.tolerance()} {}
+        /**
+         * @brief Curve evaluation at arc length s
+         *
+         * @param s : arc length from curve's start
+         * @param d : derivative order, up to 3
+         * @return std::array<T, dim>
+         */
+        virtual auto value(T s, size_t d = 0) const -> std::array<T, dim> override
+        {
+            auto u = parameter(s);
+            if (d == 0)
+                return m_p_crv->value(u);
+            if (d > 3)
+                throw std::runtime_error("Not implemented yet.");
+            auto d1 = m_p_crv->value(u, 1);
+            auto v2 = sq_norm(d1);
+            auto v = std::sqrt(v2);
+            if (d == 1)
+                return d1 / v;
+            auto d2 = m_p_crv->value(u, 2);
+            auto d12 = d1 * d2;
+            // u' = 1 / v, u'' = -(C'.C'') / v^4
+            auto u_1 = 1 / v;
+            auto u_2 = -d12 / (v2 * v2);
+            if (d == 2)
+                return d2 * (u_1 * u_1) + d1 * u_2;
+            auto d3 = m_p_crv->value(u, 3);
+            auto u_3 = (4 * d12 * d12 / (v2 * v2 * v2) - (d2 * d2 + d1 * d3) / (v2 * v2)) * u_1;
+            return d3 * (u_1 * u_1 * u_1) + d2 * (3 * u_1 * u_2) + d1 * u_3;
+        }
+        /**
+         * @brief Batched evaluations, run in parallel
+         *
+         * @param s_lst : arc lengths from curve's start
+         * @param d     : derivative order, up to 3
+         * @return points_vector<T, dim>
+         */
+        auto values(const std::vector<T> &s_lst, size_t d = 0) const -> points_vector<T, dim>
+        {
+            points_vector<T, dim> pts(s_lst.size());
+            std::transform(std::execution::par, s_lst.begin(), s_lst.end(), pts.begin(), [this, d](T s) { return value(s, d); });
+            return pts;
+        }
+        /**
+         * @brief n points evenly spaced along the curve, ends included
+         *
+         * @param n : points' number
+         * @return points_vector<T, dim>
+         */
+        auto uniformPoints(size_t n) const -> points_vector<T, dim>
+        {
+            if (n < 2)
+                throw std::invalid_argument("CurveArcLength: at least 2 points are required.");
+            return values(make_range(T(0), m_length, n));
+        }
+        virtual auto bounds() const -> std::array<T, 2> override
+        {
+            return {T(0), m_length};
+        }
+        /**
+         * @brief Basis curve's parameter at arc length s
+         *
+         * @param s
+         * @return T
+         */
+        auto parameter(T s) const -> T
+        {
+            if (s <= T(0))
+                return m_u_bounds[0];
+            if (s >= m_length)
+                return m_u_bounds[1];
+            return m_table.parameter(s + m_s1);
+        }
+        /**
+         * @brief Arc length at basis curve's parameter u
+         *
+         * @param u
+         * @return T
+         */
+        auto length(T u) const -> T
+        {
+            return m_table.length(u) - m_s1;
+        }
+        auto length() const -> T { return m_length; }
+        auto tolerance() const -> T { return m_table.tolerance(); }
+        auto basisCurve() const -> const std::shared_ptr<Curve<T, dim>> & { return m_p_crv; }
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gbs/bscurve.h>
+#include <gbs/bsctools.h>
 #include <algorithm>
 namespace gbs
 {
@@ -9,6 +10,7 @@ namespace gbs
     {
         std::vector<std::shared_ptr<Curve<T,dim>>> crv_lst_;
         std::vector<T> u_;
+        std::shared_ptr<const BSCurve<T, dim>> flat_; // evaluation backend, if enabled
         public:
         CurveComposite(const std::vector<std::shared_ptr<Curve<T,dim>>> &crv_lst) : crv_lst_{crv_lst} 
         {
@@ -27,6 +29,10 @@ namespace gbs
         }
         virtual auto value(T u, size_t d = 0) const -> std::array<T, dim> override
         {
+            if (flat_)
+            {
+                return flat_->value(u, d);
+            }
             auto pos = std::upper_bound(u_.begin(), u_.end(), u);
             if (pos == u_.end())
             {
@@ -42,5 +48,32 @@ namespace gbs
             return crv_loc->value(u_loc, d);
         }
         const auto & curves() const {return crv_lst_;}
+        /**
+         * @brief Evaluates the composite with its flattened form, see flatten in bsctools.h.
+         * The flattened form is a snapshot: it has to be enabled again once segments are modified.
+         *
+         * @param tol : approximation tolerance of the non BSCurve segments
+         * @param p   : approximation degree of the non BSCurve segments
+         */
+        auto enableFlat(T tol = 1e-6, size_t p = 3) -> void
+        {
+            flat_ = std::make_shared<const BSCurve<T, dim>>(flatten(crv_lst_, tol, p));
+        }
+        /**
+         * @brief Goes back to segments' evaluation
+         */
+        auto disableFlat() -> void
+        {
+            flat_.reset();
+        }
+        /**
+         * @brief The flattened form used for evaluation, nullptr if not enabled
+         *
+         * @return const BSCurve<T, dim>*
+         */
+        auto flatCurve() const -> const BSCurve<T, dim> *
+        {
+            return flat_.get();
+        }
     };
 }
@@ -21,37 +21,38 @@ namespace gbs
      * @param pnt     : the point
      * @param crv     : the curve
      * @param u0      : guess value
-     * @param tol_x   : tolerance
-     * @param solver : solver type please have look to https://nlopt.readthedocs.io/en/latest/NLopt_Algorithms/#nomenclature to change this value
+     * @param tol_x   : tolerance, the solvers stop on parameter steps below tol_x*tol_x
+     * @param solver : nlopt fallback if Levenberg-Marquardt doesn't converge, please have look to https://nlopt.readthedocs.io/en/latest/NLopt_Algorithms/#nomenclature to change this value
      * @return auto
      */
     template <typename T, size_t dim>
     auto extrema_curve_point(const Curve<T, dim> &crv, const std::array<T, dim> &pnt, T u0,T tol_x,nlopt::algorithm solver=default_nlopt_algo) -> std::array<T,2>
     {
-        auto f = [&pnt,&crv](const std::vector<double> &x)
+        auto f = [&pnt,&crv](const std::array<T,1> &x)
         {
-            return std::vector<double>{sq_norm(crv(x[0]) - pnt)}; //double req for nlop
-            // return std::vector<T>{crv(x[0],1)*(crv(x[0]) - pnt)};
+            return crv(x[0]) - pnt;
         };
 
-        auto g = [&pnt,&crv](const std::vector<double> &x,const std::vector<double> &r)
+        auto jac = [&crv](const std::array<T,1> &x, const std::array<T,dim> &)
         {
-            auto dfdu = 2.*crv(x[0],1)*(crv(x[0]) - pnt);
-            // auto dfdu = crv(x[0],2)*(crv(x[0]) - pnt) + sq_norm(crv(x[0],1)) ;
-            return std::vector<double>{2. * r[0] * dfdu}; //double req for nlop
+            auto d = crv(x[0],1);
+            jacobian<T,1,dim> J;
+            for (size_t i{}; i < dim; i++)
+                J[i] = {d[i]};
+            return J;
         };
 
-        std::vector<T> x{u0};
-        std::vector<T> lb{crv.bounds()[0]};
-        std::vector<T> hb{crv.bounds()[1]};
-        auto minf = solve_D_nlop(
-            f,g,
+        auto [u1, u2] = crv.bounds();
+        std::array<T,1> x{u0};
+        std::array<T,1> lb{u1};
+        std::array<T,1> hb{u2};
+        auto minf = solve_least_squares(
+            f, jac,
             x, lb, hb,
             tol_x*tol_x,
-            solver
+            std::optional{solver}
             );
-        // return {T(x[0]),T(sqrt(minf))};
-        return std::array<T,2>{T(x[0]),T(sqrt(minf))};
+        return std::array<T,2>{x[0],std::sqrt(minf)};
     }
     /**
      * @brief Project point on curve
@@ -83,38 +84,30 @@ namespace gbs
      * @param pnt 
      * @param u0 
      * @param v0 
-     * @param tol_x 
+     * @param tol_x   : tolerance, the solvers stop on parameter steps below tol_x*tol_x
      * @param solver 
      * @return auto
      */
     template <typename T, size_t dim>
     auto extrema_surf_pnt(const Surface<T, dim> &srf, const std::array<T, dim> &pnt, T u0, T v0, T tol_x, nlopt::algorithm solver=default_nlopt_algo)
     {
-        auto f = [&pnt,&srf](const std::vector<double> &x)
+        auto f = [&pnt,&srf](const std::array<T,2> &x)
         {
-            return std::vector<double>{sq_norm(srf(x[0],x[1]) - pnt)};
-        };
-
-        auto g = [&pnt,&srf](const std::vector<double> &x,const std::vector<double> &r)
-        {
-            // return std::vector<T>{2.*crv(x[0],1)*(crv(x[0]) - pnt)};
-            auto f_ = srf(x[0],x[1])  - pnt;
-            auto dfdu = 2.*srf(x[0],x[1],1,0)* f_;
-            auto dfdv = 2.*srf(x[0],x[1],0,1)* f_;
-            return std::vector<double>{2. * r[0] * dfdu,2. * r[0] * dfdv};
+            return srf(x[0],x[1]) - pnt;
         };
 
         auto [u1,u2,v1,v2] = srf.bounds();
-        std::vector<T> x{u0,v0};
-        std::vector<T> lb{u1,v1};
-        std::vector<T> hb{u2,v2};
-        auto minf = solve_D_nlop(
-            f,g,
+        std::array<T,2> x{u0,v0};
+        std::array<T,2> lb{u1,v1};
+        std::array<T,2> hb{u2,v2};
+        // rational surfaces do not evaluate derivatives, the Jacobian is approximated
+        auto minf = solve_least_squares(
+            f,
             x, lb, hb,
             tol_x*tol_x,
-            solver
+            std::optional{solver}
         );
-        return std::array<T,3>{x[0], x[1], std::sqrt(static_cast<T>(minf))};
+        return std::array<T,3>{x[0], x[1], std::sqrt(minf)};
     }
     /**
      * @brief Project point on surface, initial value for solver is bracketed
@@ -141,35 +134,49 @@ namespace gbs
         auto [u0, v0 ] = *std::min_element(std::execution::par , uv.begin(), uv.end(), comp);
         return extrema_surf_pnt(srf, pnt, u0, v0, tol_x, solver);
     }
-
+    /**
+     * @brief Closest points between two curves
+     * 
+     * @tparam T 
+     * @tparam dim 
+     * @param crv1 
+     * @param crv2 
+     * @param u10     : guess value on crv1
+     * @param u20     : guess value on crv2
+     * @param tol_x   : tolerance, the solvers stop on parameter steps below tol_x*tol_x
+     * @param solver  : nlopt fallback if Levenberg-Marquardt doesn't converge
+     * @return auto {u1, u2, distance}
+     */
     template <typename T, size_t dim>
     auto extrema_curve_curve(const Curve<T, dim> &crv1, const Curve<T, dim> &crv2, T u10, T u20,T tol_x, nlopt::algorithm solver=default_nlopt_algo)
     {
-        auto f = [&crv1,&crv2](const std::vector<double> &x)
+        auto f = [&crv1,&crv2](const std::array<T,2> &x)
         {
-            return std::vector<double>{sq_norm(crv1(x[0])-crv2(x[1]))};
+            return crv1(x[0])-crv2(x[1]);
         };
 
-        auto g = [&crv1,&crv2](const std::vector<double> &x,const std::vector<double> &r)
+        auto jac = [&crv1,&crv2](const std::array<T,2> &x, const std::array<T,dim> &)
         {
-            auto f_ = crv1(x[0])-crv2(x[1]);
-            auto dfdu = 2.*crv1(x[0],1)* f_;
-            auto dfdv = 2.*crv2(x[1],1)* f_;
-            return std::vector<double>{2. * r[0] * dfdu,2. * r[0] * dfdv};
+            auto d1 = crv1(x[0],1);
+            auto d2 = crv2(x[1],1);
+            jacobian<T,2,dim> J;
+            for (size_t i{}; i < dim; i++)
+                J[i] = {d1[i], -d2[i]};
+            return J;
         };
 
         auto [u1,u2] = crv1.bounds();
         auto [v1,v2] = crv2.bounds();
-        std::vector<T> x{u10,u20};
-        std::vector<T> lb{u1,v1};
-        std::vector<T> hb{u2,v2};
-        auto minf = solve_D_nlop(
-            f,g,
+        std::array<T,2> x{u10,u20};
+        std::array<T,2> lb{u1,v1};
+        std::array<T,2> hb{u2,v2};
+        auto minf = solve_least_squares(
+            f, jac,
             x, lb, hb,
             tol_x*tol_x,
-            solver
+            std::optional{solver}
         );
-        return std::array<T,3>{T(x[0]),T(x[1]),T(sqrt(minf))};
+        return std::array<T,3>{x[0],x[1],std::sqrt(minf)};
     }
 
     template <typename T, size_t dim>
@@ -245,36 +252,42 @@ namespace gbs
         return intersection_info;
     }
 
+    /**
+     * @brief Closest points between a surface and a curve
+     * 
+     * @tparam T 
+     * @tparam dim 
+     * @param srf 
+     * @param crv 
+     * @param u_c0    : guess value on crv
+     * @param u_s0    : guess u value on srf
+     * @param v_s0    : guess v value on srf
+     * @param tol_x   : tolerance, the solvers stop on parameter steps below tol_x*tol_x
+     * @param solver  : nlopt fallback if Levenberg-Marquardt doesn't converge
+     * @return auto {u_s, v_s, u_c, distance}
+     */
     template <typename T, size_t dim>
     auto extrema_surf_curve(const Surface<T, dim> &srf, const Curve<T, dim> &crv, T u_c0, T u_s0, T v_s0, T tol_x, nlopt::algorithm solver=default_nlopt_algo) //-> extrema_CS_result<T>
     {
 
-        auto f = [&crv,&srf](const std::vector<double> &x)
-        {
-            return std::vector<double>{sq_norm(crv(x[0])-srf(x[1],x[2]))};
-        };
-
-        auto g = [&crv,&srf](const std::vector<double> &x,const std::vector<double> &r)
+        auto f = [&crv,&srf](const std::array<T,3> &x)
         {
-            auto f_ = crv(x[0])-srf(x[1],x[2]);
-            auto dfduc = 2.*crv(x[0],1)  * f_;
-            auto dfdus =-2.*srf(x[1],1,0)* f_;
-            auto dfdvs =-2.*srf(x[2],0,1)* f_;
-            return std::vector<double>{2. * r[0] * dfduc,2. * r[0] * dfdus,2. * r[0] * dfdvs};
+            return crv(x[0])-srf(x[1],x[2]);
         };
 
         auto [uc1,uc2] = crv.bounds();
         auto [us1,us2,vs1,vs2] = srf.bounds();
-        std::vector<T> x{u_c0,u_s0,v_s0};
-        std::vector<T> lb{uc1,us1, vs1};
-        std::vector<T> hb{uc2,us2, vs2};
-        auto minf = solve_D_nlop(
-            f,g,
+        std::array<T,3> x{u_c0,u_s0,v_s0};
+        std::array<T,3> lb{uc1,us1, vs1};
+        std::array<T,3> hb{uc2,us2, vs2};
+        // rational surfaces do not evaluate derivatives, the Jacobian is approximated
+        auto minf = solve_least_squares(
+            f,
             x, lb, hb,
             tol_x*tol_x,
-            solver
+            std::optional{solver}
         );
-        return std::array<T,4>{x[1], x[2],x[0],std::sqrt(static_cast<T>(minf))};
+        return std::array<T,4>{x[1], x[2],x[0],std::sqrt(minf)};
     }
 
     template <typename T, size_t dim>
@@ -599,116 +599,6 @@ namespace gbs
 
     }
 
-    /**
-     * @brief This function removes a knot from a B-spline.
-     *
-     * @param u The value of the knot to remove.
-     * @param p The order of the B-spline.
-     * @param num The number of times the knot u should be removed.
-     * @param U A vector of knots.
-     * @param Pw A vector of control points.
-     * @param tol The tolerance for knot removal.
-     *
-     * @return The actual number of times the knot was removed.
-     */
-    template <typename T, size_t dim>
-    auto remove_knot(T u, size_t p, size_t num, std::vector<T> &U, std::vector<std::array<T, dim>> &Pw, T tol)
-    {
-        // Determine the knot interval that contains u
-        auto r = std::distance(U.begin(), std::ranges::upper_bound(U, u)) - 1;
-        // if u is not a knot
-        if(std::abs(U[r]-u)>knot_eps<T>)
-        {
-            // return false;
-        }
-        // Find the multiplicity of the knot u
-        auto s = multiplicity(u, U);
-        auto m = U.size();
-        auto n = Pw.size();
-        
-        // Determine the first and last affected control points
-        auto first = r - p;
-        auto last = r - s;
-        
-        size_t t{0};
-        std::list<std::array<T, dim>> Pi;
-        std::list<std::array<T, dim>> Pj;
-        
-        // Try to remove the knot u num times
-        for (; t < num; t++)
-        {
-            auto i{first};
-            auto j{last};
-            
-            // Initialize lists of control points Pi and Pj
-            Pi = {Pw[first - 1]};
-            Pj = {Pw[last + 1]};
-            
-            while (j > i + t)
-            {
-                // Compute blending factors
-                auto ai = (u - U[i]) / (U[i + p + 1 + t] - U[i]);
-                auto aj = (u - U[j - t]) / (U[j + p + 1] - U[j - t]);
-
-                // Compute new control points
-                Pi.push_back((Pw[i] - (1 - ai) * Pi.back()) / ai);
-                Pj.push_front((Pw[j] - aj * Pj.front()) / (1 - aj));
-                i++;
-                j--;
-            }
-            
-            bool remove_flag = false;
-            if (j < i + t)
-            {
-                // If the knot can be removed, update Pi and Pj
-                auto d = distance(Pi.back(), Pj.front());
-                if (d < tol)
-                {
-                    remove_flag = true;
-                    Pj.pop_front();
-                }
-            }
-            else
-            {
-                // Check if knot removal is possible
-                auto ai = (u - U[i]) / (U[i + p + 1 + t] - U[i]);
-                auto d = distance(Pw[i], ai * Pi.back() + (1 - ai) * Pj.front());
-                if (d < tol)
-                {
-                    remove_flag = true;
-                    Pj.pop_front();
-                    Pi.pop_back();
-                }
-            }
-            
-            first--;
-            last++;
-
-            if (!remove_flag)
-            {
-                break;
-            }
-
-        }
-        if (t > 0)
-        {
-            // If at least one knot has been removed, update the control points Pw
-            auto Pw_beg = Pw.begin();
-            std::vector<std::array<T, dim>> head{Pw_beg, std::next(Pw_beg, first)};
-            std::vector<std::array<T, dim>> tail{std::next(Pw_beg, last + 1), Pw.end()};
-            Pw = std::move(head);
-            Pw.insert(Pw.end(), Pi.begin(), Pi.end());
-            Pw.insert(Pw.end(), Pj.begin(), Pj.end());
-            Pw.insert(Pw.end(), tail.begin(), tail.end());
-
-            U.erase(std::next(U.begin(),r-t+1), std::next(U.begin(),r+1));
-
-            assert(U.size()-p-1==Pw.size());
-        }
-
-        // Return the number of times the knot was actually removed
-        return t;
-    }
     /**
      * @brief This function removes a knot from a B-spline.
      *
@@ -780,17 +670,19 @@ namespace gbs
         {
             // Check if knot removal is possible
             auto ai = (u - U[i]) / (U[i + p + 1] - U[i]);
-            auto d = distance(Pw[i], ai * Pi.back() + (1 - ai) * Pj.front());
+            // Pw[i] is the removed pole, both sides' new poles are kept
+            auto d = distance(Pw[i], ai * Pj.front() + (1 - ai) * Pi.back());
             if (d < tol)
             {
                 remove_flag = true;
-                Pj.pop_front();
-                Pi.pop_back();
             }
         }
 
         if (remove_flag)
         {
+            // Pi and Pj ends are the unchanged poles Pw[first-1] and Pw[last+1]
+            Pi.pop_front();
+            Pj.pop_back();
             auto Pw_beg = Pw.begin();
             std::vector<std::array<T, dim>> head{Pw_beg, std::next(Pw_beg, first)};
             std::vector<std::array<T, dim>> tail{std::next(Pw_beg, last + 1), Pw.end()};
@@ -805,6 +697,32 @@ namespace gbs
 
         return remove_flag;
     }
+    /**
+     * @brief This function removes a knot from a B-spline.
+     * The knot is removed one time after the other, each removal being checked against tol on the poles
+     * left by the previous one. Removal stops at the first failure, the failed attempt does not modify U and Pw.
+     *
+     * @param u The value of the knot to remove.
+     * @param p The order of the B-spline.
+     * @param num The number of times the knot u should be removed.
+     * @param U A vector of knots.
+     * @param Pw A vector of control points.
+     * @param tol The tolerance for knot removal.
+     *
+     * @return The actual number of times the knot was removed.
+     */
+    template <typename T, size_t dim>
+    auto remove_knot(T u, size_t p, size_t num, std::vector<T> &U, std::vector<std::array<T, dim>> &Pw, T tol)
+    {
+        size_t t{0};
+        while (t < num && remove_knot(u, p, U, Pw, tol))
+        {
+            t++;
+        }
+        assert(U.size() - p - 1 == Pw.size());
+        // Return the number of times the knot was actually removed
+        return t;
+    }
     /**
      * @brief Change parametrization to fit between k1 and k2
      * 
@@ -921,6 +839,32 @@ namespace gbs
             }
         }
     }
+    /**
+     * @brief Hodograph, i.e. exact derivative, of a non rational B-Spline. The result is of degree p-1 on the flat knots
+     * without their first and last values. A degree 0 B-Spline gives the null function on the same knots.
+     * Poles without support, under knots of multiplicity above p, are set to zero.
+     *
+     * @tparam T
+     * @tparam dim
+     * @param k     : flat knots
+     * @param poles : poles
+     * @param p     : degree
+     * @return std::pair<std::vector<std::array<T, dim>>, std::vector<T>> (hodograph's poles, hodograph's flat knots)
+     */
+    template <typename T, size_t dim>
+    auto hodograph(const std::vector<T> &k, const std::vector<std::array<T, dim>> &poles, size_t p) -> std::pair<std::vector<std::array<T, dim>>, std::vector<T>>
+    {
+        if (p == 0)
+            return {std::vector<std::array<T, dim>>(poles.size(), std::array<T, dim>{}), k};
+        std::vector<std::array<T, dim>> d_poles(poles.size() - 1);
+        for (size_t i{}; i < d_poles.size(); i++)
+        {
+            auto dk = k[i + p + 1] - k[i + 1];
+            d_poles[i] = dk > T(0) ? T(p) * (poles[i + 1] - poles[i]) / dk : std::array<T, dim>{};
+        }
+        return {d_poles, std::vector<T>{std::next(k.begin()), std::prev(k.end())}};
+    }
+
     template <typename T, size_t dim>
     auto increase_degree(std::vector<T> &k, std::vector<std::array<T, dim>> &poles,size_t p, size_t t)
     {
@@ -0,0 +1,47 @@
+#pragma once
+#include <gbs/adaptiveapprox.h>
+#include <gbs/curveoffset.h>
+#include <gbs/surfaceoffset.h>
+
+namespace gbs
+{
+    /**
+     * @brief Explicit B-Spline of an offset curve within a given tolerance, see approx_adaptive.
+     * The basis curve's knots seed the approximation's knots, with the continuity the offset keeps there. The result can be stored and evaluated
+     * at the cost of a plain B-Spline instead of the basis curve's derivatives.
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam Func
+     * @param crv      : the offset curve
+     * @param tol      : maximal distance to the offset curve
+     * @param p        : approximation's degree
+     * @param max_iter : maximal number of refinement passes
+     * @return BSCurve<T, dim>
+     */
+    template <typename T, size_t dim, typename Func>
+    auto approx_offset(const CurveOffset<T, dim, Func> &crv, T tol, size_t p = 3, size_t max_iter = 16) -> BSCurve<T, dim>
+    {
+        return approx_adaptive<T, dim>(crv, curve_breaks(crv.basisCurve(), p, 1), tol, p, max_iter);
+    }
+    /**
+     * @brief Explicit B-Spline of an offset surface within a given tolerance, see approx_adaptive.
+     * The basis surface's knots seed the approximation's knots, with the continuity the offset keeps there.
+     *
+     * @tparam T
+     * @tparam dim
+     * @tparam Func
+     * @param srf      : the offset surface
+     * @param tol      : maximal distance to the offset surface
+     * @param p        : approximation's degree in u direction
+     * @param q        : approximation's degree in v direction
+     * @param max_iter : maximal number of refinement passes
+     * @return BSSurface<T, dim>
+     */
+    template <typename T, size_t dim, typename Func>
+    auto approx_offset(const SurfaceOffset<T, dim, Func> &srf, T tol, size_t p = 3, size_t q = 3, size_t max_iter = 12) -> BSSurface<T, dim>
+    {
+        auto [breaks_u, breaks_v] = surface_breaks(srf.basisSurface(), p, q, 1);
+        return approx_adaptive<T, dim>(srf, breaks_u, breaks_v, tol, p, q, max_iter);
+    }
+}
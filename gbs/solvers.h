@@ -1,7 +1,11 @@
 #pragma once
 #include <nlopt.hpp>
 #include <vector>
+#include <array>
+#include <tuple>
+#include <optional>
 #include <numeric>
+#include <Eigen/Dense>
 #include <gbs/vecop.h>
 namespace gbs
 {
@@ -66,8 +70,7 @@ namespace gbs
             {
                 grad = p_d->f_grad_(x,r); // passing f_eq_ evaluation can, I some occasions save some computation steps
             }
-            std::transform(r.begin(),r.end(),r.begin(),[](const auto &r_){return r_*r_;});
-            return std::reduce(r.begin(),r.end());
+            return std::inner_product(r.begin(),r.end(),r.begin(),0.);
         };
 
         D_UserData data(f,g);
@@ -102,4 +105,224 @@ namespace gbs
 
         // return minf;
     }
+
+    /**
+     * @brief Jacobian matrix of m residuals with respect to n unknowns, stored by rows
+     *
+     * @tparam T
+     * @tparam n : unknowns' number
+     * @tparam m : residuals' number
+     */
+    template <typename T, size_t n, size_t m>
+    using jacobian = std::array<std::array<T, n>, m>;
+
+    /**
+     * @brief Bounded Levenberg-Marquardt least squares solver working on fixed size states, no heap allocation is performed.
+     * The normal equations are solved with Eigen's fixed size matrices, steps are clamped into the bounds.
+     * The damping keeps the normal equations solvable when there are fewer residuals than unknowns.
+     *
+     * @tparam T
+     * @tparam n   : unknowns' number
+     * @tparam F   : residuals function std::array<T,n> -> std::array<T,m>
+     * @tparam J   : Jacobian function (std::array<T,n> x, std::array<T,m> r) -> jacobian<T,n,m>, r is f(x) to save computations
+     * @param f
+     * @param jac
+     * @param x      : initial guess, updated with the solution
+     * @param lb     : lower bounds
+     * @param hb     : upper bounds
+     * @param tol_x  : absolute step tolerance
+     * @param it_max : maximum iterations number
+     * @return std::tuple<T, bool> (sum of squared residuals, convergence flag)
+     */
+    template <typename T, size_t n, typename F, typename J>
+    auto solve_LM(const F &f, const J &jac, std::array<T, n> &x, const std::array<T, n> &lb, const std::array<T, n> &hb, T tol_x, size_t it_max = 100) -> std::tuple<T, bool>
+    {
+        constexpr size_t m = std::tuple_size_v<decltype(f(x))>;
+        using MatJ = Eigen::Matrix<T, int(m), int(n)>;
+        using MatA = Eigen::Matrix<T, int(n), int(n)>;
+        using VecX = Eigen::Matrix<T, int(n), 1>;
+        using VecR = Eigen::Matrix<T, int(m), 1>;
+
+        auto sq = [](const auto &r) { return std::inner_product(r.begin(), r.end(), r.begin(), T(0)); };
+        for (size_t i{}; i < n; i++)
+            x[i] = std::clamp(x[i], lb[i], hb[i]);
+        auto r = f(x);
+        auto cost = sq(r);
+        T lambda{1e-3};
+        for (size_t it{}; it < it_max; it++)
+        {
+            auto J_ = jac(x, r);
+            MatJ Jm;
+            for (size_t i{}; i < m; i++)
+                for (size_t j{}; j < n; j++)
+                    Jm(i, j) = J_[i][j];
+            MatA A = Jm.transpose() * Jm;
+            VecX g = Jm.transpose() * Eigen::Map<const VecR>(r.data());
+            if (g.template lpNorm<Eigen::Infinity>() <= std::numeric_limits<T>::epsilon() * (cost + 1))
+                return {cost, true}; // stationary point
+            while (true)
+            {
+                MatA H = A;
+                for (size_t i{}; i < n; i++)
+                    H(i, i) += lambda * std::max(A(i, i), std::numeric_limits<T>::epsilon());
+                VecX dx = H.ldlt().solve(-g);
+                auto x_new = x;
+                T step{};
+                for (size_t i{}; i < n; i++)
+                {
+                    x_new[i] = std::clamp(x[i] + dx(i), lb[i], hb[i]);
+                    step = std::max(step, std::fabs(x_new[i] - x[i]));
+                }
+                auto r_new = f(x_new);
+                auto cost_new = sq(r_new);
+                if (cost_new <= cost)
+                {
+                    x = x_new;
+                    r = r_new;
+                    cost = cost_new;
+                    lambda = std::max(lambda / T(10), std::numeric_limits<T>::epsilon());
+                    if (step <= tol_x)
+                        return {cost, true};
+                    break;
+                }
+                lambda *= T(10);
+                if (step <= tol_x || lambda > T(1e16))
+                    return {cost, step <= tol_x}; // no descent left at the requested resolution
+            }
+        }
+        return {cost, false};
+    }
+
+    /**
+     * @brief Forward finite differences Jacobian of a residuals function, steps stay inside the bounds
+     *
+     * @tparam T
+     * @tparam n
+     * @tparam F   : residuals function std::array<T,n> -> std::array<T,m>
+     * @param f
+     * @param lb     : lower bounds
+     * @param hb     : upper bounds
+     * @return Jacobian function (std::array<T,n> x, std::array<T,m> r) -> jacobian<T,n,m>
+     */
+    template <typename T, size_t n, typename F>
+    auto finite_differences_jacobian(const F &f, const std::array<T, n> &lb, const std::array<T, n> &hb)
+    {
+        constexpr size_t m = std::tuple_size_v<decltype(f(lb))>;
+        return [&f, &lb, &hb](const std::array<T, n> &x_, const std::array<T, m> &r)
+        {
+            jacobian<T, n, m> J_;
+            for (size_t j{}; j < n; j++)
+            {
+                auto h = std::sqrt(std::numeric_limits<T>::epsilon()) * std::max(T(1), std::fabs(x_[j]));
+                auto xh = x_;
+                xh[j] = x_[j] + h > hb[j] ? x_[j] - h : x_[j] + h; // stay inside bounds
+                auto rh = f(xh);
+                for (size_t i{}; i < m; i++)
+                    J_[i][j] = (rh[i] - r[i]) / (xh[j] - x_[j]);
+            }
+            return J_;
+        };
+    }
+
+    /**
+     * @brief Bounded Levenberg-Marquardt least squares solver, the Jacobian is approximated by forward finite differences
+     *
+     * @tparam T
+     * @tparam n
+     * @tparam F   : residuals function std::array<T,n> -> std::array<T,m>
+     * @param f
+     * @param x      : initial guess, updated with the solution
+     * @param lb     : lower bounds
+     * @param hb     : upper bounds
+     * @param tol_x  : absolute step tolerance
+     * @param it_max : maximum iterations number
+     * @return std::tuple<T, bool> (sum of squared residuals, convergence flag)
+     */
+    template <typename T, size_t n, typename F>
+    auto solve_LM(const F &f, std::array<T, n> &x, const std::array<T, n> &lb, const std::array<T, n> &hb, T tol_x, size_t it_max = 100) -> std::tuple<T, bool>
+    {
+        return solve_LM(f, finite_differences_jacobian(f, lb, hb), x, lb, hb, tol_x, it_max);
+    }
+
+    /**
+     * @brief Least squares solve on fixed size state. Levenberg-Marquardt is used first, nlopt is only used when requested
+     * by providing an algorithm, either if Levenberg-Marquardt doesn't converge or if its result is not good enough.
+     * nlopt then starts from Levenberg-Marquardt's result.
+     *
+     * @tparam T
+     * @tparam n
+     * @tparam F   : residuals function std::array<T,n> -> std::array<T,m>
+     * @tparam J   : Jacobian function (std::array<T,n> x, std::array<T,m> r) -> jacobian<T,n,m>
+     * @param f
+     * @param jac
+     * @param x        : initial guess, updated with the solution
+     * @param lb       : lower bounds
+     * @param hb       : upper bounds
+     * @param tol_x    : step tolerance
+     * @param fallback : nlopt algorithm used if Levenberg-Marquardt fails
+     * @param tol_f    : required sum of squared residuals for the fallback to be skipped, any value if infinite
+     * @return T sum of squared residuals
+     */
+    template <typename T, size_t n, typename F, typename J>
+    auto solve_least_squares(const F &f, const J &jac, std::array<T, n> &x, const std::array<T, n> &lb, const std::array<T, n> &hb, T tol_x,
+                             std::optional<nlopt::algorithm> fallback = std::nullopt, T tol_f = std::numeric_limits<T>::infinity()) -> T
+    {
+        auto [cost, converged] = solve_LM(f, jac, x, lb, hb, tol_x);
+        if (!fallback || (converged && cost <= tol_f))
+            return cost;
+
+        constexpr size_t m = std::tuple_size_v<decltype(f(x))>;
+        auto to_array = [](const std::vector<double> &v)
+        {
+            std::array<T, n> a;
+            std::transform(v.begin(), v.end(), a.begin(), [](double v_) { return static_cast<T>(v_); });
+            return a;
+        };
+        auto f_ = [&](const std::vector<double> &v)
+        {
+            auto r = f(to_array(v));
+            return std::vector<double>(r.begin(), r.end());
+        };
+        auto g_ = [&](const std::vector<double> &v, const std::vector<double> &r)
+        {
+            std::array<T, m> r_;
+            std::transform(r.begin(), r.end(), r_.begin(), [](double v_) { return static_cast<T>(v_); });
+            auto J_ = jac(to_array(v), r_);
+            std::vector<double> grad(n, 0.);
+            for (size_t i{}; i < m; i++)
+                for (size_t j{}; j < n; j++)
+                    grad[j] += 2. * r[i] * J_[i][j];
+            return grad;
+        };
+        std::vector<T> x_(x.begin(), x.end()), lb_(lb.begin(), lb.end()), hb_(hb.begin(), hb.end());
+        auto minf = solve_D_nlop(f_, g_, x_, lb_, hb_, tol_x, *fallback);
+        if (minf < cost)
+        {
+            std::copy(x_.begin(), x_.end(), x.begin());
+            return minf;
+        }
+        return cost;
+    }
+
+    /**
+     * @brief Least squares solve on fixed size state, the Jacobian is approximated by forward finite differences, see solve_least_squares
+     *
+     * @tparam T
+     * @tparam n
+     * @tparam F   : residuals function std::array<T,n> -> std::array<T,m>
+     * @param f
+     * @param x        : initial guess, updated with the solution
+     * @param lb       : lower bounds
+     * @param hb       : upper bounds
+     * @param tol_x    : step tolerance
+     * @param fallback : nlopt algorithm used if Levenberg-Marquardt fails
+     * @param tol_f    : required sum of squared residuals for the fallback to be skipped, any value if infinite
+     * @return T sum of squared residuals
+     */
+    template <typename T, size_t n, typename F>
+    auto solve_least_squares(const F &f, std::array<T, n> &x, const std::array<T, n> &lb, const std::array<T, n> &hb, T tol_x,
+                             std::optional<nlopt::algorithm> fallback = std::nullopt, T tol_f = std::numeric_limits<T>::infinity()) -> T
+    {
+        return solve_least_squares(f, finite_differences_jacobian(f, lb, hb), x, lb, hb, tol_x, fallback, tol_f);
+    }
 }
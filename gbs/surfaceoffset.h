@@ -18,37 +18,40 @@ namespace gbs
         {
         }
 
-        // CurveOffset(const BSSurface<T, dim> &srf, const Func &f_offset) : p_srf_{std::make_shared<BSSurface<T, dim>>(srf)},
-        //                                                                 f_offset_{std::make_shared<Func>(f_offset)}
-        // {
-        // }
-
-        virtual auto value(T u, T v, size_t du = 0, size_t dv = 0) const -> std::array<T, dim> override
+        SurfaceOffset(const BSSurface<T, dim> &srf, const Func &f_offset) : p_srf_{std::make_shared<BSSurface<T, dim>>(srf)},
+                                                                            f_offset_{std::make_shared<Func>(f_offset)}
         {
-            // switch (d)
-            // {
-            // case 0:
-                return p_srf_->value(u) + normal_direction(*(p_srf_), u, v) * (*f_offset_)(u, v);
-            //     break;
-            // default:
-            //     throw std::runtime_error("Not implemented yet.");
-            //     break;
-            // }
         }
-
-        virtual auto bounds() const -> std::array<T, 2> override
+        /**
+         * @brief Offset evaluation, the offset is taken along the normal du ^ dv of the basis surface
+         *
+         * @param u
+         * @param v
+         * @param du : only 0 is implemented
+         * @param dv : only 0 is implemented
+         * @return point<T, dim>
+         */
+        virtual auto value(T u, T v, size_t du = 0, size_t dv = 0) const -> point<T, dim> override
         {
-            return p_srf_->bounds();
+            if (du != 0 || dv != 0)
+                throw std::runtime_error("Not implemented yet.");
+            auto n = p_srf_->value(u, v, 1, 0) ^ p_srf_->value(u, v, 0, 1);
+            return p_srf_->value(u, v) + n * ((*f_offset_)(u, v) / norm(n));
         }
 
-        auto changeBounds(const std::array<T, 2> &b) -> void
+        virtual auto bounds() const -> std::array<T, 4> override
         {
-            p_srf_->changeBounds(b);
+            return p_srf_->bounds();
         }
 
         auto basisSurface() const -> const Surface<T, dim> &
         {
             return *p_srf_;
         }
+
+        auto offset() const -> const Func &
+        {
+            return *f_offset_;
+        }
     };
-}
\ No newline at end of file
+}
@@ -4,15 +4,17 @@
 #include <utility>
 #include <limits>
 #include <gbs/surfaces>
+#include "robustPredicates.h"
 namespace gbs
 {
     template <std::floating_point T>
     T orient_2d( T ax, T ay, T bx, T by, T cx, T cy)
     {
-        return (ax-cx)*(by-cy) - (ay-cy)*(bx-cx);
+        return orient_2d_robust(ax, ay, bx, by, cx, cy);
     }
     /**
      * @brief Returns > 0 if the triangle (a,b,c) is counter clockwise 0. if degenerated
+     * The sign is exact, see orient_2d_robust.
      * 
      * @tparam T 
      * @param a 
@@ -29,7 +31,7 @@ namespace gbs
         auto [ax,ay] = a;
         auto [bx,by] = b;
         auto [cx,cy] = c;
-        return (ax-cx)*(by-cy) - (ay-cy)*(bx-cx);
+        return orient_2d_robust(ax, ay, bx, by, cx, cy);
     }
     /**
      * @brief Check if the triangle (a,b,c) is counter clockwise
@@ -20,15 +20,10 @@ namespace gbs
         const std::array<T, 2>& c,
         const std::array<T, 2>& d)
     {
-        // Lambda function to compute the signed area of a triangle defined by three points
-        auto sign = [](const auto& p1, const auto& p2, const auto& p3) {
-            return (p1[0] - p3[0]) * (p2[1] - p3[1]) - (p2[0] - p3[0]) * (p1[1] - p3[1]);
-        };
-
         // Calculate the signed areas of the triangles formed by point D and each edge of the input triangle
-        auto d1 = sign(d, a, b);
-        auto d2 = sign(d, b, c);
-        auto d3 = sign(d, c, a);
+        auto d1 = orient_2d(d, a, b);
+        auto d2 = orient_2d(d, b, c);
+        auto d3 = orient_2d(d, c, a);
 
         // Determine if the point D has a consistent orientation with respect to the input triangle's vertices
         auto has_neg = (d1 < 0) || (d2 < 0) || (d3 < 0);
@@ -116,23 +111,12 @@ namespace gbs
  * @param dx The x-coordinate of point D.
  * @param dy The y-coordinate of point D.
  * @return A positive value if the point D is inside the circle, a negative value if the point D is outside the circle, and zero if the point D is on the circle.
+ * The sign is exact, see in_circle_robust.
  */
     template <std::floating_point T>
     [[nodiscard]] T in_circle(T ax, T ay, T bx, T by, T cx, T cy, T dx, T dy)
     {
-        T A{ax - dx};
-        T B{ay - dy};
-        T C{A * A + B * B};
-
-        T D{bx - dx};
-        T E{by - dy};
-        T F{D * D + E * E};
-
-        T G{cx - dx};
-        T H{cy - dy};
-        T I{G * G + H * H};
-
-        return A * E * I + D * H * C + B * F * G - (G * E * C + D * B * I + A * H * F);
+        return in_circle_robust(ax, ay, bx, by, cx, cy, dx, dy);
     }
 
     /**
@@ -208,9 +192,9 @@ namespace gbs
         T tol = T(1e-10))
     {
 
-        T cross_product = (b[0] - a[0]) * (p[1] - a[1]) - (p[0] - a[0]) * (b[1] - a[1]);
+        T cross_product = orient_2d(a, b, p);
 
-        // Check if the point is on the line (tolerance for floating-point errors)
+        // Check if the point is on the line (tolerance for floating-point errors), tol = 0 is an exact test
         if (std::abs(cross_product) > tol)
         {
             return false;
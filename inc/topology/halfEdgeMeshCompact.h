@@ -0,0 +1,756 @@
+#pragma once
+#include "halfEdgeMeshData.h"
+#include "halfEdgeMeshGetters.h"
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace gbs
+{
+    using HeIndex = std::uint32_t;                                       ///< Index of a vertex, half-edge or face in a CompactHalfEdgeMesh
+    inline constexpr HeIndex he_null = std::numeric_limits<HeIndex>::max(); ///< Missing link, i.e. nullptr of the shared_ptr structure
+
+/**
+ * @brief Index based half-edge mesh, the arena counterpart of the shared_ptr structure of halfEdgeMeshData.h.
+ *
+ * Vertices, half-edges and faces are 32-bit indices into contiguous arrays, one array per attribute (SoA layout).
+ * Removed elements go to free lists and are reused by the next additions, hence indices stay valid until the element is removed.
+ * Conventions are the ones of the shared_ptr structure: a half-edge points to the vertex it ends at, a vertex to one of its
+ * incoming half-edges, a face to one of its half-edges, and boundary half-edges have no opposite.
+ *
+ * @tparam T Numeric type of the vertex coordinates
+ * @tparam dim Dimension of the vertex coordinates (2 or 3)
+ */
+    template <std::floating_point T, size_t dim>
+    class CompactHalfEdgeMesh
+    {
+        static constexpr HeIndex removed = he_null - 1; // marks free slots
+
+        // vertices
+        std::vector<std::array<T, dim>> m_coords;
+        std::vector<HeIndex> m_v_edge;
+        // half-edges
+        std::vector<HeIndex> m_he_vertex;
+        std::vector<HeIndex> m_he_face;
+        std::vector<HeIndex> m_he_next;
+        std::vector<HeIndex> m_he_previous;
+        std::vector<HeIndex> m_he_opposite;
+        std::vector<std::uint8_t> m_he_constrained;
+        // faces
+        std::vector<HeIndex> m_f_edge;
+        // free lists
+        std::vector<HeIndex> m_free_vertices;
+        std::vector<HeIndex> m_free_edges;
+        std::vector<HeIndex> m_free_faces;
+
+        auto newEdge(HeIndex v, HeIndex f) -> HeIndex
+        {
+            HeIndex e;
+            if (!m_free_edges.empty())
+            {
+                e = m_free_edges.back();
+                m_free_edges.pop_back();
+                m_he_vertex[e] = v;
+                m_he_face[e] = f;
+                m_he_next[e] = m_he_previous[e] = m_he_opposite[e] = he_null;
+                m_he_constrained[e] = false;
+            }
+            else
+            {
+                e = static_cast<HeIndex>(m_he_vertex.size());
+                m_he_vertex.push_back(v);
+                m_he_face.push_back(f);
+                m_he_next.push_back(he_null);
+                m_he_previous.push_back(he_null);
+                m_he_opposite.push_back(he_null);
+                m_he_constrained.push_back(false);
+            }
+            if (m_v_edge[v] == he_null)
+            {
+                m_v_edge[v] = e;
+            }
+            return e;
+        }
+
+        auto newFace() -> HeIndex
+        {
+            if (!m_free_faces.empty())
+            {
+                auto f = m_free_faces.back();
+                m_free_faces.pop_back();
+                return f;
+            }
+            m_f_edge.push_back(he_null);
+            return static_cast<HeIndex>(m_f_edge.size() - 1);
+        }
+
+        auto releaseEdge(HeIndex e) -> void
+        {
+            auto opp = m_he_opposite[e];
+            if (opp != he_null && m_he_opposite[opp] == e)
+            {
+                m_he_opposite[opp] = he_null;
+            }
+            auto v = m_he_vertex[e];
+            if (m_v_edge[v] == e)
+            {
+                // another incoming half-edge, in a neighboring face, keeps the vertex attached
+                auto e_next = m_he_next[e];
+                auto opp_next = e_next != he_null ? m_he_opposite[e_next] : he_null;
+                if (opp != he_null && m_he_vertex[opp] != removed)
+                    m_v_edge[v] = m_he_previous[opp];
+                else if (opp_next != he_null && m_he_vertex[opp_next] != removed)
+                    m_v_edge[v] = opp_next;
+                else
+                    m_v_edge[v] = he_null;
+            }
+            m_he_vertex[e] = removed;
+            m_he_face[e] = m_he_next[e] = m_he_previous[e] = m_he_opposite[e] = he_null;
+            m_free_edges.push_back(e);
+        }
+
+    public:
+        CompactHalfEdgeMesh() = default;
+        /**
+         * @brief Reserves the arrays' capacities
+         *
+         * @param n_vertices
+         * @param n_faces : number of triangles, three half-edges are reserved per face
+         */
+        auto reserve(size_t n_vertices, size_t n_faces) -> void
+        {
+            m_coords.reserve(n_vertices);
+            m_v_edge.reserve(n_vertices);
+            for (auto *a : {&m_he_vertex, &m_he_face, &m_he_next, &m_he_previous, &m_he_opposite})
+                a->reserve(3 * n_faces);
+            m_he_constrained.reserve(3 * n_faces);
+            m_f_edge.reserve(n_faces);
+        }
+
+        // ------------------------------------------------------------------ accessors
+
+        auto coords(HeIndex v) const -> const std::array<T, dim> & { return m_coords[v]; }
+        auto coords(HeIndex v) -> std::array<T, dim> & { return m_coords[v]; }
+        auto vertexEdge(HeIndex v) const -> HeIndex { return m_v_edge[v]; }
+        auto vertex(HeIndex e) const -> HeIndex { return m_he_vertex[e]; }
+        auto face(HeIndex e) const -> HeIndex { return m_he_face[e]; }
+        auto next(HeIndex e) const -> HeIndex { return m_he_next[e]; }
+        auto previous(HeIndex e) const -> HeIndex { return m_he_previous[e]; }
+        auto opposite(HeIndex e) const -> HeIndex { return m_he_opposite[e]; }
+        auto faceEdge(HeIndex f) const -> HeIndex { return m_f_edge[f]; }
+        auto constrained(HeIndex e) const -> bool { return m_he_constrained[e]; }
+        /**
+         * @brief Marks a half-edge as constrained, see HalfEdge::constrained, its opposite is not marked
+         */
+        auto setConstrained(HeIndex e, bool constrained = true) -> void { m_he_constrained[e] = constrained; }
+        /**
+         * @brief Vertex the half-edge starts from
+         */
+        auto tail(HeIndex e) const -> HeIndex { return m_he_vertex[m_he_previous[e]]; }
+
+        auto isVertex(HeIndex v) const -> bool { return v < m_v_edge.size() && m_v_edge[v] != removed; }
+        auto isEdge(HeIndex e) const -> bool { return e < m_he_vertex.size() && m_he_vertex[e] != removed; }
+        auto isFace(HeIndex f) const -> bool { return f < m_f_edge.size() && m_f_edge[f] != he_null; }
+
+        auto nVertices() const -> size_t { return m_v_edge.size() - m_free_vertices.size(); }
+        auto nEdges() const -> size_t { return m_he_vertex.size() - m_free_edges.size(); }
+        auto nFaces() const -> size_t { return m_f_edge.size() - m_free_faces.size(); }
+        /**
+         * @brief Indices of the faces in use
+         *
+         * @return std::vector<HeIndex>
+         */
+        auto faces() const -> std::vector<HeIndex>
+        {
+            std::vector<HeIndex> f_lst;
+            f_lst.reserve(nFaces());
+            for (HeIndex f{}; f < m_f_edge.size(); f++)
+                if (m_f_edge[f] != he_null)
+                    f_lst.push_back(f);
+            return f_lst;
+        }
+        /**
+         * @brief Indices of the vertices in use
+         *
+         * @return std::vector<HeIndex>
+         */
+        auto vertices() const -> std::vector<HeIndex>
+        {
+            std::vector<HeIndex> v_lst;
+            v_lst.reserve(nVertices());
+            for (HeIndex v{}; v < m_v_edge.size(); v++)
+                if (m_v_edge[v] != removed)
+                    v_lst.push_back(v);
+            return v_lst;
+        }
+
+        // ------------------------------------------------------------------ getters, see halfEdgeMeshGetters.h
+
+        /**
+         * @brief Half-edge of a face ending at a given vertex, he_null if not found
+         */
+        auto getFaceEdge(HeIndex f, HeIndex v) const -> HeIndex
+        {
+            auto e = m_f_edge[f];
+            while (m_he_vertex[e] != v)
+            {
+                e = m_he_next[e];
+                if (e == m_f_edge[f])
+                    return he_null;
+            }
+            return e;
+        }
+        /**
+         * @brief The three half-edges of a triangle, in the order of getTriangleEdges
+         */
+        auto getTriangleEdges(HeIndex f) const -> std::array<HeIndex, 3>
+        {
+            auto e = m_f_edge[f];
+            assert(m_he_next[m_he_next[m_he_next[e]]] == e);
+            return {m_he_next[e], e, m_he_previous[e]};
+        }
+
+        auto getFaceEdges(HeIndex f) const -> std::vector<HeIndex>
+        {
+            std::vector<HeIndex> e_lst;
+            auto start = m_f_edge[f];
+            auto e = start;
+            do
+            {
+                e_lst.push_back(e);
+                e = m_he_next[e];
+            } while (e != start && e != he_null);
+            return e_lst;
+        }
+
+        auto getFaceVertices(HeIndex f) const -> std::vector<HeIndex>
+        {
+            auto e_lst = getFaceEdges(f);
+            std::vector<HeIndex> v_lst(e_lst.size());
+            std::transform(e_lst.begin(), e_lst.end(), v_lst.begin(), [this](HeIndex e) { return m_he_vertex[e]; });
+            return v_lst;
+        }
+
+        auto getTriangleVertices(HeIndex f) const -> std::array<HeIndex, 3>
+        {
+            auto [e1, e2, e3] = getTriangleEdges(f);
+            return {m_he_vertex[e1], m_he_vertex[e2], m_he_vertex[e3]};
+        }
+
+        auto getFaceCoords(HeIndex f) const -> std::vector<std::array<T, dim>>
+        {
+            auto v_lst = getFaceVertices(f);
+            std::vector<std::array<T, dim>> x_lst(v_lst.size());
+            std::transform(v_lst.begin(), v_lst.end(), x_lst.begin(), [this](HeIndex v) { return m_coords[v]; });
+            return x_lst;
+        }
+
+        auto getTriangleCoords(HeIndex f) const -> std::array<std::array<T, dim>, 3>
+        {
+            auto [v1, v2, v3] = getTriangleVertices(f);
+            return {m_coords[v1], m_coords[v2], m_coords[v3]};
+        }
+        /**
+         * @brief Half-edge of f1 whose opposite lies in f2, he_null if the faces aren't adjacent
+         */
+        auto getCommonEdge(HeIndex f1, HeIndex f2) const -> HeIndex
+        {
+            for (auto e : getFaceEdges(f1))
+                if (m_he_opposite[e] != he_null && m_he_face[m_he_opposite[e]] == f2)
+                    return e;
+            return he_null;
+        }
+
+        auto getCommonEdges(HeIndex f1, HeIndex f2) const -> std::pair<HeIndex, HeIndex>
+        {
+            auto e = getCommonEdge(f1, f2);
+            return e != he_null ? std::make_pair(e, m_he_opposite[e]) : std::make_pair(he_null, he_null);
+        }
+
+        auto getPreviousFace(HeIndex e) const -> HeIndex
+        {
+            auto opp = m_he_next[e] != he_null ? m_he_opposite[m_he_next[e]] : he_null;
+            return opp != he_null ? m_he_face[opp] : he_null;
+        }
+
+        auto getNextFace(HeIndex e) const -> HeIndex
+        {
+            auto opp = m_he_opposite[e];
+            return opp != he_null ? m_he_face[opp] : he_null;
+        }
+        /**
+         * @brief Faces around a vertex, ordered as getFacesAttachedToVertex does
+         */
+        auto getFacesAttachedToVertex(HeIndex v) const -> std::list<HeIndex>
+        {
+            auto start = m_v_edge[v];
+            assert(start != he_null);
+            std::list<HeIndex> neighbors;
+            auto current = start;
+            do
+            {
+                neighbors.push_front(m_he_face[current]);
+                current = m_he_opposite[current] != he_null ? m_he_previous[m_he_opposite[current]] : he_null;
+            } while (current != he_null && current != start);
+
+            if (current != start && m_he_opposite[m_he_next[start]] != he_null)
+            {
+                current = m_he_opposite[m_he_next[start]];
+                do
+                {
+                    neighbors.push_back(m_he_face[current]);
+                    current = m_he_opposite[m_he_next[current]];
+                } while (current != he_null && current != start);
+            }
+            return neighbors;
+        }
+
+        auto getNeighboringFaces(HeIndex f) const -> std::list<HeIndex>
+        {
+            std::list<HeIndex> neighbors;
+            for (auto e : getFaceEdges(f))
+                if (m_he_opposite[e] != he_null)
+                    neighbors.push_back(m_he_face[m_he_opposite[e]]);
+            return neighbors;
+        }
+
+        auto getNeighboringVertices(HeIndex v) const -> std::list<HeIndex>
+        {
+            auto start = m_v_edge[v];
+            auto current = start;
+            std::list<HeIndex> neighbors{tail(start)};
+            // through incoming half-edges
+            while (m_he_opposite[current] != he_null)
+            {
+                current = m_he_previous[m_he_opposite[current]];
+                if (current == start)
+                    return neighbors;
+                neighbors.push_front(tail(current));
+            }
+            // open fan, the other way through outgoing half-edges
+            current = m_he_next[start];
+            neighbors.push_back(m_he_vertex[current]);
+            while (m_he_opposite[current] != he_null)
+            {
+                current = m_he_next[m_he_opposite[current]];
+                neighbors.push_back(m_he_vertex[current]);
+            }
+            return neighbors;
+        }
+        /**
+         * @brief Half-edges of the faces whose opposite isn't in the faces
+         */
+        template <typename Container>
+        auto getFacesBoundary(const Container &f_lst) const -> std::list<HeIndex>
+        {
+            std::unordered_set<HeIndex> f_set(f_lst.begin(), f_lst.end());
+            std::list<HeIndex> boundary;
+            for (auto f : f_lst)
+                for (auto e : getFaceEdges(f))
+                    if (m_he_opposite[e] == he_null || !f_set.contains(m_he_face[m_he_opposite[e]]))
+                        boundary.push_back(e);
+            return boundary;
+        }
+
+        auto getEdgePoint(HeIndex e, T pos = 0.5) const -> std::array<T, dim>
+        {
+            const auto &p1 = m_coords[tail(e)];
+            const auto &p2 = m_coords[m_he_vertex[e]];
+            return p1 + pos * (p2 - p1);
+        }
+
+        auto edgeMidpoint(HeIndex e) const -> std::array<T, dim>
+        {
+            return static_cast<T>(0.5) * (m_coords[tail(e)] + m_coords[m_he_vertex[e]]);
+        }
+
+        auto edgeSqLength(HeIndex e) const -> T
+        {
+            return sq_norm(m_coords[m_he_vertex[e]] - m_coords[tail(e)]);
+        }
+
+        // ------------------------------------------------------------------ editors, see halfEdgeMeshEditors.h
+
+        /**
+         * @brief Adds a free vertex
+         *
+         * @param coords
+         * @return HeIndex
+         */
+        auto addVertex(const std::array<T, dim> &coords) -> HeIndex
+        {
+            if (!m_free_vertices.empty())
+            {
+                auto v = m_free_vertices.back();
+                m_free_vertices.pop_back();
+                m_coords[v] = coords;
+                m_v_edge[v] = he_null;
+                return v;
+            }
+            m_coords.push_back(coords);
+            m_v_edge.push_back(he_null);
+            return static_cast<HeIndex>(m_coords.size() - 1);
+        }
+        /**
+         * @brief Removes a vertex no half-edge points to anymore
+         *
+         * @param v
+         */
+        auto removeVertex(HeIndex v) -> void
+        {
+            assert(m_v_edge[v] == he_null);
+            m_v_edge[v] = removed;
+            m_free_vertices.push_back(v);
+        }
+        /**
+         * @brief Adds a face looping through the given vertices, opposites are not linked, see linkEdges and linkOpposites
+         *
+         * @param v_lst : face's vertices
+         * @return HeIndex
+         */
+        auto addFace(const std::vector<HeIndex> &v_lst) -> HeIndex
+        {
+            assert(v_lst.size() > 1);
+            auto f = newFace();
+            std::vector<HeIndex> e_lst(v_lst.size());
+            std::transform(v_lst.begin(), v_lst.end(), e_lst.begin(), [&](HeIndex v) { return newEdge(v, f); });
+            makeLoop(e_lst, f);
+            return f;
+        }
+        /**
+         * @brief Adds a triangle on a boundary half-edge, linked to it, like add_face
+         *
+         * @param e      : boundary half-edge
+         * @param coords : coordinates of the new triangle's third vertex
+         * @return HeIndex the new face or he_null if e already has an opposite
+         */
+        auto addFace(HeIndex e, const std::array<T, dim> &coords) -> HeIndex
+        {
+            if (e == he_null || m_he_opposite[e] != he_null)
+                return he_null;
+            auto v = addVertex(coords);
+            auto f = addFace({m_he_vertex[e], tail(e), v});
+            linkEdges(e, m_he_next[m_f_edge[f]]);
+            return f;
+        }
+        /**
+         * @brief Sets face and next/previous links of a loop of half-edges
+         */
+        auto makeLoop(const std::vector<HeIndex> &e_lst, HeIndex f) -> void
+        {
+            auto n = e_lst.size();
+            m_f_edge[f] = e_lst.front();
+            for (size_t i{}; i < n; i++)
+            {
+                m_he_face[e_lst[i]] = f;
+                chainEdges(e_lst[i], e_lst[(i + 1) % n]);
+            }
+        }
+
+        auto associate(HeIndex v, HeIndex e) -> void
+        {
+            m_he_vertex[e] = v;
+            m_v_edge[v] = e;
+        }
+
+        auto linkEdges(HeIndex e1, HeIndex e2) -> void
+        {
+            m_he_opposite[e1] = e2;
+            m_he_opposite[e2] = e1;
+        }
+
+        auto chainEdges(HeIndex e1, HeIndex e2) -> void
+        {
+            m_he_next[e1] = e2;
+            m_he_previous[e2] = e1;
+        }
+        /**
+         * @brief Links all the unlinked half-edges with their reversed twins
+         */
+        auto linkOpposites() -> void
+        {
+            std::unordered_map<std::uint64_t, HeIndex> edges_map;
+            edges_map.reserve(nEdges());
+            auto key = [](HeIndex v1, HeIndex v2) { return (std::uint64_t(v1) << 32) | v2; };
+            for (HeIndex e{}; e < m_he_vertex.size(); e++)
+                if (m_he_vertex[e] != removed && m_he_opposite[e] == he_null)
+                    edges_map[key(tail(e), m_he_vertex[e])] = e;
+            for (auto [k, e] : edges_map)
+            {
+                if (m_he_opposite[e] != he_null)
+                    continue;
+                auto it = edges_map.find(key(m_he_vertex[e], tail(e)));
+                if (it != edges_map.end())
+                    linkEdges(e, it->second);
+            }
+        }
+        /**
+         * @brief Flips the common edge of two adjacent triangles, see flip
+         */
+        auto flip(HeIndex f1, HeIndex f2) -> void
+        {
+            auto [e1_1, e1_2] = getCommonEdges(f1, f2);
+            if (e1_1 == he_null || e1_2 == he_null)
+                return;
+            auto e2_1 = m_he_next[e1_1];
+            auto e3_1 = m_he_next[e2_1];
+            auto e2_2 = m_he_next[e1_2];
+            auto e3_2 = m_he_next[e2_2];
+
+            auto v1 = m_he_vertex[e1_1];
+            auto v2 = m_he_vertex[e2_1];
+            auto v3 = m_he_vertex[e3_1];
+            auto v4 = m_he_vertex[e2_2];
+            // common edge's ends lose an incoming half-edge
+            if (m_v_edge[v1] == e1_1)
+                m_v_edge[v1] = e3_2;
+            if (m_v_edge[v3] == e1_2)
+                m_v_edge[v3] = e3_1;
+
+            associate(v4, e1_1);
+            associate(v2, e1_2);
+
+            makeLoop({e1_1, e3_2, e2_1}, f1);
+            makeLoop({e1_2, e3_1, e2_2}, f2);
+        }
+        /**
+         * @brief Fills a closed ccw loop of boundary half-edges with a fan of triangles around a vertex, see add_vertex.
+         * The cavity's faces, i.e. the ones owning the boundary half-edges and the ones reached from them without crossing
+         * the boundary, are released with their other half-edges.
+         *
+         * @param boundary : closed loop of half-edges
+         * @param v        : fan's center
+         * @return std::vector<HeIndex> the new faces, one per boundary half-edge
+         */
+        auto addVertex(const std::vector<HeIndex> &boundary, HeIndex v) -> std::vector<HeIndex>
+        {
+            std::vector<HeIndex> tails(boundary.size());
+            std::transform(boundary.begin(), boundary.end(), tails.begin(), [this](HeIndex e) { return tail(e); });
+            std::unordered_set<HeIndex> b_set(boundary.begin(), boundary.end());
+            std::unordered_set<HeIndex> old_faces;
+            std::vector<HeIndex> stack;
+            for (auto e : boundary)
+                if (old_faces.insert(m_he_face[e]).second)
+                    stack.push_back(m_he_face[e]);
+            while (!stack.empty())
+            {
+                auto f = stack.back();
+                stack.pop_back();
+                for (auto e : getFaceEdges(f))
+                {
+                    auto opp = m_he_opposite[e];
+                    if (!b_set.contains(e) && opp != he_null && old_faces.insert(m_he_face[opp]).second)
+                        stack.push_back(m_he_face[opp]);
+                }
+            }
+            for (auto f : old_faces)
+            {
+                for (auto e : getFaceEdges(f))
+                    if (!b_set.contains(e))
+                        releaseEdge(e);
+                m_f_edge[f] = he_null;
+                m_free_faces.push_back(f);
+            }
+
+            m_v_edge[v] = he_null;
+            std::vector<HeIndex> f_lst;
+            f_lst.reserve(boundary.size());
+            auto e_prev = he_null;
+            for (size_t i{}; i < boundary.size(); i++)
+            {
+                auto e = boundary[i];
+                auto f = newFace();
+                auto e1 = newEdge(v, f);
+                auto e2 = newEdge(tails[i], f);
+                if (e_prev != he_null)
+                    linkEdges(e2, e_prev);
+                e_prev = e1;
+                m_v_edge[m_he_vertex[e]] = e;
+                makeLoop({e, e1, e2}, f);
+                f_lst.push_back(f);
+            }
+            linkEdges(m_he_next[m_f_edge[f_lst.back()]], m_he_previous[m_f_edge[f_lst.front()]]);
+            return f_lst;
+        }
+        /**
+         * @brief Splits a face into a fan of triangles around a vertex
+         */
+        auto addVertex(HeIndex f, HeIndex v) -> std::vector<HeIndex>
+        {
+            return addVertex(getFaceEdges(f), v);
+        }
+        /**
+         * @brief Removes a face, its half-edges' opposites become boundary half-edges, see eraseFace
+         */
+        auto eraseFace(HeIndex f) -> void
+        {
+            for (auto e : getFaceEdges(f))
+                releaseEdge(e);
+            m_f_edge[f] = he_null;
+            m_free_faces.push_back(f);
+        }
+        /**
+         * @brief Removes the faces around a vertex, see remove_faces
+         *
+         * @return size_t removed faces' number
+         */
+        auto removeFaces(HeIndex v) -> size_t
+        {
+            if (m_v_edge[v] == he_null)
+                return 0;
+            auto f_lst = getFacesAttachedToVertex(v);
+            for (auto f : f_lst)
+                eraseFace(f);
+            m_v_edge[v] = he_null;
+            return f_lst.size();
+        }
+        /**
+         * @brief Splits a half-edge at its midpoint, as well as its opposite, each triangle is split in two, see splitHalfEdge
+         *
+         * @param e
+         * @return HeIndex the new vertex
+         */
+        auto splitHalfEdge(HeIndex e) -> HeIndex
+        {
+            auto e_prev = m_he_previous[e];
+            auto e_next = m_he_next[e];
+            auto e_opp = m_he_opposite[e];
+            auto f = m_he_face[e];
+            auto v_new = addVertex(edgeMidpoint(e));
+            // reduce existing face
+            auto e1 = newEdge(v_new, f);
+            m_f_edge[f] = e1;
+            chainEdges(e1, e);
+            chainEdges(e_next, e1);
+            // new face
+            auto f_new = newFace();
+            auto e2 = newEdge(v_new, f_new);
+            auto e3 = newEdge(m_he_vertex[e_next], f_new);
+            linkEdges(e1, e3);
+            makeLoop({e2, e3, e_prev}, f_new);
+            m_he_constrained[e2] = m_he_constrained[e];
+
+            if (e_opp != he_null)
+            {
+                auto e_opp_prev = m_he_previous[e_opp];
+                auto e_opp_next = m_he_next[e_opp];
+                auto f_opp = m_he_face[e_opp];
+                m_v_edge[m_he_vertex[e_opp]] = e_prev;
+                m_he_vertex[e_opp] = v_new;
+                // reduce existing face
+                auto e1_opp = newEdge(m_he_vertex[e_opp_next], f_opp);
+                m_f_edge[f_opp] = e1_opp;
+                chainEdges(e_opp, e1_opp);
+                chainEdges(e1_opp, e_opp_prev);
+                // new opposite face
+                auto f_opp_new = newFace();
+                auto e2_opp = newEdge(v_new, f_opp_new);
+                auto e3_opp = newEdge(m_he_vertex[e_prev], f_opp_new);
+                linkEdges(e1_opp, e2_opp);
+                linkEdges(e2, e3_opp);
+                m_he_constrained[e3_opp] = m_he_constrained[e_opp];
+                makeLoop({e2_opp, e3_opp, e_opp_next}, f_opp_new);
+            }
+            return v_new;
+        }
+    };
+
+/**
+ * @brief Builds a compact mesh from faces of the shared_ptr structure, links are kept
+ *
+ * @tparam T Numeric type of the vertex coordinates
+ * @tparam dim Dimension of the vertex coordinates (2 or 3)
+ * @param faces_lst Container of shared pointers to faces
+ * @return CompactHalfEdgeMesh<T, dim>
+ */
+    template <std::floating_point T, size_t dim>
+    auto make_compact_h_mesh(const auto &faces_lst) -> CompactHalfEdgeMesh<T, dim>
+    {
+        using SharedVertex = std::shared_ptr<HalfEdgeVertex<T, dim>>;
+        using SharedEdge = std::shared_ptr<HalfEdge<T, dim>>;
+        std::unordered_map<SharedVertex, HeIndex> vertices_map;
+        std::unordered_map<SharedEdge, HeIndex> edges_map;
+        std::vector<SharedVertex> vertices;
+        std::vector<SharedEdge> edges;
+        CompactHalfEdgeMesh<T, dim> msh;
+
+        for (const auto &h_f : faces_lst)
+        {
+            std::vector<HeIndex> v_lst;
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                auto [it, inserted] = vertices_map.try_emplace(h_e->vertex, static_cast<HeIndex>(vertices.size()));
+                if (inserted)
+                {
+                    vertices.push_back(h_e->vertex);
+                    msh.addVertex(h_e->vertex->coords);
+                }
+                v_lst.push_back(it->second);
+                edges_map[h_e] = static_cast<HeIndex>(edges.size());
+                edges.push_back(h_e);
+            }
+            msh.addFace(v_lst);
+        }
+        // half-edges were created in the same order
+        for (HeIndex e{}; e < edges.size(); e++)
+        {
+            msh.setConstrained(e, edges[e]->constrained);
+            auto it = edges[e]->opposite ? edges_map.find(edges[e]->opposite) : edges_map.end();
+            if (it != edges_map.end())
+                msh.linkEdges(e, it->second);
+        }
+        for (HeIndex v{}; v < vertices.size(); v++)
+        {
+            auto it = vertices[v]->edge ? edges_map.find(vertices[v]->edge) : edges_map.end();
+            if (it != edges_map.end())
+                msh.associate(v, it->second);
+        }
+        return msh;
+    }
+
+/**
+ * @brief Builds faces of the shared_ptr structure from a compact mesh, links are kept
+ *
+ * @tparam T Numeric type of the vertex coordinates
+ * @tparam dim Dimension of the vertex coordinates (2 or 3)
+ * @param msh The compact mesh
+ * @return std::list<std::shared_ptr<HalfEdgeFace<T, dim>>>
+ */
+    template <std::floating_point T, size_t dim>
+    auto to_shared_h_faces(const CompactHalfEdgeMesh<T, dim> &msh) -> std::list<std::shared_ptr<HalfEdgeFace<T, dim>>>
+    {
+        std::unordered_map<HeIndex, std::shared_ptr<HalfEdgeVertex<T, dim>>> vertices;
+        std::unordered_map<HeIndex, std::shared_ptr<HalfEdge<T, dim>>> edges;
+        std::list<std::shared_ptr<HalfEdgeFace<T, dim>>> faces_lst;
+        for (auto v : msh.vertices())
+            vertices[v] = make_shared_h_vertex<T, dim>(msh.coords(v));
+        for (auto f : msh.faces())
+        {
+            std::vector<std::shared_ptr<HalfEdge<T, dim>>> e_lst;
+            for (auto e : msh.getFaceEdges(f))
+            {
+                e_lst.push_back(make_shared_h_edge<T, dim>(vertices[msh.vertex(e)]));
+                e_lst.back()->constrained = msh.constrained(e);
+                edges[e] = e_lst.back();
+            }
+            faces_lst.push_back(make_shared_h_face<T, dim>(e_lst));
+        }
+        for (auto &[e, h_e] : edges)
+        {
+            auto opp = msh.opposite(e);
+            if (opp != he_null)
+                h_e->opposite = edges[opp];
+        }
+        for (auto &[v, h_v] : vertices)
+        {
+            auto e = msh.vertexEdge(v);
+            if (e != he_null)
+                h_v->edge = edges[e];
+        }
+        return faces_lst;
+    }
+}
@@ -54,6 +54,7 @@ namespace gbs
         std::shared_ptr<HalfEdge<T, dim>> next{nullptr}; ///< Next half-edge along the boundary of the face
         std::shared_ptr<HalfEdge<T, dim>> previous{nullptr}; ///< Previous half-edge along the boundary of the face
         std::shared_ptr<HalfEdge<T, dim>> opposite{nullptr}; ///< Opposite half-edge (pointing in the opposite direction)
+        bool constrained{false}; ///< Constrained edge, neither crossed nor flipped by Delaunay operations
 
         // HalfEdge(const std::array<T, dim> &coords) : vertex{std::make_shared<HalfEdgeVertex<T, dim>>({coords, this})} {}
         ///< Constructor for creating a HalfEdge object from vertex coordinates
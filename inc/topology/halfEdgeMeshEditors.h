@@ -1,8 +1,10 @@
 #pragma once
 #include "halfEdgeMeshData.h"
 #include "halfEdgeMeshGetters.h"
+#include "halfEdgeMeshGeomTests.h"
 
 #include <list>
+#include <unordered_set>
 #include <algorithm>
 #include <execution>
 #include <random>
@@ -138,6 +140,9 @@ namespace gbs
 
         associate(h_v4, h_e1_1);
         associate(h_v2, h_e1_2);
+        // The shared edge's former vertices keep a valid half-edge
+        associate(h_v1, h_e3_2);
+        associate(h_v3, h_e3_1);
 
         std::list<std::shared_ptr<HalfEdge<T, dim>>> lst1{h_e1_1, h_e3_2, h_e2_1};
         std::list<std::shared_ptr<HalfEdge<T, dim>>> lst2{h_e1_2, h_e3_1, h_e2_2};
@@ -302,11 +307,11 @@ namespace gbs
     template <std::floating_point T, size_t dim>
     auto remove_faces(auto &faces_lst, const std::shared_ptr<HalfEdgeVertex<T, dim>> &vtx) -> size_t
     {
-        size_t count{};
+        std::unordered_set<HalfEdgeFace<T, dim> *> removed;
 
         faces_lst.erase(
             std::remove_if(faces_lst.begin(), faces_lst.end(),
-                [&vtx, &count](const auto &face)
+                [&vtx, &removed](const auto &face)
                 {
                     auto h_e_lst = getFaceEdges(face);
                     auto it = std::find_if(h_e_lst.begin(), h_e_lst.end(),
@@ -315,21 +320,29 @@ namespace gbs
 
                     if (h_e_lst.end() != it)
                     {
-                        for (auto &h_e : h_e_lst) // no more opposite on adjacent faces
-                        {
-                            if (h_e->opposite)
-                            {
-                                h_e->opposite->opposite = nullptr;
-                            }
-                        }
-                        count++;
+                        removed.insert(face.get());
                         return true;
                     }
                     return false;
                 }),
         faces_lst.end());
 
-        return count;
+        // no more opposite on adjacent faces, whose vertices keep a valid half-edge
+        for (auto h_f : removed)
+        {
+            for (const auto &h_e : getFaceEdges(*h_f))
+            {
+                if (h_e->opposite && !removed.contains(h_e->opposite->face.get()))
+                {
+                    auto h_e_kept = h_e->opposite;
+                    h_e_kept->opposite = nullptr;
+                    h_e_kept->vertex->edge = h_e_kept;
+                    h_e_kept->previous->vertex->edge = h_e_kept->previous;
+                }
+            }
+        }
+
+        return removed.size();
     }
 /**
  * @brief Extracts and separates closed loops from a list of half-edges.
@@ -470,6 +483,48 @@ namespace gbs
         return internal_faces;
     }
 
+/**
+ * @brief Removes and returns the faces matching a predicate.
+ *
+ * The remaining faces' half-edges are unlinked from the removed faces and their vertices keep a valid half-edge,
+ * whereas the removed faces stay linked together.
+ *
+ * @tparam _Container The container type for the list of faces.
+ * @tparam _Pred A callable object type, taking a face's shared pointer and returning true if the face has to be removed.
+ * @param faces_lst List of faces to search and remove faces from.
+ * @param pred The predicate.
+ * @return std::list of the removed faces.
+ */
+    template <typename _Container, typename _Pred>
+    auto takeFaces(_Container &faces_lst, const _Pred &pred)
+    {
+        std::list<typename _Container::value_type> taken_faces;
+        std::erase_if(faces_lst, [&](const auto &h_f) {
+            if (pred(h_f))
+            {
+                taken_faces.push_back(h_f);
+                return true;
+            }
+            return false;
+        });
+
+        for (const auto &h_f : taken_faces)
+        {
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                if (h_e->opposite && !pred(h_e->opposite->face))
+                {
+                    auto h_e_kept = h_e->opposite;
+                    h_e_kept->opposite = nullptr;
+                    h_e_kept->vertex->edge = h_e_kept;
+                    h_e_kept->previous->vertex->edge = h_e_kept->previous;
+                }
+            }
+        }
+
+        return taken_faces;
+    }
+
 /**
  * @brief Reverses the order of a given boundary, along with swapping the previous and next half-edges.
  * 
@@ -499,6 +554,7 @@ namespace gbs
      * The function reduces the original face associated with the input half-edge and creates a new face
      * while updating the provided face list. It also accounts for the case when the input half-edge has
      * an opposite half-edge, creating a new face for the opposite side as well.
+     * Both halves of a constrained half-edge are constrained.
      *
      * @tparam T Numeric type of the vertex coordinates
      * @tparam dim Dimension of the vertex coordinates (2 or 3)
@@ -524,14 +580,14 @@ namespace gbs
         //     new_pt = ( a +b + c + d) / static_cast<T>(4);
         // }
         auto new_vertex = make_shared_h_vertex( new_pt );
-        new_vertex->edge = he;
-        auto new_he1    = make_shared_h_edge(new_vertex, hf);
+        auto new_he1    = make_shared_h_edge(new_vertex, hf); // new vertex's edge
         hf->edge=new_he1;
         chain_edges(new_he1,he);
         chain_edges(he_next, new_he1);
 
         // create new face
         auto new_he2    = make_shared_h_edge(new_vertex);
+        new_he2->constrained = he->constrained;
         auto new_he3    = make_shared_h_edge(he_next->vertex);
         link_edges(new_he1, new_he3);
         auto new_hf1_ed_lst = {new_he2,new_he3, he_prev};
@@ -554,7 +610,9 @@ namespace gbs
             // create new opp face
             auto new_he2_opp    = make_shared_h_edge(new_vertex);
             auto new_he3_opp    = make_shared_h_edge(he_prev->vertex);
+            new_he3_opp->constrained = he_opp->constrained;
             link_edges(new_he1_opp, new_he2_opp);
+            link_edges(new_he2, new_he3_opp);
             auto new_hf1_opp_ed_lst = {new_he2_opp,new_he3_opp, he_opp_next};
             auto new_hf1_opp = make_shared_h_face<T,dim>(new_hf1_opp_ed_lst);
 
@@ -565,4 +623,73 @@ namespace gbs
         return new_vertex;
     }
 
+/**
+ * @brief Collapses a half-edge of a triangle mesh, its start vertex is merged into its end vertex.
+ *
+ * Both triangles sharing the edge are removed, their other half-edges' opposites are linked together,
+ * the linked half-edges are constrained if either of them was.
+ * The merged vertex is left without half-edge, the link condition has to be checked beforehand:
+ * the edge's ends must have no other common neighbor than the triangles' third vertices.
+ *
+ * @tparam T Numeric type of the vertex coordinates
+ * @tparam dim Dimension of the vertex coordinates (2 or 3)
+ * @param he Shared pointer to the half-edge to be collapsed, it must have an opposite
+ * @return std::array of the two removed faces
+ */
+    template <std::floating_point T, size_t dim>
+    auto collapseHalfEdge(const std::shared_ptr<HalfEdge<T, dim>> &he) -> std::array<std::shared_ptr<HalfEdgeFace<T, dim>>, 2>
+    {
+        auto he_opp = he->opposite;
+        assert(he_opp);
+        assert(he->next->next->next == he && he_opp->next->next->next == he_opp);
+        auto h_a = he->previous->vertex;
+        auto h_b = he->vertex;
+        auto h_c = he->next->vertex;
+        auto h_d = he_opp->next->vertex;
+        std::array<std::shared_ptr<HalfEdgeFace<T, dim>>, 2> removed{he->face, he_opp->face};
+
+        auto incoming = getIncomingEdges(h_a);
+        // opposites of the removed triangles' other half-edges
+        auto h_cb = he->next->opposite;
+        auto h_ac = he->previous->opposite;
+        auto h_da = he_opp->next->opposite;
+        auto h_bd = he_opp->previous->opposite;
+
+        for (const auto &h_e : incoming)
+        {
+            h_e->vertex = h_b;
+        }
+
+        auto link = [](const auto &h_e1, const auto &h_e2) {
+            auto constrained = (h_e1 && h_e1->constrained) || (h_e2 && h_e2->constrained);
+            if (h_e1)
+            {
+                h_e1->opposite = h_e2;
+                h_e1->constrained = constrained;
+            }
+            if (h_e2)
+            {
+                h_e2->opposite = h_e1;
+                h_e2->constrained = constrained;
+            }
+        };
+        link(h_cb, h_ac);
+        link(h_da, h_bd);
+
+        // the vertices keep a half-edge out of the removed faces
+        auto is_kept = [&removed](const auto &h_e) { return h_e && h_e->face != removed[0] && h_e->face != removed[1]; };
+        h_b->edge = is_kept(h_cb) ? h_cb : is_kept(h_da) ? h_da : nullptr;
+        for (const auto &h_e : incoming)
+        {
+            if (!h_b->edge && is_kept(h_e))
+            {
+                h_b->edge = h_e;
+            }
+        }
+        h_c->edge = h_ac ? h_ac : h_cb ? h_cb->previous : nullptr;
+        h_d->edge = h_bd ? h_bd : h_da ? h_da->previous : nullptr;
+        h_a->edge = nullptr;
+
+        return removed;
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "halfEdgeMeshData.h"
 #include "baseGeom.h"
+#include "baseIntersection.h"
 
 namespace gbs
 {
@@ -87,10 +88,14 @@ namespace gbs
                 return true;
             }
             
-            // Check if the segment intersects with the half-open line segment
-            if (seg_H_strict_end_intersection(a, b, xy, tol))
+            // Check if the edge crosses the rightward horizontal ray, edges being half-open in y and the side test exact
+            if ((a[1] <= xy[1]) != (b[1] <= xy[1]))
             {
-                count++;
+                auto side = orient_2d(a, b, xy);
+                if (b[1] > a[1] ? side > 0 : side < 0)
+                {
+                    count++;
+                }
             }
         }
 
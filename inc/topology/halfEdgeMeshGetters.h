@@ -2,6 +2,8 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include "halfEdgeMeshData.h"
 #include "baseGeom.h"
 #include <gbs/surfaces>
@@ -358,6 +360,42 @@ namespace gbs
         return neighbors;
     }
 
+/**
+ * @brief Gets the half-edges ending at a given vertex, ordered as getFacesAttachedToVertex's faces.
+ * 
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Dimension of the half-edge data structure.
+ * @param h_v Shared pointer to the vertex.
+ * @return auto List of shared pointers to the incoming half-edges.
+ */
+    template <std::floating_point T, size_t dim>
+    auto getIncomingEdges(const std::shared_ptr<HalfEdgeVertex<T, dim>> &h_v)
+    {
+        assert(h_v->edge);
+
+        std::list<std::shared_ptr<HalfEdge<T, dim>>> edges;
+        auto start = h_v->edge;
+
+        auto current = start;
+        do
+        {
+            edges.push_front(current);
+            current = current->opposite ? current->opposite->previous : nullptr;
+        } while (current && current != start);
+
+        if (current != start && start->next->opposite)
+        {
+            current = start->next->opposite;
+            do
+            {
+                edges.push_back(current);
+                current = current->next->opposite;
+            } while (current && current != start);
+        }
+
+        return edges;
+    }
+
 /**
  * @brief Gets the list of neighboring faces of a given face.
  * 
@@ -383,6 +421,35 @@ namespace gbs
         return neighbors;
     }
 
+/**
+ * @brief Gets the faces connected to a given face through opposite half-edges, the face included.
+ * 
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Dimension of the half-edge data structure.
+ * @param h_f Shared pointer to the starting face.
+ * @return auto List of shared pointers to the connected faces, in breadth-first order.
+ */
+    template <std::floating_point T, size_t dim>
+    auto getConnectedFaces(const std::shared_ptr<HalfEdgeFace<T, dim>> &h_f)
+    {
+        std::list<std::shared_ptr<HalfEdgeFace<T, dim>>> faces{h_f};
+        std::unordered_set<HalfEdgeFace<T, dim> *> visited{h_f.get()};
+
+        // The list grows while being traversed
+        for (auto it = faces.begin(); it != faces.end(); ++it)
+        {
+            for (const auto &h_e : getFaceEdges(*it))
+            {
+                if (h_e->opposite && visited.insert(h_e->opposite->face.get()).second)
+                {
+                    faces.push_back(h_e->opposite->face);
+                }
+            }
+        }
+
+        return faces;
+    }
+
     template <std::floating_point T, size_t dim>
     auto getNeighboringVertices(const HalfEdgeVertex<T, dim> &h_v)
     {
@@ -482,30 +549,80 @@ namespace gbs
         return takeClosedLoops(boundary).front();
     }
 
+/**
+ * @brief Faces of a mesh as contiguous index arrays.
+ *
+ * Face i's vertices are vertices[indices[k]], for k in [offsets[i], offsets[i+1]).
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Dimension of the half-edge data structure.
+ */
+    template <std::floating_point T, size_t dim>
+    struct IndexedFaces
+    {
+        std::vector<std::shared_ptr<HalfEdgeVertex<T, dim>>> vertices; ///< Unique vertices, by order of appearance
+        std::vector<size_t> offsets{0};                                ///< Faces' first index in indices, followed by the total number of indices
+        std::vector<size_t> indices;                                   ///< Faces' vertices' indices
+    };
+
+/**
+ * @brief Indexes the vertices of a list of faces in a single pass, using a hash map.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Dimension of the half-edge data structure.
+ * @param faces_lst List of shared pointers to faces.
+ * @return IndexedFaces<T, dim> The vertices and the faces' indices.
+ */
+    template <std::floating_point T, size_t dim>
+    auto getIndexedFaces(const auto &faces_lst) -> IndexedFaces<T, dim>
+    {
+        IndexedFaces<T, dim> mesh;
+        auto n_faces = std::ranges::distance(faces_lst);
+        mesh.offsets.reserve(n_faces + 1);
+        mesh.indices.reserve(3 * n_faces);
+        mesh.vertices.reserve(n_faces / 2 + 3);
+        std::unordered_map<const HalfEdgeVertex<T, dim> *, size_t> indices;
+        indices.reserve(n_faces / 2 + 3);
+
+        for (const auto &f : faces_lst)
+        {
+            auto h_e = f->edge;
+            do
+            {
+                auto [it, inserted] = indices.try_emplace(h_e->vertex.get(), mesh.vertices.size());
+                if (inserted)
+                {
+                    mesh.vertices.push_back(h_e->vertex);
+                }
+                mesh.indices.push_back(it->second);
+                h_e = h_e->next;
+            } while (h_e != f->edge);
+            mesh.offsets.push_back(mesh.indices.size());
+        }
+
+        return mesh;
+    }
+
 /**
  * @brief Creates a map of unique vertices and their indices from a list of faces.
  * 
  * @tparam T Floating point type used for coordinates.
  * @tparam dim Dimension of the half-edge data structure.
  * @param faces_lst List of shared pointers to faces.
- * @return auto Map of shared pointers to HalfEdgeVertex and their indices.
+ * @return auto Map of shared pointers to HalfEdgeVertex and their indices, by order of appearance.
  */
     template <std::floating_point T, size_t dim>
     auto getVerticesMapFromFaces(const auto &faces_lst ) -> std::map< std::shared_ptr< HalfEdgeVertex<T,dim> >, size_t >
     {
         std::map< std::shared_ptr< HalfEdgeVertex<T,dim> >, size_t > vertices_map;
-        size_t index{};
         for( const auto &f : faces_lst)
         {
-            auto vtx_lst = getFaceVertices(f);
-            for( const auto &vtx : vtx_lst)
+            auto h_e = f->edge;
+            do
             {
-                if(!vertices_map.contains(vtx))
-                {
-                    vertices_map[vtx] = index;
-                    index++;
-                }
-            }
+                vertices_map.try_emplace(h_e->vertex, vertices_map.size());
+                h_e = h_e->next;
+            } while (h_e != f->edge);
         }
 
         return vertices_map;
@@ -517,22 +634,12 @@ namespace gbs
  * @tparam T Floating point type.
  * @tparam dim Dimension of the vertices.
  * @param faces_lst List of half-edge faces.
- * @return std::vector<std::shared_ptr<HalfEdgeVertex<T, dim>>> A vector containing unique vertices.
+ * @return std::vector<std::shared_ptr<HalfEdgeVertex<T, dim>>> A vector containing unique vertices, by order of appearance.
  */
     template <std::floating_point T, size_t dim>
     auto getVerticesVectorFromFaces(const auto &faces_lst ) -> std::vector< std::shared_ptr< HalfEdgeVertex<T,dim> > >
     {
-        auto vertices_map = getVerticesMapFromFaces<T,dim>(faces_lst);
-
-        std::vector< std::shared_ptr< HalfEdgeVertex<T,dim> > > vertices(vertices_map.size());
-        std::transform(
-            std::execution::par,
-            vertices_map.begin(), vertices_map.end(),
-            vertices.begin(),
-            [](const auto &pair){return pair.first;}
-        );
-
-        return vertices;
+        return getIndexedFaces<T, dim>(faces_lst).vertices;
     }
 
 /**
@@ -547,18 +654,14 @@ namespace gbs
     auto getEdgesMap(const auto &faces_lst) -> std::map<std::shared_ptr<HalfEdge<T, dim>>, size_t>
     {
         std::map<std::shared_ptr<HalfEdge<T, dim>>, size_t> edges_map;
-        size_t index{};
         for (const auto &f : faces_lst)
         {
-            auto hed_lst = getFaceEdges(f);
-            for (const auto &hed : hed_lst)
+            auto h_e = f->edge;
+            do
             {
-                if (!edges_map.contains(hed))
-                {
-                    edges_map[hed] = index;
-                    index++;
-                }
-            }
+                edges_map.try_emplace(h_e, edges_map.size());
+                h_e = h_e->next;
+            } while (h_e != f->edge);
         }
 
         return edges_map;
@@ -1,8 +1,16 @@
 #pragma once
 
 #include "halfEdgeMeshData.h"
+#include <gbs/bssurf.h>
 #include <execution>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <vector>
 namespace gbs
 {
 /**
@@ -81,6 +89,408 @@ namespace gbs
             }
         );
     }
+/**
+ * @brief Shape quality of a triangle, 1 for an equilateral triangle, 0 for a degenerated one.
+ *
+ * The quality is 4 sqrt(3) area / (sum of squared edges' lengths). In the plane, the area is signed, hence the quality
+ * is negative for a clockwise, i.e. inverted, triangle.
+ *
+ * @tparam T Floating point type.
+ * @tparam dim Dimension of the space, 2 or 3.
+ * @return T The triangle's quality.
+ */
+    template <std::floating_point T, size_t dim>
+    requires (dim == 2 || dim == 3)
+    inline auto tri_quality(const std::array<T, dim> &a, const std::array<T, dim> &b, const std::array<T, dim> &c) -> T
+    {
+        auto ab = b - a;
+        auto ac = c - a;
+        auto l = sq_norm(ab) + sq_norm(ac) + sq_norm(c - b);
+        T area2;
+        if constexpr (dim == 2)
+            area2 = ab[0] * ac[1] - ab[1] * ac[0];
+        else
+            area2 = norm(ab ^ ac);
+        return l > T(0) ? T(2) * std::sqrt(T(3)) * area2 / l : T(0);
+    }
+
+/**
+ * @brief Minimal triangle quality of a mesh, see tri_quality.
+ *
+ * @param faces_lst List of shared pointers to triangular half-edge faces.
+ * @return T The worst quality, 1 for an empty mesh.
+ */
+    auto getTriangleMeshMinQuality(const auto &faces_lst)
+    {
+        using T = std::remove_cvref_t<decltype((*faces_lst.begin())->edge->vertex->coords[0])>;
+        return std::transform_reduce(
+            std::execution::par,
+            faces_lst.begin(), faces_lst.end(),
+            T(1),
+            [](T q1, T q2) { return std::min(q1, q2); },
+            [](const auto &h_f)
+            {
+                const auto &h_e = h_f->edge;
+                assert(h_e->next->next->next == h_e);
+                return tri_quality(h_e->vertex->coords, h_e->next->vertex->coords, h_e->previous->vertex->coords);
+            });
+    }
+
+/**
+ * @brief Shape and surface fitting measures of a triangle mesh, one value per triangle in contiguous arrays.
+ *
+ * @tparam T Floating point type.
+ */
+    template <std::floating_point T>
+    struct TriangleQualityMeasures
+    {
+        std::vector<T> min_angle;       ///< Smallest angle, in degrees
+        std::vector<T> aspect_ratio;    ///< Longest edge over inradius, normalized to 1 for an equilateral triangle
+        std::vector<T> skewness;        ///< Equiangular skewness, 0 for an equilateral triangle, 1 for a degenerated one
+        std::vector<T> edge_ratio;      ///< Longest over shortest edge's length
+        std::vector<T> chord_deviation; ///< Largest distance to the surface at centroid and edges' midpoints, empty without surface
+    };
+
+/**
+ * @brief Uniform histogram of a measure, values out of range are counted in the end bins.
+ *
+ * @tparam T Floating point type.
+ */
+    template <std::floating_point T>
+    struct QualityHistogram
+    {
+        T lower{};                  ///< First bin's lower bound
+        T upper{};                  ///< Last bin's upper bound
+        std::vector<size_t> counts; ///< Number of triangles per bin
+    };
+
+/**
+ * @brief Summary of a measure over a mesh.
+ *
+ * @tparam T Floating point type.
+ */
+    template <std::floating_point T>
+    struct QualityStats
+    {
+        T min{};
+        T max{};
+        T mean{};
+        QualityHistogram<T> histogram;
+        std::vector<std::pair<T, size_t>> worst; ///< Worst values and their triangles' indices, the worst first
+    };
+
+/**
+ * @brief Quality report of a triangle mesh, chord_deviation is left empty without surface.
+ *
+ * @tparam T Floating point type.
+ */
+    template <std::floating_point T>
+    struct MeshQualityReport
+    {
+        size_t n_triangles{};
+        QualityStats<T> min_angle;
+        QualityStats<T> aspect_ratio;
+        QualityStats<T> skewness;
+        QualityStats<T> edge_ratio;
+        QualityStats<T> chord_deviation;
+    };
+
+    namespace quality
+    {
+        inline constexpr size_t block_size = 256;
+
+        // Triangles' coordinates gathered by vertex, coordinate and triangle
+        template <std::floating_point T, size_t dim>
+        using TriangleBlock = std::array<std::array<std::array<T, block_size>, dim>, 3>;
+
+        // Shape measures of the first n <= block_size triangles of a block
+        template <std::floating_point T, size_t dim>
+        void shape_measures(size_t n, const TriangleBlock<T, dim> &x, T *min_angle, T *aspect_ratio, T *skewness, T *edge_ratio)
+        {
+            constexpr T deg = T(180) / std::numbers::pi_v<T>;
+            constexpr T inf = std::numeric_limits<T>::infinity();
+            const T two_sqrt3 = T(2) * std::sqrt(T(3));
+            for (size_t i{}; i < n; i++)
+            {
+                std::array<T, dim> ab, ac;
+                T s_ab{}, s_ac{}, s_bc{};
+                for (size_t d{}; d < dim; d++)
+                {
+                    ab[d] = x[1][d][i] - x[0][d][i];
+                    ac[d] = x[2][d][i] - x[0][d][i];
+                    s_ab += ab[d] * ab[d];
+                    s_ac += ac[d] * ac[d];
+                    s_bc += (ac[d] - ab[d]) * (ac[d] - ab[d]);
+                }
+                T area2; // twice the area
+                if constexpr (dim == 2)
+                {
+                    area2 = std::abs(ab[0] * ac[1] - ab[1] * ac[0]);
+                }
+                else
+                {
+                    auto cx = ab[1] * ac[2] - ab[2] * ac[1];
+                    auto cy = ab[2] * ac[0] - ab[0] * ac[2];
+                    auto cz = ab[0] * ac[1] - ab[1] * ac[0];
+                    area2 = std::sqrt(cx * cx + cy * cy + cz * cz);
+                }
+                auto s_min = std::min(s_ab, std::min(s_ac, s_bc));
+                auto s_max = std::max(s_ab, std::max(s_ac, s_bc));
+                auto s_sum = s_ab + s_ac + s_bc;
+                // the angle facing the edge k has 2 area as sine and (s_sum - 2 s_k) / 2 as cosine, times its sides' lengths
+                auto a_min = std::atan2(T(2) * area2, s_sum - T(2) * s_min) * deg;
+                auto a_max = std::atan2(T(2) * area2, s_sum - T(2) * s_max) * deg;
+                auto perimeter = std::sqrt(s_ab) + std::sqrt(s_ac) + std::sqrt(s_bc);
+                min_angle[i] = a_min;
+                aspect_ratio[i] = area2 > T(0) ? std::sqrt(s_max) * perimeter / (two_sqrt3 * area2) : inf;
+                skewness[i] = std::max((a_max - T(60)) / T(120), (T(60) - a_min) / T(60));
+                edge_ratio[i] = s_min > T(0) ? std::sqrt(s_max / s_min) : inf;
+            }
+        }
+
+        // Largest distance between the flat triangle and the surface, at centroid and edges' midpoints
+        template <std::floating_point T, size_t dim>
+        auto chord_deviation(const SurfaceTessellation<T, dim> &mesh, const std::array<size_t, 3> &t, const Surface<T, dim> &srf) -> T
+        {
+            constexpr std::array<std::array<T, 3>, 4> weights{{{T(1) / 3, T(1) / 3, T(1) / 3}, {T(0.5), T(0.5), T(0)}, {T(0), T(0.5), T(0.5)}, {T(0.5), T(0), T(0.5)}}};
+            T dev{};
+            for (const auto &w : weights)
+            {
+                auto uv = w[0] * mesh.uv[t[0]] + w[1] * mesh.uv[t[1]] + w[2] * mesh.uv[t[2]];
+                auto pt = w[0] * mesh.points[t[0]] + w[1] * mesh.points[t[1]] + w[2] * mesh.points[t[2]];
+                dev = std::max(dev, distance(pt, srf(uv[0], uv[1])));
+            }
+            return dev;
+        }
+    }
+
+/**
+ * @brief Computes the triangles' quality measures in a single parallel pass.
+ *
+ * Triangles are processed by blocks whose coordinates are first gathered into contiguous arrays,
+ * the shape measures are then evaluated block by block.
+ *
+ * @tparam T Floating point type.
+ * @tparam dim Dimension of the space, 2 or 3.
+ * @param mesh Indexed triangles.
+ * @param srf Optional surface, the chord deviation is computed from the vertices' parameters if provided.
+ * @return TriangleQualityMeasures<T> The measures, in the triangles' order.
+ */
+    template <std::floating_point T, size_t dim>
+    requires (dim == 2 || dim == 3)
+    auto getTriangleQualityMeasures(const SurfaceTessellation<T, dim> &mesh, const Surface<T, dim> *srf = nullptr) -> TriangleQualityMeasures<T>
+    {
+        using namespace quality;
+        const auto &triangles = mesh.triangles;
+        auto n = triangles.size();
+        if (srf && mesh.uv.size() != mesh.points.size())
+        {
+            throw std::invalid_argument("getTriangleQualityMeasures: vertices' parameters are required for chord deviation");
+        }
+
+        TriangleQualityMeasures<T> measures;
+        measures.min_angle.resize(n);
+        measures.aspect_ratio.resize(n);
+        measures.skewness.resize(n);
+        measures.edge_ratio.resize(n);
+        if (srf)
+        {
+            measures.chord_deviation.resize(n);
+        }
+
+        std::vector<size_t> blocks((n + block_size - 1) / block_size);
+        std::iota(blocks.begin(), blocks.end(), size_t{});
+        std::for_each(
+            std::execution::par,
+            blocks.begin(), blocks.end(),
+            [&](size_t b)
+            {
+                auto first = b * block_size;
+                auto count = std::min(block_size, n - first);
+                TriangleBlock<T, dim> x{};
+                for (size_t i{}; i < count; i++)
+                {
+                    const auto &t = triangles[first + i];
+                    for (size_t k{}; k < 3; k++)
+                    {
+                        for (size_t d{}; d < dim; d++)
+                        {
+                            x[k][d][i] = mesh.points[t[k]][d];
+                        }
+                    }
+                }
+                shape_measures<T, dim>(count, x,
+                                       measures.min_angle.data() + first,
+                                       measures.aspect_ratio.data() + first,
+                                       measures.skewness.data() + first,
+                                       measures.edge_ratio.data() + first);
+                if (srf)
+                {
+                    for (size_t i{}; i < count; i++)
+                    {
+                        measures.chord_deviation[first + i] = chord_deviation(mesh, triangles[first + i], *srf);
+                    }
+                }
+            });
+
+        return measures;
+    }
+
+/**
+ * @brief Summarizes a measure: range, mean, histogram and worst values.
+ *
+ * @tparam T Floating point type.
+ * @param values The measure's values.
+ * @param smaller_is_worse Whether the worst values are the smallest ones.
+ * @param n_bins Histogram's number of bins.
+ * @param n_worst Number of worst values kept.
+ * @param range Histogram's range, the finite values' range if not provided.
+ * @return QualityStats<T> The summary.
+ */
+    template <std::floating_point T>
+    auto make_quality_stats(const std::vector<T> &values, bool smaller_is_worse, size_t n_bins = 20, size_t n_worst = 10, std::optional<std::array<T, 2>> range = std::nullopt) -> QualityStats<T>
+    {
+        using namespace quality;
+        constexpr T inf = std::numeric_limits<T>::infinity();
+        auto n = values.size();
+        QualityStats<T> stats;
+        if (n == 0)
+        {
+            return stats;
+        }
+
+        // min, max, sum, finite values' min and max
+        using Reduction = std::array<T, 5>;
+        auto r = std::transform_reduce(
+            std::execution::par,
+            values.begin(), values.end(),
+            Reduction{inf, -inf, T(0), inf, -inf},
+            [](const Reduction &r1, const Reduction &r2)
+            {
+                return Reduction{std::min(r1[0], r2[0]), std::max(r1[1], r2[1]), r1[2] + r2[2], std::min(r1[3], r2[3]), std::max(r1[4], r2[4])};
+            },
+            [](T v)
+            {
+                auto finite = std::isfinite(v);
+                return Reduction{v, v, v, finite ? v : inf, finite ? v : -inf};
+            });
+        stats.min = r[0];
+        stats.max = r[1];
+        stats.mean = r[2] / static_cast<T>(n);
+
+        auto [lower, upper] = range ? *range : std::array<T, 2>{r[3] <= r[4] ? r[3] : T(0), r[3] <= r[4] ? r[4] : T(0)};
+        stats.histogram.lower = lower;
+        stats.histogram.upper = upper;
+        n_bins = std::max<size_t>(n_bins, 1);
+        auto scale = upper > lower ? static_cast<T>(n_bins) / (upper - lower) : T(0);
+        // worst first, ties by index
+        using Entry = std::pair<T, size_t>;
+        auto worse = [smaller_is_worse](const Entry &e1, const Entry &e2)
+        {
+            if (e1.first == e2.first)
+                return e1.second < e2.second;
+            return smaller_is_worse ? e1.first < e2.first : e1.first > e2.first;
+        };
+        auto k = std::min(n_worst, n);
+
+        // histogram and worst values by blocks, the blocks' worst values are merged
+        using Summary = std::pair<std::vector<size_t>, std::vector<Entry>>;
+        std::vector<size_t> blocks((n + block_size - 1) / block_size);
+        std::iota(blocks.begin(), blocks.end(), size_t{});
+        std::tie(stats.histogram.counts, stats.worst) = std::transform_reduce(
+            std::execution::par,
+            blocks.begin(), blocks.end(),
+            Summary{std::vector<size_t>(n_bins), {}},
+            [&worse, k](Summary s1, const Summary &s2)
+            {
+                std::transform(s1.first.begin(), s1.first.end(), s2.first.begin(), s1.first.begin(), std::plus<>());
+                std::vector<Entry> worst(s1.second.size() + s2.second.size());
+                std::merge(s1.second.begin(), s1.second.end(), s2.second.begin(), s2.second.end(), worst.begin(), worse);
+                worst.resize(std::min(k, worst.size()));
+                s1.second = std::move(worst);
+                return s1;
+            },
+            [&](size_t b)
+            {
+                Summary summary{std::vector<size_t>(n_bins), {}};
+                auto &[counts, worst] = summary;
+                auto last = std::min(n, (b + 1) * block_size);
+                for (auto i = b * block_size; i < last; i++)
+                {
+                    auto x = (values[i] - lower) * scale;
+                    auto bin = x < T(0) || std::isnan(x) ? size_t{} : static_cast<size_t>(std::min(x, static_cast<T>(n_bins - 1)));
+                    counts[bin]++;
+                    Entry e{values[i], i};
+                    if (worst.size() < k || worse(e, worst.back()))
+                    {
+                        worst.insert(std::upper_bound(worst.begin(), worst.end(), e, worse), e);
+                        if (worst.size() > k)
+                            worst.pop_back();
+                    }
+                }
+                return summary;
+            });
+
+        return stats;
+    }
+
+/**
+ * @brief Builds a mesh quality report from per triangle measures.
+ *
+ * Angles and skewness histograms span their whole definition range, the others span the finite values' range.
+ *
+ * @tparam T Floating point type.
+ * @param measures The triangles' measures.
+ * @param n_bins Histograms' number of bins.
+ * @param n_worst Number of worst triangles reported per measure.
+ * @return MeshQualityReport<T> The report.
+ */
+    template <std::floating_point T>
+    auto make_quality_report(const TriangleQualityMeasures<T> &measures, size_t n_bins = 20, size_t n_worst = 10) -> MeshQualityReport<T>
+    {
+        MeshQualityReport<T> report;
+        report.n_triangles = measures.min_angle.size();
+        report.min_angle = make_quality_stats<T>(measures.min_angle, true, n_bins, n_worst, std::array<T, 2>{T(0), T(60)});
+        report.aspect_ratio = make_quality_stats<T>(measures.aspect_ratio, false, n_bins, n_worst);
+        report.skewness = make_quality_stats<T>(measures.skewness, false, n_bins, n_worst, std::array<T, 2>{T(0), T(1)});
+        report.edge_ratio = make_quality_stats<T>(measures.edge_ratio, false, n_bins, n_worst);
+        report.chord_deviation = make_quality_stats<T>(measures.chord_deviation, false, n_bins, n_worst);
+        return report;
+    }
+
+/**
+ * @brief Quality report of an indexed triangle mesh, see getTriangleQualityMeasures and make_quality_report.
+ *
+ * @tparam T Floating point type.
+ * @tparam dim Dimension of the space, 2 or 3.
+ * @param mesh Indexed triangles, for instance from tessellate or make_surface_tessellation.
+ * @param n_bins Histograms' number of bins.
+ * @param n_worst Number of worst triangles reported per measure.
+ * @return MeshQualityReport<T> The report, without chord deviation.
+ */
+    template <std::floating_point T, size_t dim>
+    auto getMeshQualityReport(const SurfaceTessellation<T, dim> &mesh, size_t n_bins = 20, size_t n_worst = 10) -> MeshQualityReport<T>
+    {
+        return make_quality_report(getTriangleQualityMeasures(mesh), n_bins, n_worst);
+    }
+
+/**
+ * @brief Quality report of a surface's indexed triangle mesh, including the triangles' chord deviation.
+ *
+ * @tparam T Floating point type.
+ * @tparam dim Dimension of the space, 2 or 3.
+ * @param mesh Indexed triangles with their vertices' parameters.
+ * @param srf The meshed surface.
+ * @param n_bins Histograms' number of bins.
+ * @param n_worst Number of worst triangles reported per measure.
+ * @return MeshQualityReport<T> The report.
+ */
+    template <std::floating_point T, size_t dim>
+    auto getMeshQualityReport(const SurfaceTessellation<T, dim> &mesh, const Surface<T, dim> &srf, size_t n_bins = 20, size_t n_worst = 10) -> MeshQualityReport<T>
+    {
+        return make_quality_report(getTriangleQualityMeasures(mesh, &srf), n_bins, n_worst);
+    }
+
     template <typename T, size_t dim>
     struct DistanceMeshSurface
     {
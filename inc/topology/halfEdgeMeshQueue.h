@@ -0,0 +1,137 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <execution>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include "halfEdgeMeshData.h"
+
+namespace gbs
+{
+/**
+ * @brief Max-heap of faces keyed by a quality criterion, the worst face on top.
+ *
+ * The criterion returns a pair (quality, point), the point being where the face should be refined.
+ * Updated or erased faces are invalidated lazily: each push stamps the face, stale entries are skipped when reaching the top
+ * and purged once they outnumber the valid ones. Hence push, erase and pop cost O(log n).
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Dimension of the half-edge data structure.
+ * @tparam _Func Criterion's type, callable on a face's shared pointer.
+ */
+    template <std::floating_point T, size_t dim, typename _Func>
+    class FaceQualityQueue
+    {
+    public:
+        using Face = std::shared_ptr<HalfEdgeFace<T, dim>>;
+        using Quality = std::invoke_result_t<const _Func &, const Face &>;
+        struct Entry
+        {
+            Quality quality;
+            Face face;
+            size_t stamp;
+        };
+
+    private:
+        struct Less
+        {
+            bool operator()(const Entry &e1, const Entry &e2) const { return e1.quality.first < e2.quality.first; }
+        };
+
+        _Func m_criterion;
+        std::vector<Entry> m_heap;
+        std::unordered_map<HalfEdgeFace<T, dim> *, size_t> m_stamps;
+        size_t m_stamp{};
+
+        auto isValid(const Entry &e) const -> bool
+        {
+            auto it = m_stamps.find(e.face.get());
+            return it != m_stamps.end() && it->second == e.stamp;
+        }
+
+        void prune()
+        {
+            while (!m_heap.empty() && !isValid(m_heap.front()))
+            {
+                std::pop_heap(m_heap.begin(), m_heap.end(), Less{});
+                m_heap.pop_back();
+            }
+        }
+
+        void compact()
+        {
+            if (m_heap.size() > 2 * m_stamps.size() + 64)
+            {
+                std::erase_if(m_heap, [this](const auto &e) { return !isValid(e); });
+                std::make_heap(m_heap.begin(), m_heap.end(), Less{});
+            }
+        }
+
+    public:
+        FaceQualityQueue(_Func criterion) : m_criterion{std::move(criterion)} {}
+        /**
+         * @brief Inserts or updates a face with an already computed quality.
+         */
+        void push(const Face &h_f, const Quality &quality)
+        {
+            m_stamps[h_f.get()] = ++m_stamp;
+            m_heap.push_back({quality, h_f, m_stamp});
+            std::push_heap(m_heap.begin(), m_heap.end(), Less{});
+            compact();
+        }
+        /**
+         * @brief Inserts or updates a face, its quality being evaluated.
+         */
+        void push(const Face &h_f)
+        {
+            push(h_f, m_criterion(h_f));
+        }
+        /**
+         * @brief Inserts or updates faces, qualities are evaluated in parallel.
+         */
+        template <std::ranges::range Container>
+        void push(const Container &faces)
+        {
+            std::vector<Face> faces_vec(faces.begin(), faces.end());
+            std::vector<Quality> qualities(faces_vec.size());
+            std::transform(std::execution::par, faces_vec.begin(), faces_vec.end(), qualities.begin(),
+                           [this](const auto &h_f) { return m_criterion(h_f); });
+            for (size_t i{}; i < faces_vec.size(); i++)
+            {
+                push(faces_vec[i], qualities[i]);
+            }
+        }
+        /**
+         * @brief Removes a face, if queued.
+         */
+        void erase(const Face &h_f)
+        {
+            m_stamps.erase(h_f.get());
+            compact();
+        }
+        auto contains(const Face &h_f) const -> bool { return m_stamps.contains(h_f.get()); }
+        auto size() const -> size_t { return m_stamps.size(); }
+        auto empty() const -> bool { return m_stamps.empty(); }
+        /**
+         * @brief The worst face's entry, the queue must not be empty.
+         */
+        auto top() -> const Entry &
+        {
+            prune();
+            return m_heap.front();
+        }
+        /**
+         * @brief Removes and returns the worst face's entry, the queue must not be empty.
+         */
+        auto pop() -> Entry
+        {
+            prune();
+            std::pop_heap(m_heap.begin(), m_heap.end(), Less{});
+            auto e = std::move(m_heap.back());
+            m_heap.pop_back();
+            m_stamps.erase(e.face.get());
+            return e;
+        }
+    };
+}
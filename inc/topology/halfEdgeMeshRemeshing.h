@@ -0,0 +1,484 @@
+#pragma once
+#include "halfEdgeMeshData.h"
+#include "halfEdgeMeshGetters.h"
+#include "halfEdgeMeshEditors.h"
+#include "halfEdgeMeshQuality.h"
+#include "halfEdgeMeshQueue.h"
+#include "halfEdgeMeshSmoothing.h"
+
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <unordered_set>
+
+/**
+ * @file halfEdgeMeshRemeshing.h
+ * @brief Isotropic remeshing of a surface's triangulation in the parametric plane toward a target edge length field,
+ * after M. Botsch and L. Kobbelt's "A Remeshing Approach to Multiresolution Modeling".
+ *
+ * Edges are measured on the surface, see edge_sq_length. Edges longer than 4/3 of the target length are split,
+ * edges shorter than 4/5 of the target length are collapsed, then edges are flipped to improve the triangles' quality on the surface,
+ * and vertices are smoothed tangentially, see smooth_vertices_on_surface.
+ * Boundary vertices, as well as vertices of constrained edges, are not removed nor moved. Constrained edges are split, their halves
+ * staying constrained, but neither collapsed nor flipped.
+ *
+ * Operations are taken from priority queues in batches. A batch's operations are checked concurrently, and only applied if they are independent,
+ * i.e. their faces don't meet the faces, or their neighbors, of the operations already accepted in the batch. The others are queued back.
+ * Hence the mesh is never rescanned: only the faces changed by a batch are evaluated again.
+ */
+namespace gbs
+{
+    namespace remeshing
+    {
+        template <std::floating_point T>
+        inline constexpr T split_ratio = T(16) / T(9); ///< Squared ratio to the target length above which an edge is split, i.e. (4/3)^2
+        template <std::floating_point T>
+        inline constexpr T collapse_ratio = T(25) / T(16); ///< Squared inverse ratio to the target length above which an edge is collapsed, i.e. (5/4)^2
+
+        template <std::floating_point T, size_t dim>
+        auto is_constrained(const std::shared_ptr<HalfEdge<T, dim>> &h_e) -> bool
+        {
+            return h_e->constrained || (h_e->opposite && h_e->opposite->constrained);
+        }
+        /**
+         * @brief A vertex can be removed if it is surrounded by faces and has no constrained edge
+         */
+        template <std::floating_point T, size_t dim>
+        auto is_removable(const std::shared_ptr<HalfEdgeVertex<T, dim>> &h_v) -> bool
+        {
+            auto start = h_v->edge;
+            auto current = start;
+            do
+            {
+                if (!current->opposite || current->constrained || current->opposite->constrained)
+                    return false;
+                current = current->opposite->previous;
+            } while (current != start);
+            return true;
+        }
+        /**
+         * @brief Locks the faces around a vertex
+         */
+        template <std::floating_point T, size_t dim>
+        void lock(std::unordered_set<HalfEdgeFace<T, dim> *> &locked, const std::shared_ptr<HalfEdgeVertex<T, dim>> &h_v)
+        {
+            for (const auto &h_f : getFacesAttachedToVertex(h_v))
+                locked.insert(h_f.get());
+        }
+        /**
+         * @brief Faces around a vertex, their neighbors are the faces whose changes may invalidate an operation on the vertex
+         */
+        template <std::floating_point T, size_t dim>
+        void lock(std::unordered_set<HalfEdgeFace<T, dim> *> &locked, const std::shared_ptr<HalfEdgeFace<T, dim>> &h_f)
+        {
+            locked.insert(h_f.get());
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                if (h_e->opposite)
+                    locked.insert(h_e->opposite->face.get());
+            }
+        }
+    }
+
+/**
+ * @brief Face criterion for edge splits, the longest edge's squared ratio to the target length, and the edge.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @tparam _SizeField Callable returning the target length on the surface at a parametric point.
+ */
+    template <std::floating_point T, size_t dim, typename _SizeField>
+    struct LongestEdgeOnSurface
+    {
+        const Surface<T, dim> &srf;
+        const _SizeField &size;
+        auto operator()(const std::shared_ptr<HalfEdgeFace<T, 2>> &hf) const
+        {
+            std::pair<T, std::shared_ptr<HalfEdge<T, 2>>> worst{T(0), nullptr};
+            for (const auto &h_e : getFaceEdges(hf))
+            {
+                auto h = size(edge_midpoint(h_e));
+                auto ratio = edge_sq_length(h_e, srf) / (h * h);
+                if (ratio > worst.first)
+                    worst = {ratio, h_e};
+            }
+            return worst;
+        }
+    };
+
+/**
+ * @brief Face criterion for edge collapses, the shortest collapsible edge's squared inverse ratio to the target length, and the half-edge.
+ *
+ * The half-edge is oriented so that its start vertex, which is removed by the collapse, can be removed.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @tparam _SizeField Callable returning the target length on the surface at a parametric point.
+ */
+    template <std::floating_point T, size_t dim, typename _SizeField>
+    struct ShortestEdgeOnSurface
+    {
+        const Surface<T, dim> &srf;
+        const _SizeField &size;
+        auto operator()(const std::shared_ptr<HalfEdgeFace<T, 2>> &hf) const
+        {
+            std::pair<T, std::shared_ptr<HalfEdge<T, 2>>> worst{T(0), nullptr};
+            for (const auto &h_e : getFaceEdges(hf))
+            {
+                if (!h_e->opposite || remeshing::is_constrained(h_e))
+                    continue;
+                auto h_e_col = remeshing::is_removable(h_e->previous->vertex) ? h_e : remeshing::is_removable(h_e->vertex) ? h_e->opposite : nullptr;
+                if (!h_e_col)
+                    continue;
+                auto h = size(edge_midpoint(h_e));
+                auto ratio = (h * h) / std::max(edge_sq_length(h_e, srf), std::numeric_limits<T>::min());
+                if (ratio > worst.first)
+                    worst = {ratio, h_e_col};
+            }
+            return worst;
+        }
+    };
+
+/**
+ * @brief Counts of the operations applied by remesh
+ */
+    struct RemeshCounts
+    {
+        size_t splits{};
+        size_t collapses{};
+        size_t flips{};
+        size_t moves{};
+    };
+
+/**
+ * @brief Splits the edges longer than 4/3 of the target length, the longest first.
+ *
+ * A batch's splits are applied concurrently. They are kept vertex disjoint, i.e. a split is only accepted if its faces
+ * don't touch the vertices of the splits already accepted in the batch, since a split updates its vertices' half-edges.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param faces_lst The parametric plane's triangles, updated at the end.
+ * @param srf The surface.
+ * @param size Callable returning the target length on the surface at a parametric point.
+ * @param batch_size Maximum number of splits per step.
+ * @param max_splits Maximum number of splits.
+ * @return size_t The number of splits.
+ */
+    template <std::floating_point T, size_t dim, typename _SizeField>
+    auto splitLongEdges(std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, const Surface<T, dim> &srf, const _SizeField &size, size_t batch_size = 256, size_t max_splits = std::numeric_limits<size_t>::max()) -> size_t
+    {
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
+        using Edge = std::shared_ptr<HalfEdge<T, 2>>;
+        using Criterion = LongestEdgeOnSurface<T, dim, _SizeField>;
+        constexpr T ratio_max = remeshing::split_ratio<T>;
+
+        Criterion criterion{srf, size};
+        FaceQualityQueue<T, 2, Criterion> queue{criterion};
+        queue.push(faces_lst);
+
+        std::list<Face> added;
+        size_t n_splits{};
+        batch_size = std::max<size_t>(batch_size, 1);
+        while (n_splits < max_splits && !queue.empty() && queue.top().quality.first > ratio_max)
+        {
+            std::vector<typename FaceQualityQueue<T, 2, Criterion>::Entry> batch;
+            while (batch.size() < std::min(batch_size, max_splits - n_splits) && !queue.empty() && queue.top().quality.first > ratio_max)
+            {
+                batch.push_back(queue.pop());
+            }
+
+            // Keep independent splits, a split changes the edge's faces and their vertices' half-edges
+            std::unordered_set<HalfEdgeFace<T, 2> *> locked;
+            std::unordered_set<Face> changed;
+            std::vector<Edge> accepted;
+            for (auto &e : batch)
+            {
+                auto h_e = e.quality.second;
+                auto faces = {h_e->face, h_e->opposite ? h_e->opposite->face : nullptr};
+                if (std::ranges::any_of(faces, [&locked](const auto &h_f) { return h_f && locked.contains(h_f.get()); }))
+                {
+                    queue.push(e.face, e.quality);
+                    continue;
+                }
+                for (const auto &h_f : faces)
+                {
+                    if (h_f)
+                    {
+                        for (const auto &h_e_f : getFaceEdges(h_f))
+                        {
+                            remeshing::lock(locked, h_e_f->vertex);
+                        }
+                        changed.insert(h_f);
+                    }
+                }
+                accepted.push_back(h_e);
+            }
+
+            // Split concurrently
+            std::vector<std::list<Face>> h_f_lst_new(accepted.size());
+            std::vector<size_t> indices(accepted.size());
+            std::iota(indices.begin(), indices.end(), size_t{});
+            std::for_each(
+                std::execution::par,
+                indices.begin(), indices.end(),
+                [&accepted, &h_f_lst_new](size_t i) { splitHalfEdge(accepted[i], h_f_lst_new[i]); });
+            for (const auto &h_f_lst : h_f_lst_new)
+            {
+                changed.insert(h_f_lst.begin(), h_f_lst.end());
+                added.insert(added.end(), h_f_lst.begin(), h_f_lst.end());
+            }
+            n_splits += accepted.size();
+            queue.push(changed);
+        }
+
+        faces_lst.insert(faces_lst.end(), added.begin(), added.end());
+        return n_splits;
+    }
+
+/**
+ * @brief Collapses the edges shorter than 4/5 of the target length, the shortest first.
+ *
+ * A collapse is rejected if it breaks the link condition, inverts a triangle in the parametric plane
+ * or creates an edge longer than 4/3 of the target length.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param faces_lst The parametric plane's triangles, updated at the end.
+ * @param srf The surface.
+ * @param size Callable returning the target length on the surface at a parametric point.
+ * @param batch_size Maximum number of collapses per step.
+ * @return size_t The number of collapses.
+ */
+    template <std::floating_point T, size_t dim, typename _SizeField>
+    auto collapseShortEdges(std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, const Surface<T, dim> &srf, const _SizeField &size, size_t batch_size = 256) -> size_t
+    {
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
+        using Criterion = ShortestEdgeOnSurface<T, dim, _SizeField>;
+        constexpr T ratio_min = remeshing::collapse_ratio<T>;
+
+        // the collapse of a onto b is valid if a's faces, but the two removed ones, stay ccw and short enough
+        auto is_valid = [&srf, &size](const auto &h_e) {
+            auto h_a = h_e->previous->vertex;
+            auto h_b = h_e->vertex;
+            auto h_c = h_e->next->vertex;
+            auto h_d = h_e->opposite->next->vertex;
+            if (h_c == h_d)
+                return false;
+            // link condition
+            std::unordered_set<HalfEdgeVertex<T, 2> *> ring_b;
+            for (const auto &h_e_b : getIncomingEdges(h_b))
+                ring_b.insert(h_e_b->previous->vertex.get());
+            auto incoming = getIncomingEdges(h_a);
+            for (const auto &h_e_a : incoming)
+            {
+                auto h_w = h_e_a->previous->vertex;
+                if (h_w != h_c && h_w != h_d && ring_b.contains(h_w.get()))
+                    return false;
+            }
+            // moved faces
+            const auto &uv_b = h_b->coords;
+            auto X_b = srf(uv_b);
+            for (const auto &h_e_a : incoming)
+            {
+                if (h_e_a->face == h_e->face || h_e_a->face == h_e->opposite->face)
+                    continue;
+                const auto &uv_1 = h_e_a->next->vertex->coords;
+                const auto &uv_2 = h_e_a->previous->vertex->coords;
+                if (tri_quality(uv_b, uv_1, uv_2) <= T(0))
+                    return false;
+                auto h = size(static_cast<T>(0.5) * (uv_b + uv_1));
+                if (sq_norm(srf(uv_1) - X_b) > remeshing::split_ratio<T> * h * h)
+                    return false;
+            }
+            return true;
+        };
+
+        Criterion criterion{srf, size};
+        FaceQualityQueue<T, 2, Criterion> queue{criterion};
+        queue.push(faces_lst);
+
+        std::unordered_set<Face> removed;
+        size_t n_collapses{};
+        batch_size = std::max<size_t>(batch_size, 1);
+        while (!queue.empty() && queue.top().quality.first > ratio_min)
+        {
+            std::vector<typename FaceQualityQueue<T, 2, Criterion>::Entry> batch;
+            while (batch.size() < batch_size && !queue.empty() && queue.top().quality.first > ratio_min)
+            {
+                batch.push_back(queue.pop());
+            }
+
+            // Check collapses concurrently, the mesh is not modified yet
+            std::vector<char> valid(batch.size());
+            std::transform(
+                std::execution::par,
+                batch.begin(), batch.end(),
+                valid.begin(),
+                [&is_valid](const auto &e) -> char { return is_valid(e.quality.second); });
+
+            // Keep independent collapses, a collapse changes the faces around both edge's ends, rejected ones are dropped
+            std::unordered_set<HalfEdgeFace<T, 2> *> locked;
+            std::unordered_set<Face> changed;
+            for (size_t i{}; i < batch.size(); i++)
+            {
+                if (!valid[i])
+                {
+                    continue;
+                }
+                auto h_e = batch[i].quality.second;
+                if (removed.contains(batch[i].face))
+                {
+                    continue;
+                }
+                // the edge's face is around the removed vertex, hence locked if the vertex was removed
+                if (locked.contains(h_e->face.get()))
+                {
+                    queue.push(batch[i].face, batch[i].quality);
+                    continue;
+                }
+                auto faces = getFacesAttachedToVertex(h_e->previous->vertex);
+                auto faces_b = getFacesAttachedToVertex(h_e->vertex);
+                faces.insert(faces.end(), faces_b.begin(), faces_b.end());
+                if (std::ranges::any_of(faces, [&locked](const auto &h_f) { return locked.contains(h_f.get()); }))
+                {
+                    queue.push(batch[i].face, batch[i].quality);
+                    continue;
+                }
+                for (const auto &h_f : faces)
+                {
+                    remeshing::lock(locked, h_f);
+                }
+                auto h_b = h_e->vertex;
+                for (const auto &h_f : collapseHalfEdge(h_e))
+                {
+                    queue.erase(h_f);
+                    changed.erase(h_f);
+                    removed.insert(h_f);
+                }
+                auto faces_new = getFacesAttachedToVertex(h_b);
+                changed.insert(faces_new.begin(), faces_new.end());
+                n_collapses++;
+            }
+            queue.push(changed);
+        }
+
+        std::erase_if(faces_lst, [&removed](const auto &h_f) { return removed.contains(h_f); });
+        return n_collapses;
+    }
+
+/**
+ * @brief Flips the edges whose flip improves the worst quality, on the surface, of their two triangles.
+ *
+ * Flips are taken from a worklist of dirty edges, initially all the flippable ones. Each round checks the dirty edges concurrently,
+ * applies the independent flips, the best first, and makes dirty the edges of the flipped triangles as well as the postponed flips.
+ * The other edges are clean: their triangles didn't change, hence neither did their gain.
+ * Each flip raises the worst quality of its triangles by more than a threshold, hence the worklist empties.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param faces_lst The parametric plane's triangles.
+ * @param srf The surface.
+ * @param max_rounds Maximum number of rounds.
+ * @return size_t The number of flips.
+ */
+    template <std::floating_point T, size_t dim>
+    auto flipEdges(std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, const Surface<T, dim> &srf, size_t max_rounds = std::numeric_limits<size_t>::max()) -> size_t
+    {
+        using Edge = std::shared_ptr<HalfEdge<T, 2>>;
+        constexpr T gain_min = T(1e-3);
+
+        // flip's gain, 0 if the flip is invalid
+        auto gain = [&srf](const Edge &h_e) -> T {
+            const auto &uv_a = h_e->previous->vertex->coords;
+            const auto &uv_b = h_e->vertex->coords;
+            const auto &uv_c = h_e->next->vertex->coords;
+            const auto &uv_d = h_e->opposite->next->vertex->coords;
+            if (tri_quality(uv_c, uv_a, uv_d) <= T(0) || tri_quality(uv_d, uv_b, uv_c) <= T(0))
+                return T(0);
+            auto a = srf(uv_a), b = srf(uv_b), c = srf(uv_c), d = srf(uv_d);
+            auto q_old = std::min(tri_quality(a, b, c), tri_quality(b, a, d));
+            auto q_new = std::min(tri_quality(c, a, d), tri_quality(d, b, c));
+            return q_new - q_old;
+        };
+
+        // an edge is in the worklist once, through either of its half-edges
+        std::vector<Edge> dirty;
+        std::unordered_set<HalfEdge<T, 2> *> is_dirty;
+        auto make_dirty = [&dirty, &is_dirty](const Edge &h_e) {
+            if (h_e->opposite && !remeshing::is_constrained(h_e) && is_dirty.insert(std::min(h_e.get(), h_e->opposite.get())).second)
+                dirty.push_back(h_e);
+        };
+        for (const auto &h_f : faces_lst)
+            for (const auto &h_e : getFaceEdges(h_f))
+                make_dirty(h_e);
+
+        size_t n_flips{};
+        for (size_t round{}; round < max_rounds && !dirty.empty(); round++)
+        {
+            auto edges = std::move(dirty);
+            dirty.clear();
+            is_dirty.clear();
+
+            std::vector<T> gains(edges.size());
+            std::transform(std::execution::par, edges.begin(), edges.end(), gains.begin(), gain);
+
+            std::vector<size_t> order;
+            for (size_t i{}; i < edges.size(); i++)
+                if (gains[i] > gain_min)
+                    order.push_back(i);
+            std::sort(order.begin(), order.end(), [&gains](size_t i, size_t j) { return gains[i] > gains[j]; });
+
+            // Keep independent flips, the best first
+            std::unordered_set<HalfEdgeFace<T, 2> *> locked;
+            for (auto i : order)
+            {
+                auto h_e = edges[i];
+                auto h_f1 = h_e->face, h_f2 = h_e->opposite->face;
+                if (locked.contains(h_f1.get()) || locked.contains(h_f2.get()))
+                {
+                    make_dirty(h_e);
+                    continue;
+                }
+                remeshing::lock(locked, h_f1);
+                remeshing::lock(locked, h_f2);
+                flip(h_f1, h_f2);
+                n_flips++;
+                for (const auto &h_f : {h_f1, h_f2})
+                    for (const auto &h_e_f : getFaceEdges(h_f))
+                        make_dirty(h_e_f);
+            }
+        }
+
+        return n_flips;
+    }
+
+/**
+ * @brief Remeshes a surface's triangulation given in the parametric plane toward a target edge length field, see halfEdgeMeshRemeshing.h.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @tparam _SizeField Callable returning the target length on the surface at a parametric point.
+ * @param faces_lst The parametric plane's triangles, updated in place.
+ * @param srf The surface.
+ * @param size The target edge length field.
+ * @param n_iterations Number of split, collapse, flip and smoothing passes.
+ * @param batch_size Maximum number of splits or collapses per step.
+ * @return RemeshCounts The number of applied operations.
+ */
+    template <std::floating_point T, size_t dim, typename _SizeField>
+    auto remesh(std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, const Surface<T, dim> &srf, const _SizeField &size, size_t n_iterations = 5, size_t batch_size = 256) -> RemeshCounts
+    {
+        RemeshCounts counts;
+        for (size_t it{}; it < n_iterations; it++)
+        {
+            counts.splits += splitLongEdges(faces_lst, srf, size, batch_size);
+            counts.collapses += collapseShortEdges(faces_lst, srf, size, batch_size);
+            counts.flips += flipEdges(faces_lst, srf);
+            counts.moves += smooth_vertices_on_surface(faces_lst, srf, 1);
+        }
+        return counts;
+    }
+}
@@ -12,6 +12,10 @@
 #include <vtkPolyLine.h>
 #include <vtkPolyDataMapper.h>
 
+#include <vector>
+#include <algorithm>
+#include <execution>
+
 namespace gbs
 {
 /**
@@ -51,6 +55,42 @@ namespace gbs
         return points;
     }
 
+/**
+ * @brief Generate VTK points from a vector of vertices, the surface being evaluated in parallel
+ *
+ * @tparam T : floating point type
+ * @tparam dim : dimension of the surface
+ * @param vertices : vertices of the faces, the points' order
+ * @param srf : Surface object for generating point coordinates
+ * @return vtkSmartPointer<vtkPoints>
+ */
+    template <std::floating_point T, size_t dim>
+    requires (dim < 4)
+    auto generate_points_from_vertices(const auto &vertices, const Surface<T, dim> &srf)
+    {
+        std::vector<std::array<double, 3>> pts(vertices.size());
+        std::transform(std::execution::par, vertices.begin(), vertices.end(), pts.begin(),
+                       [&srf](const auto &vtx) { return make_vtkPoint(srf(vtx->coords[0], vtx->coords[1])); });
+        vtkNew<vtkPoints> points;
+        points->SetNumberOfPoints(pts.size());
+        for (size_t i{}; i < pts.size(); i++)
+        {
+            points->SetPoint(i, pts[i].data());
+        }
+        return points;
+    }
+
+    auto generate_points_from_vertices(const auto &vertices)
+    {
+        vtkNew<vtkPoints> points;
+        points->SetNumberOfPoints(vertices.size());
+        for (size_t i{}; i < vertices.size(); i++)
+        {
+            points->SetPoint(i, make_vtkPoint(vertices[i]->coords).data());
+        }
+        return points;
+    }
+
 /**
  * @brief Generate points and normals from faces and surface
  *
@@ -80,6 +120,40 @@ namespace gbs
         return std::make_pair(points, normals);
     }
 
+/**
+ * @brief Generate points and normals from a vector of vertices and a surface, evaluated in parallel
+ *
+ * @param vertices : vertices of the faces, the points' order
+ * @param srf : surface used to compute points and normals
+ * @return std::pair<vtkSmartPointer<vtkPoints>, vtkSmartPointer<vtkFloatArray>>
+ */
+    template <std::floating_point T>
+    auto generate_points_and_normals_from_vertices(const auto &vertices, const Surface<T, 3> &srf)
+    {
+        std::vector<std::pair<std::array<double, 3>, std::array<double, 3>>> pts(vertices.size());
+        std::transform(std::execution::par, vertices.begin(), vertices.end(), pts.begin(),
+                       [&srf](const auto &vtx) {
+                           auto [u, v] = vtx->coords;
+                           return std::make_pair(make_vtkPoint(srf(u, v)), make_vtkPoint(normalized(srf(u, v, 1, 0) ^ srf(u, v, 0, 1))));
+                       });
+
+        vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+        points->SetNumberOfPoints(pts.size());
+
+        vtkSmartPointer<vtkFloatArray> normals = vtkSmartPointer<vtkFloatArray>::New();
+        normals->SetNumberOfComponents(3);
+        normals->SetNumberOfTuples(pts.size());
+
+        for (size_t i{}; i < pts.size(); i++)
+        {
+            const auto &[X, N] = pts[i];
+            points->SetPoint(i, X.data());
+            normals->SetTuple3(i, N[0], N[1], N[2]);
+        }
+
+        return std::make_pair(points, normals);
+    }
+
 /**
  * @brief Generate cells from a list of faces and a vertices map
  *
@@ -119,6 +193,26 @@ namespace gbs
         return cells;
     }
 
+/**
+ * @brief Generate cells from faces' contiguous index arrays
+ *
+ * @param mesh : IndexedFaces, see getIndexedFaces
+ * @return vtkSmartPointer<vtkCellArray>
+ */
+    auto generate_cells_from_indexed_faces(const auto &mesh)
+    {
+        vtkNew<vtkCellArray> cells;
+        auto n_faces = mesh.offsets.size() - 1;
+        cells->AllocateExact(n_faces, mesh.indices.size());
+        std::vector<vtkIdType> ids;
+        for (size_t i{}; i < n_faces; i++)
+        {
+            ids.assign(std::next(mesh.indices.begin(), mesh.offsets[i]), std::next(mesh.indices.begin(), mesh.offsets[i + 1]));
+            cells->InsertNextCell(static_cast<vtkIdType>(ids.size()), ids.data());
+        }
+        return cells;
+    }
+
 /**
  * @brief Generates a vtkPolyData object using input points and cells.
  *
@@ -181,11 +275,11 @@ namespace gbs
     auto make_polydata_from_faces(const auto &faces_lst)
     {
 
-        auto vertices_map = getVerticesMapFromFaces<T, 2>(faces_lst);
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
 
-        auto points = generate_points_from_vertices_map(vertices_map);
+        auto points = generate_points_from_vertices(mesh.vertices);
 
-        auto cells = generate_cells_from_faces(faces_lst, vertices_map);
+        auto cells = generate_cells_from_indexed_faces(mesh);
 
         vtkNew<vtkPolyData> polyData;
         // Add the geometry and topology to the polydata
@@ -209,11 +303,11 @@ namespace gbs
     auto make_polydata_from_faces(const auto &faces_lst, const Surface<T, dim> &srf)
     {
 
-        auto vertices_map = getVerticesMapFromFaces<T, 2>(faces_lst);
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
 
-        auto points = generate_points_from_vertices_map(vertices_map, srf);
+        auto points = generate_points_from_vertices(mesh.vertices, srf);
 
-        auto cells = generate_cells_from_faces(faces_lst, vertices_map);
+        auto cells = generate_cells_from_indexed_faces(mesh);
 
         return generate_polydata(points, cells, true);
     }
@@ -228,11 +322,11 @@ namespace gbs
     template <std::floating_point T>
     auto make_polydata_from_faces(const auto &faces_lst, const Surface<T, 3> &srf)
     {
-        auto vertices_map = getVerticesMapFromFaces<T, 2>(faces_lst);
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
 
-        auto [points, normals] = generate_points_and_normals<T>(vertices_map, srf);
+        auto [points, normals] = generate_points_and_normals_from_vertices<T>(mesh.vertices, srf);
 
-        auto cells = generate_cells_from_faces(faces_lst, vertices_map);
+        auto cells = generate_cells_from_indexed_faces(mesh);
 
         return generate_polydata(points, normals, cells);
     }
@@ -250,15 +344,11 @@ namespace gbs
     auto make_polydata_from_edges_loop(const auto &edges_lst)
     {
         // build vertices map
-        std::map<std::shared_ptr<HalfEdgeVertex<T, dim>>, size_t> vertices_map;
-        size_t index{};
+        std::unordered_map<std::shared_ptr<HalfEdgeVertex<T, dim>>, size_t> vertices_map;
+        vertices_map.reserve(edges_lst.size() + 1);
         for (const auto &e : edges_lst)
         {
-            auto vtx = e->vertex;
-            if (vertices_map.find(vtx) == vertices_map.end())
-            {
-                vertices_map[vtx] = index++;
-            }
+            vertices_map.try_emplace(e->vertex, vertices_map.size());
         }
 
         // store vtk points
@@ -1,6 +1,14 @@
 #pragma once
 #include "halfEdgeMeshData.h"
 #include "halfEdgeMeshGetters.h"
+#include "halfEdgeMeshCompact.h"
+#include "halfEdgeMeshQuality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+#include <vector>
 namespace gbs
 {
     template <std::floating_point T, size_t dim>
@@ -16,4 +24,395 @@ namespace gbs
         centroid = centroid / static_cast<T>(neighbors.size());
         h_v.coords = centroid;
     }
-}
\ No newline at end of file
+
+/**
+ * @brief Vertex displacement rule, see smooth_vertices
+ */
+    enum class SmoothingMethod
+    {
+        laplacian,  ///< Move to the neighbors' centroid
+        angle_based ///< Rotate each edge to the bisector of the angle its neighbor vertex spans (Zhou and Shimada), shrinks less than laplacian
+    };
+
+/**
+ * @brief Triangles around each vertex of a triangle mesh, as contiguous arrays.
+ *
+ * Vertex v's triangles are (v, links[k][0], links[k][1]), counterclockwise, for k in [offsets[v], offsets[v+1]).
+ * Vertices whose triangles don't close a fan, i.e. boundary vertices, are not free, nor are unused indices.
+ * The builders from half-edge meshes also fix the vertices of constrained half-edges, see HalfEdge::constrained.
+ */
+    struct VertexStars
+    {
+        std::vector<size_t> offsets{0};
+        std::vector<std::array<HeIndex, 2>> links;
+        std::vector<bool> free;
+    };
+
+/**
+ * @brief Builds the vertices' stars of a triangle mesh in linear time.
+ *
+ * @param n_vertices Number of vertices' indices, i.e. the greatest index + 1.
+ * @param triangles Counterclockwise triangles' vertices' indices.
+ * @return VertexStars
+ */
+    inline auto make_vertex_stars(size_t n_vertices, const std::vector<std::array<HeIndex, 3>> &triangles) -> VertexStars
+    {
+        VertexStars stars;
+        stars.offsets.assign(n_vertices + 1, 0);
+        for (const auto &tri : triangles)
+            for (auto v : tri)
+                stars.offsets[v + 1]++;
+        std::partial_sum(stars.offsets.begin(), stars.offsets.end(), stars.offsets.begin());
+
+        stars.links.resize(stars.offsets.back());
+        auto pos = stars.offsets;
+        for (const auto &[v1, v2, v3] : triangles)
+        {
+            stars.links[pos[v1]++] = {v2, v3};
+            stars.links[pos[v2]++] = {v3, v1};
+            stars.links[pos[v3]++] = {v1, v2};
+        }
+
+        // a fan is closed if each link's start is another link's end
+        stars.free.resize(n_vertices);
+        for (size_t v{}; v < n_vertices; v++)
+        {
+            auto first = std::next(stars.links.begin(), stars.offsets[v]);
+            auto last = std::next(stars.links.begin(), stars.offsets[v + 1]);
+            stars.free[v] = first != last && std::all_of(first, last, [first, last](const auto &l1) {
+                return std::any_of(first, last, [&l1](const auto &l2) { return l2[1] == l1[0]; });
+            });
+        }
+        return stars;
+    }
+
+/**
+ * @brief Builds the vertices' stars of triangles' index arrays, see getIndexedFaces.
+ */
+    template <std::floating_point T, size_t dim>
+    auto make_vertex_stars(const IndexedFaces<T, dim> &mesh) -> VertexStars
+    {
+        std::vector<std::array<HeIndex, 3>> triangles(mesh.offsets.size() - 1);
+        for (size_t i{}; i < triangles.size(); i++)
+        {
+            assert(mesh.offsets[i + 1] - mesh.offsets[i] == 3);
+            auto k = mesh.offsets[i];
+            triangles[i] = {HeIndex(mesh.indices[k]), HeIndex(mesh.indices[k + 1]), HeIndex(mesh.indices[k + 2])};
+        }
+        return make_vertex_stars(mesh.vertices.size(), triangles);
+    }
+
+/**
+ * @brief Builds the vertices' stars of a list of triangles, the vertices of constrained half-edges are not free.
+ *
+ * @param faces_lst List of shared pointers to the triangles.
+ * @param mesh The triangles' index arrays, see getIndexedFaces.
+ * @return VertexStars
+ */
+    template <std::floating_point T, size_t dim>
+    auto make_vertex_stars(const auto &faces_lst, const IndexedFaces<T, dim> &mesh) -> VertexStars
+    {
+        auto stars = make_vertex_stars(mesh);
+        // faces' loops are indexed in the same order, the tail of a face's first half-edge is its last vertex
+        auto k = mesh.offsets.begin();
+        for (const auto &h_f : faces_lst)
+        {
+            auto i_tail = mesh.indices[*std::next(k) - 1];
+            auto i = *k;
+            auto h_e = h_f->edge;
+            do
+            {
+                if (h_e->constrained || (h_e->opposite && h_e->opposite->constrained))
+                {
+                    stars.free[mesh.indices[i]] = false;
+                    stars.free[i_tail] = false;
+                }
+                i_tail = mesh.indices[i++];
+                h_e = h_e->next;
+            } while (h_e != h_f->edge);
+            k++;
+        }
+        return stars;
+    }
+
+/**
+ * @brief Greedy coloring of the free vertices, two vertices sharing an edge never have the same color.
+ *
+ * Vertices of a color can hence be moved concurrently, each one reading neighbors of other colors only.
+ *
+ * @param stars The vertices' stars.
+ * @return std::vector<std::vector<HeIndex>> The free vertices, grouped by color.
+ */
+    inline auto color_vertices(const VertexStars &stars) -> std::vector<std::vector<HeIndex>>
+    {
+        constexpr size_t no_color = std::numeric_limits<size_t>::max();
+        auto n_vertices = stars.free.size();
+        std::vector<size_t> colors(n_vertices, no_color);
+        std::vector<std::vector<HeIndex>> classes;
+        std::vector<bool> used;
+        for (size_t v{}; v < n_vertices; v++)
+        {
+            if (!stars.free[v])
+                continue;
+            used.assign(classes.size() + 1, false);
+            for (auto k = stars.offsets[v]; k < stars.offsets[v + 1]; k++)
+                for (auto w : stars.links[k])
+                    if (colors[w] != no_color)
+                        used[colors[w]] = true;
+            auto c = static_cast<size_t>(std::distance(used.begin(), std::find(used.begin(), used.end(), false)));
+            if (c == classes.size())
+                classes.emplace_back();
+            colors[v] = c;
+            classes[c].push_back(static_cast<HeIndex>(v));
+        }
+        return classes;
+    }
+
+/**
+ * @brief Smooths free vertices in place, one color at a time, the vertices of a color being moved in parallel.
+ *
+ * A vertex is only moved if its star's worst triangle quality, see tri_quality, doesn't decrease. Hence no triangle is inverted.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param stars The vertices' stars.
+ * @param colors The free vertices grouped by color, see color_vertices.
+ * @param coords Callable returning a reference to a vertex's coordinates from its index.
+ * @param method Vertex displacement rule.
+ * @param n_iterations Maximum number of sweeps, smoothing stops earlier if no vertex moves.
+ * @return size_t The number of vertices' moves.
+ */
+    template <std::floating_point T>
+    auto smooth_vertices(const VertexStars &stars, const std::vector<std::vector<HeIndex>> &colors, auto &&coords, SmoothingMethod method = SmoothingMethod::laplacian, size_t n_iterations = 1) -> size_t
+    {
+        using Point = std::array<T, 2>;
+        auto star_quality = [&](size_t first, size_t last, const Point &X) {
+            T q{1};
+            for (auto k = first; k < last; k++)
+                q = std::min(q, tri_quality<T, 2>(X, coords(stars.links[k][0]), coords(stars.links[k][1])));
+            return q;
+        };
+
+        auto laplacian = [&](size_t first, size_t last) {
+            Point X{};
+            for (auto k = first; k < last; k++)
+                X = X + coords(stars.links[k][0]);
+            return X / static_cast<T>(last - first);
+        };
+
+        auto angle_based = [&](size_t first, size_t last, const Point &X) {
+            Point X_new{};
+            for (auto k = first; k < last; k++)
+            {
+                // triangles (X, c, a) and (X, a, b) share the edge from a to X
+                auto [a, b] = stars.links[k];
+                auto k_prev = first;
+                while (stars.links[k_prev][1] != a)
+                    k_prev++;
+                auto c = stars.links[k_prev][0];
+                const auto &A = coords(a);
+                auto AX = X - A;
+                auto AB = coords(b) - A;
+                auto AC = coords(c) - A;
+                auto angle = [](const Point &u, const Point &v) { return std::atan2(std::abs(u[0] * v[1] - u[1] * v[0]), u * v); };
+                // rotate AX around A to the bisector of (AB, AC)
+                auto beta = (angle(AC, AX) - angle(AX, AB)) / T(2);
+                auto cos_b = std::cos(beta), sin_b = std::sin(beta);
+                X_new = X_new + A + Point{cos_b * AX[0] - sin_b * AX[1], sin_b * AX[0] + cos_b * AX[1]};
+            }
+            return X_new / static_cast<T>(last - first);
+        };
+
+        size_t n_moves{};
+        for (size_t it{}; it < n_iterations; it++)
+        {
+            size_t n_moves_it{};
+            for (const auto &color : colors)
+            {
+                n_moves_it += std::transform_reduce(
+                    std::execution::par,
+                    color.begin(), color.end(),
+                    size_t{},
+                    std::plus<>{},
+                    [&](HeIndex v) -> size_t {
+                        auto first = stars.offsets[v], last = stars.offsets[v + 1];
+                        auto &X = coords(v);
+                        auto X_new = method == SmoothingMethod::laplacian ? laplacian(first, last) : angle_based(first, last, X);
+                        if (X_new == X || star_quality(first, last, X_new) < star_quality(first, last, X))
+                            return 0;
+                        X = X_new;
+                        return 1;
+                    });
+            }
+            n_moves += n_moves_it;
+            if (n_moves_it == 0)
+                break;
+        }
+        return n_moves;
+    }
+
+/**
+ * @brief Smooths the inner vertices of a planar triangle mesh in place, see smooth_vertices.
+ *
+ * Vertices of constrained half-edges are not moved.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param msh The compact mesh.
+ * @param method Vertex displacement rule.
+ * @param n_iterations Maximum number of sweeps.
+ * @return size_t The number of vertices' moves.
+ */
+    template <std::floating_point T>
+    auto smooth_vertices(CompactHalfEdgeMesh<T, 2> &msh, SmoothingMethod method = SmoothingMethod::laplacian, size_t n_iterations = 1) -> size_t
+    {
+        auto f_lst = msh.faces();
+        std::vector<std::array<HeIndex, 3>> triangles(f_lst.size());
+        std::transform(f_lst.begin(), f_lst.end(), triangles.begin(), [&msh](HeIndex f) {
+            auto e = msh.faceEdge(f);
+            assert(msh.next(msh.next(msh.next(e))) == e);
+            return std::array<HeIndex, 3>{msh.vertex(e), msh.vertex(msh.next(e)), msh.vertex(msh.previous(e))};
+        });
+        auto v_lst = msh.vertices();
+        auto stars = make_vertex_stars(v_lst.empty() ? 0 : v_lst.back() + 1, triangles);
+        for (auto f : f_lst)
+        {
+            for (auto e : msh.getFaceEdges(f))
+            {
+                if (msh.constrained(e))
+                {
+                    stars.free[msh.vertex(e)] = false;
+                    stars.free[msh.tail(e)] = false;
+                }
+            }
+        }
+        auto colors = color_vertices(stars);
+        return smooth_vertices<T>(stars, colors, [&msh](HeIndex v) -> auto & { return msh.coords(v); }, method, n_iterations);
+    }
+
+/**
+ * @brief Smooths the inner vertices of a list of planar triangles in place, see smooth_vertices.
+ *
+ * Vertices of constrained half-edges are not moved.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param faces_lst List of shared pointers to the triangles.
+ * @param method Vertex displacement rule.
+ * @param n_iterations Maximum number of sweeps.
+ * @return size_t The number of vertices' moves.
+ */
+    template <std::floating_point T>
+    auto smooth_vertices(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, SmoothingMethod method = SmoothingMethod::laplacian, size_t n_iterations = 1) -> size_t
+    {
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
+        auto stars = make_vertex_stars(faces_lst, mesh);
+        auto colors = color_vertices(stars);
+        return smooth_vertices<T>(stars, colors, [&mesh](HeIndex v) -> auto & { return mesh.vertices[v]->coords; }, method, n_iterations);
+    }
+
+/**
+ * @brief Tangential Laplacian smoothing of a surface's mesh, the free vertices' parameters being updated in place.
+ *
+ * Each vertex moves toward its neighbors' centroid on the surface, the move being projected on the tangent plane
+ * then pulled back to the parametric plane by a Gauss-Newton step and clamped to the surface's bounds.
+ * A move is only kept if no triangle is inverted in the parametric plane and the star's worst quality on the surface doesn't decrease.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param stars The vertices' stars.
+ * @param colors The free vertices grouped by color, see color_vertices.
+ * @param uv Callable returning a reference to a vertex's parameters from its index.
+ * @param srf The surface.
+ * @param n_iterations Maximum number of sweeps.
+ * @return size_t The number of vertices' moves.
+ */
+    template <std::floating_point T, size_t dim>
+    auto smooth_vertices_on_surface(const VertexStars &stars, const std::vector<std::vector<HeIndex>> &colors, auto &&uv, const Surface<T, dim> &srf, size_t n_iterations = 1) -> size_t
+    {
+        auto n_vertices = stars.free.size();
+        std::vector<std::array<T, dim>> points(n_vertices);
+        std::vector<size_t> indices(n_vertices);
+        std::iota(indices.begin(), indices.end(), size_t{});
+        std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t v) {
+            if (stars.offsets[v] != stars.offsets[v + 1])
+                points[v] = srf(uv(v));
+        });
+        auto [u1, u2, v1, v2] = srf.bounds();
+
+        auto star_quality = [&](size_t first, size_t last, const std::array<T, 2> &UV, const std::array<T, dim> &X) {
+            T q{1};
+            for (auto k = first; k < last; k++)
+            {
+                auto [a, b] = stars.links[k];
+                if (tri_quality<T, 2>(UV, uv(a), uv(b)) <= T(0))
+                    return std::numeric_limits<T>::lowest();
+                q = std::min(q, tri_quality<T, dim>(X, points[a], points[b]));
+            }
+            return q;
+        };
+
+        size_t n_moves{};
+        for (size_t it{}; it < n_iterations; it++)
+        {
+            size_t n_moves_it{};
+            for (const auto &color : colors)
+            {
+                n_moves_it += std::transform_reduce(
+                    std::execution::par,
+                    color.begin(), color.end(),
+                    size_t{},
+                    std::plus<>{},
+                    [&](HeIndex v) -> size_t {
+                        auto first = stars.offsets[v], last = stars.offsets[v + 1];
+                        auto &UV = uv(v);
+                        const auto &X = points[v];
+                        std::array<T, dim> G{};
+                        for (auto k = first; k < last; k++)
+                            G = G + points[stars.links[k][0]];
+                        auto d = G / static_cast<T>(last - first) - X;
+                        // tangential move, least squares in the parametric plane
+                        auto Su = srf(UV[0], UV[1], 1, 0);
+                        auto Sv = srf(UV[0], UV[1], 0, 1);
+                        auto a = Su * Su, b = Su * Sv, c = Sv * Sv;
+                        auto det = a * c - b * b;
+                        if (!(det > T(0)))
+                            return 0;
+                        auto du = (c * (Su * d) - b * (Sv * d)) / det;
+                        auto dv = (a * (Sv * d) - b * (Su * d)) / det;
+                        std::array<T, 2> UV_new{std::clamp(UV[0] + du, u1, u2), std::clamp(UV[1] + dv, v1, v2)};
+                        if (UV_new == UV)
+                            return 0;
+                        auto X_new = srf(UV_new);
+                        if (star_quality(first, last, UV_new, X_new) < star_quality(first, last, UV, X))
+                            return 0;
+                        UV = UV_new;
+                        points[v] = X_new;
+                        return 1;
+                    });
+            }
+            n_moves += n_moves_it;
+            if (n_moves_it == 0)
+                break;
+        }
+        return n_moves;
+    }
+
+/**
+ * @brief Tangential Laplacian smoothing of a surface's mesh given in the parametric plane, see smooth_vertices_on_surface.
+ *
+ * Vertices of constrained half-edges are not moved.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param faces_lst List of shared pointers to the parametric plane's triangles.
+ * @param srf The surface.
+ * @param n_iterations Maximum number of sweeps.
+ * @return size_t The number of vertices' moves.
+ */
+    template <std::floating_point T, size_t dim>
+    auto smooth_vertices_on_surface(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst, const Surface<T, dim> &srf, size_t n_iterations = 1) -> size_t
+    {
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
+        auto stars = make_vertex_stars(faces_lst, mesh);
+        auto colors = color_vertices(stars);
+        return smooth_vertices_on_surface<T, dim>(stars, colors, [&mesh](HeIndex v) -> auto & { return mesh.vertices[v]->coords; }, srf, n_iterations);
+    }
+}
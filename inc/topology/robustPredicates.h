@@ -0,0 +1,267 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <concepts>
+
+/**
+ * @file robustPredicates.h
+ * @brief Filtered exact orientation and in circle predicates, after J.R. Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates".
+ *
+ * Determinants are first evaluated in floating point. Their sign is returned when it is certified by the forward error bound.
+ * Otherwise, the determinant is evaluated exactly with floating point expansions, i.e. sums of non overlapping floating point numbers.
+ * Exactness requires IEEE 754 round to nearest arithmetic: do not build with -ffast-math or x87 extended precision.
+ */
+namespace gbs
+{
+    namespace expansion
+    {
+        /**
+         * @brief x + y = a + b exactly, with x = fl(a + b)
+         */
+        template <std::floating_point T>
+        inline void two_sum(T a, T b, T &x, T &y)
+        {
+            x = a + b;
+            T b_virtual = x - a;
+            T a_virtual = x - b_virtual;
+            y = (a - a_virtual) + (b - b_virtual);
+        }
+        /**
+         * @brief x + y = a + b exactly, with x = fl(a + b), requires |a| >= |b|
+         */
+        template <std::floating_point T>
+        inline void fast_two_sum(T a, T b, T &x, T &y)
+        {
+            x = a + b;
+            y = b - (x - a);
+        }
+        /**
+         * @brief x + y = a * b exactly, with x = fl(a * b)
+         */
+        template <std::floating_point T>
+        inline void two_product(T a, T b, T &x, T &y)
+        {
+            x = a * b;
+            y = std::fma(a, b, -x);
+        }
+        /**
+         * @brief Exact a - b as an expansion, components by increasing magnitude, zeros eliminated
+         */
+        template <std::floating_point T>
+        inline auto difference(T a, T b) -> std::vector<T>
+        {
+            T x, y;
+            two_sum(a, -b, x, y);
+            std::vector<T> h;
+            if (y != T(0))
+                h.push_back(y);
+            if (x != T(0))
+                h.push_back(x);
+            return h;
+        }
+        /**
+         * @brief Exact e + b, e being an expansion
+         */
+        template <std::floating_point T>
+        inline auto grow(const std::vector<T> &e, T b) -> std::vector<T>
+        {
+            std::vector<T> h;
+            h.reserve(e.size() + 1);
+            T q{b};
+            for (auto e_i : e)
+            {
+                T q_new, h_i;
+                two_sum(q, e_i, q_new, h_i);
+                q = q_new;
+                if (h_i != T(0))
+                    h.push_back(h_i);
+            }
+            if (q != T(0))
+                h.push_back(q);
+            return h;
+        }
+        /**
+         * @brief Exact e + f, e and f being expansions
+         */
+        template <std::floating_point T>
+        inline auto sum(const std::vector<T> &e, const std::vector<T> &f) -> std::vector<T>
+        {
+            auto h = e;
+            for (auto f_i : f)
+                h = grow(h, f_i);
+            return h;
+        }
+        /**
+         * @brief Exact -e
+         */
+        template <std::floating_point T>
+        inline auto negate(std::vector<T> e) -> std::vector<T>
+        {
+            for (auto &e_i : e)
+                e_i = -e_i;
+            return e;
+        }
+        /**
+         * @brief Exact e * b, e being an expansion
+         */
+        template <std::floating_point T>
+        inline auto scale(const std::vector<T> &e, T b) -> std::vector<T>
+        {
+            std::vector<T> h;
+            if (e.empty() || b == T(0))
+                return h;
+            h.reserve(2 * e.size());
+            T q, h_i;
+            two_product(e[0], b, q, h_i);
+            if (h_i != T(0))
+                h.push_back(h_i);
+            for (size_t i{1}; i < e.size(); i++)
+            {
+                T p1, p0, s;
+                two_product(e[i], b, p1, p0);
+                two_sum(q, p0, s, h_i);
+                if (h_i != T(0))
+                    h.push_back(h_i);
+                fast_two_sum(p1, s, q, h_i);
+                if (h_i != T(0))
+                    h.push_back(h_i);
+            }
+            if (q != T(0))
+                h.push_back(q);
+            return h;
+        }
+        /**
+         * @brief Exact e * f, e and f being expansions
+         */
+        template <std::floating_point T>
+        inline auto product(const std::vector<T> &e, const std::vector<T> &f) -> std::vector<T>
+        {
+            std::vector<T> h;
+            for (auto f_i : f)
+                h = sum(h, scale(e, f_i));
+            return h;
+        }
+        /**
+         * @brief Expansion's most significant component, which has the expansion's sign, 0 for a null expansion
+         */
+        template <std::floating_point T>
+        inline auto sign_component(const std::vector<T> &e) -> T
+        {
+            return e.empty() ? T(0) : e.back();
+        }
+    }
+
+    /**
+     * @brief Exact orientation of (a, b, c), see orient_2d_robust
+     */
+    template <std::floating_point T>
+    auto orient_2d_exact(T ax, T ay, T bx, T by, T cx, T cy) -> T
+    {
+        using namespace expansion;
+        auto acx = difference(ax, cx);
+        auto acy = difference(ay, cy);
+        auto bcx = difference(bx, cx);
+        auto bcy = difference(by, cy);
+        return sign_component(sum(product(acx, bcy), negate(product(acy, bcx))));
+    }
+
+    /**
+     * @brief Robust orientation of the triangle (a, b, c).
+     * The sign is exact: > 0 if counter clockwise, < 0 if clockwise, 0 if the points are aligned.
+     * The value is the determinant, exact up to the floating point precision.
+     */
+    template <std::floating_point T>
+    auto orient_2d_robust(T ax, T ay, T bx, T by, T cx, T cy) -> T
+    {
+        constexpr T eps = std::numeric_limits<T>::epsilon() / 2;
+        constexpr T err_bound = (T(3) + T(16) * eps) * eps;
+
+        T det_left = (ax - cx) * (by - cy);
+        T det_right = (ay - cy) * (bx - cx);
+        T det = det_left - det_right;
+
+        T det_sum;
+        if (det_left > T(0))
+        {
+            if (det_right <= T(0))
+                return det;
+            det_sum = det_left + det_right;
+        }
+        else if (det_left < T(0))
+        {
+            if (det_right >= T(0))
+                return det;
+            det_sum = -det_left - det_right;
+        }
+        else
+        {
+            return det;
+        }
+
+        if (std::abs(det) >= err_bound * det_sum)
+            return det;
+
+        return orient_2d_exact(ax, ay, bx, by, cx, cy);
+    }
+
+    /**
+     * @brief Exact position of d with respect to the circle through (a, b, c), see in_circle_robust
+     */
+    template <std::floating_point T>
+    auto in_circle_exact(T ax, T ay, T bx, T by, T cx, T cy, T dx, T dy) -> T
+    {
+        using namespace expansion;
+        auto adx = difference(ax, dx);
+        auto ady = difference(ay, dy);
+        auto bdx = difference(bx, dx);
+        auto bdy = difference(by, dy);
+        auto cdx = difference(cx, dx);
+        auto cdy = difference(cy, dy);
+
+        auto a_lift = sum(product(adx, adx), product(ady, ady));
+        auto b_lift = sum(product(bdx, bdx), product(bdy, bdy));
+        auto c_lift = sum(product(cdx, cdx), product(cdy, cdy));
+
+        auto bc = sum(product(bdx, cdy), negate(product(cdx, bdy)));
+        auto ca = sum(product(cdx, ady), negate(product(adx, cdy)));
+        auto ab = sum(product(adx, bdy), negate(product(bdx, ady)));
+
+        return sign_component(sum(sum(product(a_lift, bc), product(b_lift, ca)), product(c_lift, ab)));
+    }
+
+    /**
+     * @brief Robust position of d with respect to the circle through the counter clockwise triangle (a, b, c).
+     * The sign is exact: > 0 if d is inside the circle, < 0 if outside, 0 if on the circle.
+     * The value is the determinant, exact up to the floating point precision.
+     */
+    template <std::floating_point T>
+    auto in_circle_robust(T ax, T ay, T bx, T by, T cx, T cy, T dx, T dy) -> T
+    {
+        constexpr T eps = std::numeric_limits<T>::epsilon() / 2;
+        constexpr T err_bound = (T(10) + T(96) * eps) * eps;
+
+        T adx = ax - dx, ady = ay - dy;
+        T bdx = bx - dx, bdy = by - dy;
+        T cdx = cx - dx, cdy = cy - dy;
+
+        T bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        T cdxady = cdx * ady, adxcdy = adx * cdy;
+        T adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        T a_lift = adx * adx + ady * ady;
+        T b_lift = bdx * bdx + bdy * bdy;
+        T c_lift = cdx * cdx + cdy * cdy;
+
+        T det = a_lift * (bdxcdy - cdxbdy) + b_lift * (cdxady - adxcdy) + c_lift * (adxbdy - bdxady);
+        T permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * a_lift +
+                      (std::abs(cdxady) + std::abs(adxcdy)) * b_lift +
+                      (std::abs(adxbdy) + std::abs(bdxady)) * c_lift;
+
+        if (std::abs(det) > err_bound * permanent)
+            return det;
+
+        return in_circle_exact(ax, ay, bx, by, cx, cy, dx, dy);
+    }
+}
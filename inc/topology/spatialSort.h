@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <numeric>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include "baseGeom.h"
+
+namespace gbs
+{
+/**
+ * @brief Index of a point of a 2^order x 2^order grid along the Hilbert curve.
+ *
+ * @param x Grid's column, lower than 2^order.
+ * @param y Grid's row, lower than 2^order.
+ * @param order Curve's order, up to 32.
+ * @return std::uint64_t The distance along the curve.
+ */
+    inline auto hilbert_index(std::uint32_t x, std::uint32_t y, size_t order = 16) -> std::uint64_t
+    {
+        std::uint64_t d{};
+        for (std::uint64_t s = std::uint64_t{1} << (order - 1); s > 0; s /= 2)
+        {
+            std::uint32_t rx = (x & s) > 0;
+            std::uint32_t ry = (y & s) > 0;
+            d += s * s * ((3 * rx) ^ ry);
+            // rotate the quadrant
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = std::uint32_t(s - 1) - (x & std::uint32_t(s - 1));
+                    y = std::uint32_t(s - 1) - (y & std::uint32_t(s - 1));
+                }
+                std::swap(x, y);
+            }
+        }
+        return d;
+    }
+
+/**
+ * @brief Points' indices along the Hilbert curve covering the points' bounding box.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param coords The points' coordinates.
+ * @param order Hilbert curve's order, i.e. the bounding box is divided in 2^order x 2^order cells.
+ * @return std::vector<std::uint64_t> The points' Hilbert indices.
+ */
+    template <std::floating_point T>
+    auto hilbert_keys(const std::vector<std::array<T, 2>> &coords, size_t order = 16) -> std::vector<std::uint64_t>
+    {
+        std::vector<std::uint64_t> keys(coords.size());
+        if (coords.empty())
+            return keys;
+
+        auto [Xmin, Xmax] = getCoordsMinMax(coords);
+        auto n_cells = T((std::uint64_t{1} << order) - 1);
+        auto cell = [n_cells](T x, T x_min, T x_max) {
+            return x_max > x_min ? std::uint32_t(std::clamp((x - x_min) / (x_max - x_min), T(0), T(1)) * n_cells) : std::uint32_t{};
+        };
+        std::transform(coords.begin(), coords.end(), keys.begin(), [&](const auto &xy) {
+            return hilbert_index(cell(xy[0], Xmin[0], Xmax[0]), cell(xy[1], Xmin[1], Xmax[1]), order);
+        });
+        return keys;
+    }
+
+/**
+ * @brief Points' indices sorted along the Hilbert curve.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param coords The points' coordinates.
+ * @return std::vector<size_t> The indices' permutation.
+ */
+    template <std::floating_point T>
+    auto hilbert_order(const std::vector<std::array<T, 2>> &coords) -> std::vector<size_t>
+    {
+        auto keys = hilbert_keys(coords);
+        std::vector<size_t> order(coords.size());
+        std::iota(order.begin(), order.end(), size_t{});
+        std::sort(order.begin(), order.end(), [&keys](size_t i, size_t j) { return keys[i] < keys[j]; });
+        return order;
+    }
+
+/**
+ * @brief Biased Randomized Insertion Order, points' indices for incremental Delaunay triangulation.
+ *
+ * The points are randomly spread into rounds of doubling sizes, each round being sorted along the Hilbert curve.
+ * The randomization keeps the expected cost of incremental insertion optimal, while the sort keeps
+ * consecutive points close, hence short point location walks and a cache friendly working set.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @param coords The points' coordinates.
+ * @param min_round_size Size under which the first round is not split anymore.
+ * @param seed Random generator's seed, the order is reproducible.
+ * @return std::vector<size_t> The indices' permutation.
+ */
+    template <std::floating_point T>
+    auto brio_order(const std::vector<std::array<T, 2>> &coords, size_t min_round_size = 64, unsigned int seed = 0) -> std::vector<size_t>
+    {
+        auto keys = hilbert_keys(coords);
+        std::vector<size_t> order(coords.size());
+        std::iota(order.begin(), order.end(), size_t{});
+        std::shuffle(order.begin(), order.end(), std::mt19937{seed});
+
+        // Rounds' ends, from the last, half of the points, to the first
+        auto last = order.size();
+        while (last > 0)
+        {
+            auto first = last > min_round_size ? last / 2 : size_t{};
+            std::sort(std::next(order.begin(), first), std::next(order.begin(), last), [&keys](size_t i, size_t j) { return keys[i] < keys[j]; });
+            last = first;
+        }
+
+        return order;
+    }
+}
@@ -4,6 +4,11 @@
 #include <vector>
 #include <algorithm>
 #include <span>
+#include <deque>
+#include <unordered_set>
+#include <unordered_map>
+#include <stdexcept>
+#include <execution>
 
 #include <gbs/surfaces>
 #include <gbs/bscanalysis.h>
@@ -17,6 +22,8 @@
 #include "halfEdgeMeshGeomTests.h"
 #include "halfEdgeMeshSmoothing.h"
 #include "baseGeom.h"
+#include "spatialSort.h"
+#include "halfEdgeMeshQueue.h"
 
 namespace gbs
 {
@@ -59,74 +66,282 @@ namespace gbs
         return coords;
     }
 
+/**
+ * @brief Locates the face containing a point by a visibility walk through faces' adjacency.
+ *
+ * From the starting face, the walk crosses any edge having the point on its right side until none remains.
+ * In a Delaunay triangulation, the walk always ends, the cost is proportional to the number of crossed faces.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param h_f_start The face from which the walk starts, ideally close to the point.
+ * @param xy The point to locate.
+ * @param max_steps Maximum number of crossed faces, guards against cycles on degenerated meshes.
+ * @return The face containing the point, nullptr if the walk leaves the mesh or exceeds max_steps.
+ */
+    template <std::floating_point T>
+    auto locateFace(const std::shared_ptr<HalfEdgeFace<T, 2>> &h_f_start, const std::array<T, 2> &xy, size_t max_steps = std::numeric_limits<size_t>::max()) -> std::shared_ptr<HalfEdgeFace<T, 2>>
+    {
+        auto h_f = h_f_start;
+        for (size_t step{}; h_f && step < max_steps; step++)
+        {
+            // The first tested edge changes at each step to avoid cycling
+            auto h_e_start = h_f->edge;
+            for (size_t i{}; i < step % 3; i++)
+            {
+                h_e_start = h_e_start->next;
+            }
+
+            std::shared_ptr<HalfEdge<T, 2>> h_e_cross{};
+            auto h_e = h_e_start;
+            do
+            {
+                if (orient_2d(h_e->previous->vertex->coords, h_e->vertex->coords, xy) < 0)
+                {
+                    h_e_cross = h_e;
+                    break;
+                }
+                h_e = h_e->next;
+            } while (h_e != h_e_start);
+
+            if (!h_e_cross)
+            {
+                return h_f;
+            }
+            h_f = h_e_cross->opposite ? h_e_cross->opposite->face : nullptr;
+        }
+        return nullptr;
+    }
+
+/**
+ * @brief Locates the face of a mesh containing a point, see locateFace.
+ *
+ * The walk may leave a non convex mesh, e.g. once the encompassing mesh's faces are removed, the faces are then scanned.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param h_f_lst The mesh's faces.
+ * @param h_f_start The face from which the walk starts, ideally close to the point.
+ * @param xy The point to locate.
+ * @return The face containing the point, nullptr if the point is outside the mesh.
+ */
+    template <std::floating_point T>
+    auto locateFace(const std::ranges::range auto &h_f_lst, const std::shared_ptr<HalfEdgeFace<T, 2>> &h_f_start, const std::array<T, 2> &xy) -> std::shared_ptr<HalfEdgeFace<T, 2>>
+    {
+        if (auto h_f = locateFace(h_f_start, xy))
+        {
+            return h_f;
+        }
+        auto it = std::ranges::find_if(h_f_lst, [&xy](const auto &h_f) {
+            return std::ranges::all_of(getFaceEdges(h_f), [&xy](const auto &h_e) {
+                return orient_2d(h_e->previous->vertex->coords, h_e->vertex->coords, xy) >= 0;
+            });
+        });
+        return it != std::ranges::end(h_f_lst) ? *it : nullptr;
+    }
+
+/**
+ * @brief Gets the faces whose circumcircle contains a point, grown from a seed face through faces' adjacency.
+ *
+ * The cavity doesn't grow across constrained edges, hence insertions keep a constrained Delaunay triangulation.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance values.
+ * @param h_f_seed A face whose circumcircle contains the point.
+ * @param xy The point's coordinates.
+ * @param tol Tolerance for the Delaunay condition.
+ * @return The list of faces violating the Delaunay condition, starting with the seed.
+ */
+    template <std::floating_point T>
+    auto getDelaunayCavity(const std::shared_ptr<HalfEdgeFace<T, 2>> &h_f_seed, const std::array<T, 2> &xy, T tol)
+    {
+        std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> cavity{h_f_seed};
+        std::unordered_set<HalfEdgeFace<T, 2> *> visited{h_f_seed.get()};
+
+        // The list grows while being traversed
+        for (auto it = cavity.begin(); it != cavity.end(); ++it)
+        {
+            for (const auto &h_e : getFaceEdges(*it))
+            {
+                if (h_e->opposite && !h_e->constrained && visited.insert(h_e->opposite->face.get()).second && in_circle(xy, h_e->opposite->face) > tol)
+                {
+                    cavity.push_back(h_e->opposite->face);
+                }
+            }
+        }
+
+        return cavity;
+    }
+
+/**
+ * @brief Fills a Delaunay cavity with a fan of triangles around a new vertex.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param cavity The faces to replace.
+ * @param xy The new vertex's coordinates.
+ * @return A pair (new vertex, the newly created HalfEdgeFaces).
+ */
+    template <std::floating_point T>
+    auto fillDelaunayCavity(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &cavity, const std::array<T, 2> &xy)
+    {
+        // Get cavity boundary
+        auto h_e_lst = getOrientedFacesBoundary(cavity);
+        assert(are_edges_2d_ccw<T>(h_e_lst));
+
+        // fill cavity
+        auto vtx = make_shared_h_vertex(xy);
+        auto h_f_lst_new = add_vertex(h_e_lst, vtx);
+        assert(are_face_ccw(h_f_lst_new));
+        // The boundary's vertices may refer to a removed half-edge
+        for (const auto &h_e : h_e_lst)
+        {
+            h_e->vertex->edge = h_e;
+        }
+
+        return std::make_pair(vtx, std::move(h_f_lst_new));
+    }
+
+/**
+ * @brief Gives the cavity's face objects to the first triangles of the fan filling it, see fillDelaunayCavity.
+ *
+ * Containers holding the cavity's faces then hold valid faces without being searched,
+ * only the remaining fan's faces, two for a Delaunay cavity, are to be added to them.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param cavity The replaced faces, their objects are recycled.
+ * @param h_f_lst_new The fan's faces, the first ones are replaced by the cavity's objects.
+ * @return Iterator to the first fan's face which isn't a recycled object.
+ */
+    template <std::floating_point T>
+    auto recycleDelaunayCavity(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &cavity, std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &h_f_lst_new)
+    {
+        assert(h_f_lst_new.size() >= cavity.size());
+        auto it_new = h_f_lst_new.begin();
+        for (const auto &h_f_old : cavity)
+        {
+            h_f_old->edge = (*it_new)->edge;
+            for (const auto &h_e : getFaceEdges(h_f_old))
+            {
+                h_e->face = h_f_old;
+            }
+            *it_new++ = h_f_old;
+        }
+        return it_new;
+    }
+
 /**
  * @brief Inserts a point into a Delaunay triangulation using the Boyer-Watson algorithm.
  *
+ * The face containing the point is found by walking from the last face of the container, which is the last created one when inserting points in sequence.
+ * If the walk leaves a non convex mesh, the container is scanned for the face containing the point, see locateFace.
+ * Points outside the mesh are rejected, the container is left unchanged.
+ * The cavity then grows through faces' adjacency. Its faces are recycled for the new triangles, hence they keep their place
+ * in the container and only the two extra triangles are appended, the update costs as much as the cavity's size.
+ *
  * @tparam T A floating-point type used for coordinates and tolerance values.
  * @tparam Container A container type representing the list of HalfEdgeFaces.
  * @param h_f_lst A reference to the container of HalfEdgeFaces forming the initial Delaunay triangulation.
  * @param xy An array containing the coordinates of the point to be inserted.
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
- * @return A tuple ( new vertex, deleted HalfEdgeFaces that were violating the Delaunay condition, the newly created HalfEdgeFaces).
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @return A tuple ( new vertex, copies of the deleted HalfEdgeFaces that were violating the Delaunay condition, the newly created HalfEdgeFaces).
  */
-    template<std::floating_point T, typename Container>
-    auto boyerWatson(Container& h_f_lst, const std::array<T, 2>& xy, T tol = T{1e-10}) {
+    template<std::floating_point T, std::ranges::range Container>
+    auto boyerWatson(Container& h_f_lst, const std::array<T, 2>& xy, T tol = T{}) {
         using std::begin;
         using std::end;
+        using Result = std::tuple<std::shared_ptr<HalfEdgeVertex<T, 2>>, Container, Container>;
 
-        auto it{begin(h_f_lst)};
-        Container h_f_lst_deleted;
+        if (h_f_lst.empty()) {
+            return Result{};
+        }
 
-        // Find triangle violation Delaunay condition
-        while (it != end(h_f_lst)) {
-            it = find_if(it, end(h_f_lst), [xy, tol](const auto& h_f) {
-                return in_circle(xy, h_f) > tol;
-            });
-            if (it != end(h_f_lst)) {
-                h_f_lst_deleted.push_back(*it);
-                it = h_f_lst.erase(it);
-            }
+        // Find the triangle containing the point, it violates Delaunay condition
+        auto h_f = locateFace(h_f_lst, h_f_lst.back(), xy);
+        if (!h_f || in_circle(xy, h_f) <= tol) {
+            return Result{}; // if point is outside or confused with an existing point
         }
 
-        if (h_f_lst_deleted.empty()) {
-            return std::tuple<std::shared_ptr<HalfEdgeVertex<T, 2>>,Container, Container>{}; // if point is outside or confused with an existing point
+        auto cavity = getDelaunayCavity(h_f, xy, tol);
+        std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> h_f_lst_deleted;
+        for (const auto &h_f_del : cavity) {
+            h_f_lst_deleted.push_back(std::make_shared<HalfEdgeFace<T, 2>>(*h_f_del));
         }
 
+        auto [vtx, h_f_lst_new] = fillDelaunayCavity(cavity, xy);
+
+        // recycle cavity's faces, the fan has two more faces than the cavity
+        assert(h_f_lst_new.size() == cavity.size() + 2);
+        auto it_new = recycleDelaunayCavity(cavity, h_f_lst_new);
+        h_f_lst.insert(end(h_f_lst), it_new, end(h_f_lst_new));
+
         assert(are_face_ccw(h_f_lst));
 
-        // Get cavity boundary
-        auto h_e_lst = getOrientedFacesBoundary(h_f_lst_deleted);
-        assert(are_edges_2d_ccw<T>(h_e_lst));
+        return std::make_tuple(vtx, Container(begin(h_f_lst_deleted), end(h_f_lst_deleted)), Container(begin(h_f_lst_new), end(h_f_lst_new)));
+    }
 
-        // fill cavity
-        auto vtx = make_shared_h_vertex(xy);
-        auto h_f_lst_new = add_vertex(h_e_lst, vtx);
-        assert(are_face_ccw(h_f_lst_new));
+/**
+ * @brief Inserts a point into a Delaunay triangulation using the Boyer-Watson algorithm, without any faces' container.
+ *
+ * The face containing the point is found by walking from a given face, the cavity grows through faces' adjacency.
+ * Hence the insertion's cost doesn't depend on the mesh size when the points are spatially sorted.
+ * The point must lie inside the mesh.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance values.
+ * @param h_f_start The face from which the point's location starts, typically one of the last created faces.
+ * @param xy An array containing the coordinates of the point to be inserted.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @return A tuple ( new vertex, deleted HalfEdgeFaces that were violating the Delaunay condition, the newly created HalfEdgeFaces).
+ */
+    template<std::floating_point T>
+    auto boyerWatson(const std::shared_ptr<HalfEdgeFace<T, 2>> &h_f_start, const std::array<T, 2>& xy, T tol = T{}) {
+        using Faces = std::list<std::shared_ptr<HalfEdgeFace<T, 2>>>;
+
+        auto h_f = locateFace(h_f_start, xy);
+        if (!h_f || in_circle(xy, h_f) <= tol) {
+            return std::tuple<std::shared_ptr<HalfEdgeVertex<T, 2>>, Faces, Faces>{}; // if point is outside or confused with an existing point
+        }
 
-        // append new faces
-        h_f_lst.insert(end(h_f_lst), begin(h_f_lst_new), end(h_f_lst_new));
+        auto cavity = getDelaunayCavity(h_f, xy, tol);
+        auto [vtx, h_f_lst_new] = fillDelaunayCavity(cavity, xy);
 
-        return std::make_tuple(vtx, std::move(h_f_lst_deleted), std::move(h_f_lst_new));
+        return std::make_tuple(vtx, std::move(cavity), std::move(h_f_lst_new));
     }
 
 /**
  * @brief Computes the Delaunay triangulation of a 2D point set using the Boyer-Watson algorithm.
  *
+ * Each point is located by walking from the last created face, the faces' list is only rebuilt once all the points are inserted.
+ * With spatial_sort, points are inserted in Biased Randomized Insertion Order, see brio_order, which keeps walks short.
+ *
  * @tparam T A floating-point type used for coordinates and tolerance.
- * @param coords A container of 2D coordinates representing the input points.
- * @param tol A floating-point value used as tolerance for the Delaunay condition.
+ * @param coords A std::vector of 2D coordinates (std::array<T, 2>) representing the input points.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @param spatial_sort Insert points in BRIO order instead of the input order (default is true).
  * @return A container of triangulated faces forming the Delaunay triangulation.
  */
     template < std::floating_point T>
-    auto delaunay2DBoyerWatson(const auto &coords, T tol)
+    auto delaunay2DBoyerWatson(const std::vector< std::array<T,2> > &coords, T tol = 0, bool spatial_sort = true)
     {
         auto faces_lst = getEncompassingMesh(coords);
         auto vertices = getVerticesVectorFromFaces<T,2>(faces_lst);
+        std::vector<size_t> order;
+        if(spatial_sort)
+        {
+            order = brio_order(coords);
+        }
+        else
+        {
+            order.resize(coords.size());
+            std::iota(order.begin(), order.end(), size_t{});
+        }
         // insert points
-        for(const auto &xy : coords)
+        auto h_f = faces_lst.back();
+        for(auto i : order)
         {
-            boyerWatson<T>(faces_lst, xy, tol);
+            auto h_f_lst_new = std::get<2>(boyerWatson<T>(h_f, coords[i], tol));
+            if(!h_f_lst_new.empty())
+            {
+                h_f = h_f_lst_new.back();
+            }
         }
+        faces_lst = getConnectedFaces(h_f);
 
         // remove external mesh, i.ei faces attached to initial vertices
         for(const auto &vtx : vertices)
@@ -137,166 +352,622 @@ namespace gbs
         return faces_lst;
     }
 /**
- * @brief Computes the Delaunay triangulation of a 2D point set with inner boundaries using the Boyer-Watson algorithm.
+ * @brief Computes the Delaunay triangulation of a 2D point set using the Boyer-Watson algorithm.
+ *
+ * This function is an overload that accepts any range of points convertible to std::array<T, 2>, they are copied to a std::vector.
  *
  * @tparam T A floating-point type used for coordinates and tolerance.
- * @param coords_boundary A container of 2D coordinates representing the outer boundary input points.
- * @param coords_inner A container of 2D coordinates representing the inner boundary input points.
+ * @param coords A range of 2D coordinates representing the input points.
  * @param tol A floating-point value used as tolerance for the Delaunay condition.
- * @return A container of triangulated faces forming the Delaunay triangulation with inner boundaries.
+ * @param spatial_sort Insert points in BRIO order instead of the input order.
+ * @return A container of triangulated faces forming the Delaunay triangulation.
  */
-    template < std::floating_point T >
-    auto delaunay2DBoyerWatson(const auto &coords_boundary,const auto &coords_inner, T tol)
+    template < std::floating_point T>
+    auto delaunay2DBoyerWatson(const std::ranges::input_range auto &coords, T tol, bool spatial_sort = true)
+    requires std::convertible_to<std::ranges::range_value_t<decltype(coords)>, std::array<T, 2>>
     {
-        auto faces_lst = delaunay2DBoyerWatson(coords_boundary, tol);
-        auto boundary_inner = make_HalfEdges<T>(coords_inner);
-        takeInternalFaces<T>(faces_lst,boundary_inner);
-        return faces_lst;
+        return delaunay2DBoyerWatson<T>(std::vector< std::array<T,2> >(std::ranges::begin(coords), std::ranges::end(coords)), tol, spatial_sort);
     }
 /**
- * @brief Computes the Delaunay triangulation of a 2D point set using the Boyer-Watson algorithm.
+ * @brief Gets the vertex of a face which is the closest to a point.
  *
- * This function is an overload that accepts a specific container type (std::vector<std::array<T, 2>>) for input points.
+ * The vertex's half-edge is set to the face's half-edge ending at it, so that the vertex's star can be walked from it.
  *
- * @tparam T A floating-point type used for coordinates and tolerance.
- * @param coords A std::vector of 2D coordinates (std::array<T, 2>) representing the input points.
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
- * @return A container of triangulated faces forming the Delaunay triangulation.
+ * @tparam T A floating-point type used for coordinates.
+ * @param h_f The face.
+ * @param xy The point's coordinates.
+ * @return The closest vertex.
  */
-    template < std::floating_point T>
-    auto delaunay2DBoyerWatson(const std::vector< std::array<T,2> > &coords, T tol = 1e-10)
+    template <std::floating_point T>
+    auto getClosestFaceVertex(const std::shared_ptr<HalfEdgeFace<T, 2>> &h_f, const std::array<T, 2> &xy)
     {
-        return delaunay2DBoyerWatson<T,std::vector< std::array<T,2> >>(coords, tol);
+        auto h_e_lst = getFaceEdges(h_f);
+        auto h_e = *std::ranges::min_element(h_e_lst, {}, [&xy](const auto &h_e) { return sq_norm(h_e->vertex->coords - xy); });
+        h_e->vertex->edge = h_e;
+        return h_e->vertex;
     }
+
 /**
- * @brief Refines a 2D Delaunay triangulation of a surface mesh using the Boyer-Watson algorithm.
+ * @brief Fills one side of a constrained segment's cavity, a pseudo-polygon, with Delaunay triangles.
  *
- * @tparam T A floating-point type used for coordinates, tolerance, and criteria values.
- * @tparam dim A size_t value representing the dimension of the surface.
- * @tparam _Func A callable object type used for distance calculation between mesh and surface.
- * @param srf A surface on which the mesh refinement is performed.
- * @param faces_lst A reference to the container of triangulated faces forming the surface mesh.
- * @param crit_max A floating-point value specifying the maximum allowed distance criterion for refinement.
- * @param max_inner_points A size_t value specifying the maximum number of inner points allowed for refinement (default is 500).
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
- * @return A container of triangulated faces forming the refined Delaunay triangulation of the surface mesh.
+ * The pseudo-polygon is the chain of half-edges from u to w, closed by the base half-edge from w to u.
+ * The triangle on the base is made with the chain's vertex whose circumcircle contains no other chain's vertex,
+ * both sides of the triangle being filled recursively. The chain's vertices may repeat, when a face is nested between the segment and a vertex.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param chain The cavity's boundary half-edges, counter clockwise from u to w, at least 2.
+ * @param h_e_base The base half-edge, from w to u.
+ * @param faces The list to which the new faces are appended.
  */
-    template <std::floating_point T, size_t dim, typename _Func>
-    auto delaunay2DBoyerWatsonSurfaceMeshRefine(const Surface<T, dim> &srf, auto &faces_lst, T crit_max, size_t max_inner_points = 500, T tol = 1e-10)
+    template <std::floating_point T>
+    void retriangulatePseudoPolygon(std::span<const std::shared_ptr<HalfEdge<T, 2>>> chain, const std::shared_ptr<HalfEdge<T, 2>> &h_e_base, std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces)
     {
-        _Func dist_mesh_srf{srf};
+        assert(chain.size() > 1);
+        auto h_v_u = h_e_base->vertex;
+        auto h_v_w = chain.back()->vertex;
 
-        // Store face quality in a map
-        std::unordered_map<std::shared_ptr<HalfEdgeFace<T, 2>>, T> face_quality;
+        size_t m{};
+        for (size_t i{1}; i + 1 < chain.size(); i++)
+        {
+            if (in_circle(h_v_u->coords, chain[m]->vertex->coords, h_v_w->coords, chain[i]->vertex->coords) > 0)
+            {
+                m = i;
+            }
+        }
+        auto h_v_c = chain[m]->vertex;
 
-        // Function to update face quality map
-        auto update_face_quality = [&dist_mesh_srf, &face_quality](const auto &hf) {
-            face_quality[hf] = dist_mesh_srf(hf).first;
+        auto make_side = [&faces](std::span<const std::shared_ptr<HalfEdge<T, 2>>> sub_chain, const auto &h_v_from, const auto &h_v_to) {
+            if (sub_chain.size() == 1)
+            {
+                return sub_chain.front();
+            }
+            auto h_e = make_shared_h_edge(h_v_to);
+            auto h_e_twin = make_shared_h_edge(h_v_from);
+            link_edges(h_e, h_e_twin);
+            retriangulatePseudoPolygon(sub_chain, h_e_twin, faces);
+            return h_e;
         };
 
-        // Initialize face quality map
-        for (const auto &face : faces_lst)
+        auto lst = {make_side(chain.first(m + 1), h_v_u, h_v_c), make_side(chain.subspan(m + 1), h_v_c, h_v_w), h_e_base};
+        faces.push_back(make_shared_h_face<T, 2>(lst));
+        assert(is_ccw(faces.back()));
+        for (const auto &h_e : lst)
         {
-            update_face_quality(face);
+            h_e->vertex->edge = h_e;
         }
+    }
 
-        // Refine mesh to match max criteria
-        T crit = std::numeric_limits<T>::max();
-        for (size_t i{}; i < max_inner_points && crit > crit_max; i++)
-        {
-            auto it = std::max_element(
-                std::execution::par,
-                faces_lst.begin(), faces_lst.end(),
-                [&face_quality](const auto &hf1, const auto &hf2) {
-                    return face_quality[hf1] < face_quality[hf2];
-                });
-
-            auto d_G_UV = dist_mesh_srf(*it);
-            crit = d_G_UV.first;
+/**
+ * @brief Inserts a constrained segment between two vertices of a triangulation.
+ *
+ * The faces crossed by the segment are found by walking from the first vertex's star. They are removed and both sides
+ * of the segment are retriangulated, see retriangulatePseudoPolygon. Vertices lying on the segment split it.
+ * The segment's half-edges are marked as constrained.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param h_v_a The segment's first vertex.
+ * @param h_v_b The segment's last vertex.
+ * @return A tuple ( the segment's half-edges, one per sub-segment, deleted HalfEdgeFaces, the newly created HalfEdgeFaces).
+ * @throw std::invalid_argument if the segment leaves the mesh or crosses another constraint.
+ */
+    template <std::floating_point T>
+    auto insertConstraint(const std::shared_ptr<HalfEdgeVertex<T, 2>> &h_v_a, const std::shared_ptr<HalfEdgeVertex<T, 2>> &h_v_b)
+    {
+        using Edge = std::shared_ptr<HalfEdge<T, 2>>;
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
+        std::list<Edge> constrained;
+        std::list<Face> deleted, added;
 
-            auto [vtx, deleted_faces_list, new_faces_list] = boyerWatson(faces_lst, d_G_UV.second, tol);
+        const auto &b = h_v_b->coords;
+        auto h_v_start = h_v_a;
+        while (h_v_start != h_v_b)
+        {
+            const auto &a = h_v_start->coords;
+            // Search the segment's direction in the star of its start
+            Edge h_e_aligned{}, h_e_cross{};
+            for (const auto &h_f : getFacesAttachedToVertex(h_v_start))
+            {
+                auto h_e_a = getFaceEdge(h_f, h_v_start); // from q to a
+                auto h_e_p = h_e_a->next;                 // from a to p
+                auto h_e_q = h_e_p->next;                 // from p to q
+                const auto &p = h_e_p->vertex->coords;
+                const auto &q = h_e_q->vertex->coords;
+                if (orient_2d(a, b, p) == 0 && (p - a) * (b - a) > 0)
+                {
+                    h_e_aligned = h_e_p;
+                    break;
+                }
+                if (orient_2d(a, b, q) == 0 && (q - a) * (b - a) > 0)
+                {
+                    h_e_aligned = h_e_a;
+                    break;
+                }
+                if (orient_2d(a, p, b) > 0 && orient_2d(a, q, b) < 0)
+                {
+                    h_e_cross = h_e_q;
+                    break;
+                }
+            }
 
-            for (const auto &face : deleted_faces_list)
+            if (h_e_aligned)
+            {
+                h_e_aligned->constrained = true;
+                if (h_e_aligned->opposite)
+                {
+                    h_e_aligned->opposite->constrained = true;
+                }
+                constrained.push_back(h_e_aligned);
+                h_v_start = h_e_aligned->vertex == h_v_start ? h_e_aligned->previous->vertex : h_e_aligned->vertex;
+                continue;
+            }
+            if (!h_e_cross)
             {
-                face_quality.erase(face);
+                throw std::invalid_argument("insertConstraint: the segment leaves the mesh");
             }
 
-            for (const auto &face : new_faces_list)
+            // Walk along the segment, the crossed half-edges go from its right side to its left side.
+            // The cavity's boundary half-edges are gathered on each side.
+            std::list<Face> crossed{h_e_cross->face};
+            std::vector<Edge> chain_right{h_e_cross->previous}, chain_left{h_e_cross->next};
+            std::shared_ptr<HalfEdgeVertex<T, 2>> h_v_end{};
+            while (!h_v_end)
             {
-                update_face_quality(face);
+                if (h_e_cross->constrained)
+                {
+                    throw std::invalid_argument("insertConstraint: the segment crosses another constraint");
+                }
+                if (!h_e_cross->opposite)
+                {
+                    throw std::invalid_argument("insertConstraint: the segment leaves the mesh");
+                }
+                auto h_e_in = h_e_cross->opposite;
+                crossed.push_back(h_e_in->face);
+                auto h_v_s = h_e_in->next->vertex;
+                auto side = orient_2d(a, b, h_v_s->coords);
+                if (h_v_s == h_v_b || side == 0)
+                {
+                    h_v_end = h_v_s;
+                    chain_right.push_back(h_e_in->next);
+                    chain_left.push_back(h_e_in->next->next);
+                }
+                else if (side > 0)
+                {
+                    chain_left.push_back(h_e_in->next->next);
+                    h_e_cross = h_e_in->next;
+                }
+                else
+                {
+                    chain_right.push_back(h_e_in->next);
+                    h_e_cross = h_e_in->next->next;
+                }
             }
+            // counter clockwise order
+            std::ranges::reverse(chain_left);
+
+            // Retriangulate both sides of the segment
+            auto h_e_forward = make_shared_h_edge(h_v_end);
+            auto h_e_backward = make_shared_h_edge(h_v_start);
+            link_edges(h_e_forward, h_e_backward);
+            h_e_forward->constrained = true;
+            h_e_backward->constrained = true;
+            retriangulatePseudoPolygon<T>(chain_right, h_e_backward, added);
+            retriangulatePseudoPolygon<T>(chain_left, h_e_forward, added);
+
+            constrained.push_back(h_e_forward);
+            deleted.splice(deleted.end(), crossed);
+            h_v_start = h_v_end;
         }
 
-        return faces_lst;
+        return std::make_tuple(std::move(constrained), std::move(deleted), std::move(added));
     }
 
+/**
+ * @brief Gets, for each face connected to the seeds, the minimum number of constrained edges crossed to reach it from the seeds.
+ *
+ * Faces are flooded through adjacency, a 0-1 breadth first search, so the cost is linear in the number of faces.
+ *
+ * @tparam T A floating-point type used for coordinates.
+ * @param seeds The faces at depth 0.
+ * @return The faces' depths, indexed by the faces' address.
+ */
+    template <std::floating_point T>
+    auto getConstrainedDepths(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &seeds)
+    {
+        std::unordered_map<HalfEdgeFace<T, 2> *, size_t> depths;
+        std::deque<std::pair<std::shared_ptr<HalfEdgeFace<T, 2>>, size_t>> front;
+        for (const auto &h_f : seeds)
+        {
+            front.emplace_back(h_f, 0);
+        }
 
-    template <std::floating_point T, size_t dim, typename _Func>
-    auto delaunay2DBoyerWatsonMeshRefine(auto &faces_lst, T crit_max, const _Func &dist_mesh, size_t max_inner_points = 500, T tol = 1e-10)
+        while (!front.empty())
+        {
+            auto [h_f, depth] = front.front();
+            front.pop_front();
+            if (!depths.emplace(h_f.get(), depth).second)
+            {
+                continue;
+            }
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                if (h_e->opposite && !depths.contains(h_e->opposite->face.get()))
+                {
+                    if (h_e->constrained)
+                    {
+                        front.emplace_back(h_e->opposite->face, depth + 1);
+                    }
+                    else
+                    {
+                        front.emplace_front(h_e->opposite->face, depth);
+                    }
+                }
+            }
+        }
+
+        return depths;
+    }
+
+/**
+ * @brief Computes the constrained Delaunay triangulation of a domain bounded by closed polygons.
+ *
+ * All the points are inserted as in delaunay2DBoyerWatson, then the boundaries' segments are recovered, see insertConstraint.
+ * The domain's faces, those nested in an odd number of boundaries, are found by flooding the faces from the encompassing mesh.
+ * Boundaries' orientation doesn't matter, they must not cross each other.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance.
+ * @param boundaries The closed boundaries, outer and inner ones, the last point is not repeated.
+ * @param coords_inner Points to be inserted inside the domain.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @param spatial_sort Insert points in BRIO order instead of the input order (default is true).
+ * @return A container of triangulated faces, the boundaries' half-edges are constrained.
+ */
+    template <std::floating_point T>
+    auto delaunay2DConstrained(const std::vector<std::vector<std::array<T, 2>>> &boundaries, const std::vector<std::array<T, 2>> &coords_inner = {}, T tol = 0, bool spatial_sort = true)
     {
-        // Store face quality in a map
-        std::unordered_map<std::shared_ptr<HalfEdgeFace<T, dim>>, T> face_quality;
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
 
-        // Function to update face quality map
-        auto update_face_quality = [&dist_mesh, &face_quality](const auto &hf) {
-            face_quality[hf] = dist_mesh(hf).first;
-        };
+        std::vector<std::array<T, 2>> coords;
+        for (const auto &boundary : boundaries)
+        {
+            coords.insert(coords.end(), boundary.begin(), boundary.end());
+        }
+        coords.insert(coords.end(), coords_inner.begin(), coords_inner.end());
+        if (coords.empty())
+        {
+            return std::list<Face>{};
+        }
 
-        // Initialize face quality map
-        for (const auto &face : faces_lst)
+        auto faces_lst = getEncompassingMesh(coords);
+        auto vertices_ext = getVerticesVectorFromFaces<T, 2>(faces_lst);
+        std::vector<size_t> order;
+        if (spatial_sort)
+        {
+            order = brio_order(coords);
+        }
+        else
         {
-            update_face_quality(face);
+            order.resize(coords.size());
+            std::iota(order.begin(), order.end(), size_t{});
         }
 
-        // Refine mesh to match max criteria
-        T crit = std::numeric_limits<T>::max();
-        for (size_t i{}; i < max_inner_points && crit >= crit_max; i++)
+        // insert points, points confused with an existing vertex are merged
+        std::vector<std::shared_ptr<HalfEdgeVertex<T, 2>>> vertices(coords.size());
+        auto h_f = faces_lst.back();
+        for (auto i : order)
         {
-            auto it = std::max_element(
-                std::execution::par,
-                faces_lst.begin(), faces_lst.end(),
-                [&face_quality](const auto &hf1, const auto &hf2) {
-                    return face_quality[hf1] < face_quality[hf2];
-                });
+            auto [vtx, deleted, added] = boyerWatson<T>(h_f, coords[i], tol);
+            if (vtx)
+            {
+                h_f = added.back();
+                vertices[i] = vtx;
+            }
+            else if (auto h_f_xy = locateFace(h_f, coords[i]))
+            {
+                vertices[i] = getClosestFaceVertex(h_f_xy, coords[i]);
+            }
+        }
 
-            auto d_G_UV = dist_mesh(*it);
-            crit = d_G_UV.first;
+        // recover boundaries
+        size_t offset{};
+        for (const auto &boundary : boundaries)
+        {
+            auto n = boundary.size();
+            for (size_t i{}; i < n; i++)
+            {
+                const auto &h_v_a = vertices[offset + i];
+                const auto &h_v_b = vertices[offset + (i + 1) % n];
+                if (h_v_a && h_v_b && h_v_a != h_v_b)
+                {
+                    auto added = std::get<2>(insertConstraint(h_v_a, h_v_b));
+                    if (!added.empty())
+                    {
+                        h_f = added.back();
+                    }
+                }
+            }
+            offset += n;
+        }
+        faces_lst = getConnectedFaces(h_f);
 
-            // std::cout << crit << " inserting: " << d_G_UV.second[0] << " " << d_G_UV.second[1] << std::endl;
+        // flood from the encompassing mesh's faces
+        std::list<Face> seeds;
+        std::ranges::copy_if(faces_lst, std::back_inserter(seeds), [&vertices_ext](const auto &h_f) {
+            return std::ranges::any_of(getFaceVertices(h_f), [&vertices_ext](const auto &vtx) { return std::ranges::find(vertices_ext, vtx) != vertices_ext.end(); });
+        });
+        auto depths = getConstrainedDepths(seeds);
+        takeFaces(faces_lst, [&depths](const auto &h_f) { return depths.at(h_f.get()) % 2 == 0; });
 
-            auto [vtx, deleted_faces_list, new_faces_list] = boyerWatson(faces_lst, d_G_UV.second, tol);
+        return faces_lst;
+    }
 
-            for (const auto &face : deleted_faces_list)
+/**
+ * @brief Computes the Delaunay triangulation of a 2D point set with inner boundaries using the Boyer-Watson algorithm.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance.
+ * @param coords_boundary A container of 2D coordinates representing the outer boundary input points.
+ * @param coords_inner A container of 2D coordinates representing the inner boundary input points.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition.
+ * @param spatial_sort Insert points in BRIO order instead of the input order.
+ * @return A container of triangulated faces forming the Delaunay triangulation with inner boundaries.
+ */
+    template < std::floating_point T >
+    auto delaunay2DBoyerWatson(const auto &coords_boundary,const auto &coords_inner, T tol, bool spatial_sort = true)
+    {
+        auto faces_lst = delaunay2DBoyerWatson(coords_boundary, tol, spatial_sort);
+        auto boundary_inner = make_HalfEdges<T>(coords_inner);
+        takeInternalFaces<T>(faces_lst,boundary_inner);
+        return faces_lst;
+    }
+/**
+ * @brief Computes the constrained Delaunay triangulation of a domain bounded by an outer and an inner boundary.
+ *
+ * Unlike delaunay2DBoyerWatson's inner boundary overload, the boundaries' segments are recovered, see delaunay2DConstrained.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance.
+ * @param coords_boundary A container of 2D coordinates representing the outer boundary points.
+ * @param coords_inner A container of 2D coordinates representing the inner boundary points.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition.
+ * @param spatial_sort Insert points in BRIO order instead of the input order.
+ * @return A container of triangulated faces, the boundaries' half-edges are constrained.
+ */
+    template < std::floating_point T >
+    auto delaunay2DBoyerWatsonConstrained(const auto &coords_boundary,const auto &coords_inner, T tol, bool spatial_sort = true)
+    {
+        std::vector<std::vector<std::array<T, 2>>> boundaries{
+            {std::begin(coords_boundary), std::end(coords_boundary)},
+            {std::begin(coords_inner), std::end(coords_inner)}};
+        return delaunay2DConstrained<T>(boundaries, {}, tol, spatial_sort);
+    }
+/**
+ * @brief Refines a 2D Delaunay triangulation by inserting the Steiner points of the worst faces of a quality queue.
+ *
+ * Each step takes up to batch_size worst faces from the queue and searches their points' cavities concurrently.
+ * A point is inserted only if its cavity doesn't meet the cavities, or their neighbors, of the points already accepted in the batch,
+ * which keeps the insertions independent, the others are queued back.
+ * New faces, and the faces changed by on_insert, are evaluated concurrently and queued.
+ * Cavities' face objects are recycled, see recycleDelaunayCavity, so faces_lst is kept up to date by appending the extra faces
+ * and on_insert sees the current mesh. Hence a step costs O(log n) for a mesh of n faces.
+ * Faces whose criterion equals crit_max are accepted, e.g. faces whose edges are exactly at the MaxEdgeSize limit aren't split.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance values.
+ * @tparam _Func A callable object type returning a face's (criterion, Steiner point) pair.
+ * @param faces_lst A reference to the container of triangulated faces, updated at the end of the refinement.
+ * @param queue The quality queue holding faces_lst's faces.
+ * @param crit_max Faces whose criterion is not above crit_max are not refined.
+ * @param max_inner_points Maximum number of inserted points.
+ * @param tol Tolerance for the Delaunay condition.
+ * @param batch_size Maximum number of points inserted per step.
+ * @param on_insert Called on each new vertex once its batch is inserted, returns the list of faces it changed.
+ * @return The refined container of faces, i.e. faces_lst.
+ */
+    template <std::floating_point T, typename _Func>
+    auto delaunay2DBoyerWatsonQueueRefine(auto &faces_lst, FaceQualityQueue<T, 2, _Func> &queue, T crit_max, size_t max_inner_points, T tol, size_t batch_size, const auto &on_insert)
+    {
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
+        using Entry = typename FaceQualityQueue<T, 2, _Func>::Entry;
+
+        size_t n_inserted{};
+        batch_size = std::max<size_t>(batch_size, 1);
+
+        while (n_inserted < max_inner_points && !queue.empty() && queue.top().quality.first > crit_max)
+        {
+            std::vector<Entry> batch;
+            while (batch.size() < std::min(batch_size, max_inner_points - n_inserted) && !queue.empty() && queue.top().quality.first > crit_max)
             {
-                face_quality.erase(face);
+                batch.push_back(queue.pop());
             }
 
-            for (const auto &face : new_faces_list)
+            // Search cavities concurrently, the mesh is not modified yet
+            std::vector<std::list<Face>> cavities(batch.size());
+            std::transform(
+                std::execution::par,
+                batch.begin(), batch.end(),
+                cavities.begin(),
+                [tol](const auto &e) {
+                    const auto &xy = e.quality.second;
+                    auto h_f = locateFace(e.face, xy);
+                    return h_f && in_circle(xy, h_f) > tol ? getDelaunayCavity(h_f, xy, tol) : std::list<Face>{};
+                });
+
+            // Keep independent insertions, points outside the mesh or confused with a vertex are dropped
+            std::unordered_set<HalfEdgeFace<T, 2> *> locked;
+            std::vector<size_t> accepted;
+            for (size_t i{}; i < batch.size(); i++)
             {
-                update_face_quality(face);
+                if (cavities[i].empty())
+                {
+                    continue;
+                }
+                if (std::ranges::any_of(cavities[i], [&locked](const auto &h_f) { return locked.contains(h_f.get()); }))
+                {
+                    queue.push(batch[i].face, batch[i].quality);
+                    continue;
+                }
+                for (const auto &h_f : cavities[i])
+                {
+                    locked.insert(h_f.get());
+                    for (const auto &h_e : getFaceEdges(h_f))
+                    {
+                        if (h_e->opposite)
+                        {
+                            locked.insert(h_e->opposite->face.get());
+                        }
+                    }
+                }
+                accepted.push_back(i);
             }
 
-            // Smooth mesh
-            laplacian_smoothing(faces_lst, *vtx);
-            // Restore Delaunay condition
-            auto edges = getEdgesMap<T,dim>(faces_lst);
-            for(auto & [ed,i] : edges)
+            // Insert points
+            std::vector<std::shared_ptr<HalfEdgeVertex<T, 2>>> vertices;
+            std::unordered_set<Face> changed;
+            for (auto i : accepted)
+            {
+                for (const auto &h_f : cavities[i])
+                {
+                    queue.erase(h_f);
+                }
+                auto [vtx, h_f_lst_new] = fillDelaunayCavity(cavities[i], batch[i].quality.second);
+                auto it_new = recycleDelaunayCavity(cavities[i], h_f_lst_new);
+                faces_lst.insert(faces_lst.end(), it_new, h_f_lst_new.end());
+                changed.insert(h_f_lst_new.begin(), h_f_lst_new.end());
+                vertices.push_back(vtx);
+                n_inserted++;
+            }
+            for (const auto &vtx : vertices)
             {
-                if(ed->opposite && !is_locally_delaunay(ed))
+                for (const auto &h_f : on_insert(vtx))
                 {
-                    flip(ed->face,ed->opposite->face);
+                    changed.insert(h_f);
                 }
             }
+            queue.push(changed);
         }
 
         return faces_lst;
     }
 
+/**
+ * @brief Restores the Delaunay condition around a vertex by Lawson's flips, starting with the edges of the faces attached to the vertex.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance values.
+ * @param h_v The vertex.
+ * @param tol Tolerance for the Delaunay condition.
+ * @return The list of faces attached to the vertex and of the flipped faces.
+ */
+    template <std::floating_point T>
+    auto restoreDelaunayAround(const std::shared_ptr<HalfEdgeVertex<T, 2>> &h_v, T tol)
+    {
+        auto changed = getFacesAttachedToVertex(h_v);
+        std::vector<std::shared_ptr<HalfEdge<T, 2>>> stack;
+        for (const auto &h_f : changed)
+        {
+            auto h_e_lst = getFaceEdges(h_f);
+            stack.insert(stack.end(), h_e_lst.begin(), h_e_lst.end());
+        }
+
+        while (!stack.empty())
+        {
+            auto h_e = stack.back();
+            stack.pop_back();
+            if (!h_e->opposite || h_e->constrained || is_locally_delaunay(h_e) <= tol)
+            {
+                continue;
+            }
+            // Only convex quads are flipped
+            const auto &a = h_e->previous->vertex->coords;
+            const auto &b = h_e->vertex->coords;
+            const auto &c = h_e->next->vertex->coords;
+            const auto &d = h_e->opposite->next->vertex->coords;
+            if (orient_2d(a, d, c) <= 0 || orient_2d(d, b, c) <= 0)
+            {
+                continue;
+            }
+            auto h_f1 = h_e->face;
+            auto h_f2 = h_e->opposite->face;
+            flip(h_f1, h_f2);
+            changed.push_back(h_f1);
+            changed.push_back(h_f2);
+            for (const auto &h_f : {h_f1, h_f2})
+            {
+                for (const auto &h_e_f : getFaceEdges(h_f))
+                {
+                    if (h_e_f != h_e && h_e_f != h_e->opposite)
+                    {
+                        stack.push_back(h_e_f);
+                    }
+                }
+            }
+        }
+
+        return changed;
+    }
+
+/**
+ * @brief Refines a 2D Delaunay triangulation of a surface mesh using the Boyer-Watson algorithm.
+ *
+ * Faces are refined from the worst one, using a FaceQualityQueue, see delaunay2DBoyerWatsonQueueRefine.
+ *
+ * @tparam T A floating-point type used for coordinates, tolerance, and criteria values.
+ * @tparam dim A size_t value representing the dimension of the surface.
+ * @tparam _Func A callable object type used for distance calculation between mesh and surface.
+ * @param srf A surface on which the mesh refinement is performed.
+ * @param faces_lst A reference to the container of triangulated faces forming the surface mesh.
+ * @param crit_max A floating-point value specifying the maximum allowed distance criterion for refinement.
+ * @param max_inner_points A size_t value specifying the maximum number of inner points allowed for refinement (default is 500).
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @param batch_size Maximum number of independent points inserted per step (default is 1).
+ * @return A container of triangulated faces forming the refined Delaunay triangulation of the surface mesh.
+ */
+    template <std::floating_point T, size_t dim, typename _Func>
+    auto delaunay2DBoyerWatsonSurfaceMeshRefine(const Surface<T, dim> &srf, auto &faces_lst, T crit_max, size_t max_inner_points = 500, T tol = 0, size_t batch_size = 1)
+    {
+        _Func dist_mesh_srf{srf};
+
+        FaceQualityQueue<T, 2, _Func> queue{dist_mesh_srf};
+        queue.push(faces_lst);
+
+        return delaunay2DBoyerWatsonQueueRefine(faces_lst, queue, crit_max, max_inner_points, tol, batch_size,
+            [](const auto &) { return std::list<std::shared_ptr<HalfEdgeFace<T, 2>>>{}; });
+    }
+
+/**
+ * @brief Refines a 2D Delaunay triangulation using the Boyer-Watson algorithm, new vertices being smoothed.
+ *
+ * Faces are refined from the worst one, using a FaceQualityQueue, see delaunay2DBoyerWatsonQueueRefine.
+ * Each new vertex is moved by laplacian smoothing, then the Delaunay condition is restored around it.
+ *
+ * @tparam T A floating-point type used for coordinates, tolerance, and criteria values.
+ * @tparam dim A size_t value representing the dimension of the mesh, 2.
+ * @tparam _Func A callable object type returning a face's (criterion, Steiner point) pair.
+ * @param faces_lst A reference to the container of triangulated faces.
+ * @param crit_max A floating-point value specifying the maximum allowed criterion for refinement.
+ * @param dist_mesh The criterion.
+ * @param max_inner_points A size_t value specifying the maximum number of inner points allowed for refinement (default is 500).
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @param batch_size Maximum number of independent points inserted per step (default is 1).
+ * @return A container of triangulated faces forming the refined Delaunay triangulation.
+ */
+    template <std::floating_point T, size_t dim, typename _Func>
+    auto delaunay2DBoyerWatsonMeshRefine(auto &faces_lst, T crit_max, const _Func &dist_mesh, size_t max_inner_points = 500, T tol = 0, size_t batch_size = 1)
+    {
+        static_assert(dim == 2);
+        FaceQualityQueue<T, 2, _Func> queue{dist_mesh};
+        queue.push(faces_lst);
+
+        return delaunay2DBoyerWatsonQueueRefine(faces_lst, queue, crit_max, max_inner_points, tol, batch_size,
+            [&faces_lst, tol](const auto &vtx) {
+                // Smooth mesh
+                laplacian_smoothing(faces_lst, *vtx);
+                // Restore Delaunay condition
+                return restoreDelaunayAround(vtx, tol);
+            });
+    }
+
     template <std::floating_point T, size_t dim, typename _Func>
-    auto delaunay2DBoyerWatsonMeshRefine(auto &faces_lst, T crit_max, size_t max_inner_points = 500, T tol = 1e-10)
+    auto delaunay2DBoyerWatsonMeshRefine(auto &faces_lst, T crit_max, size_t max_inner_points = 500, T tol = 0, size_t batch_size = 1)
     {
         _Func dist_mesh{};
-        return delaunay2DBoyerWatsonMeshRefine<T,dim,_Func>(faces_lst, crit_max, dist_mesh, max_inner_points, tol);
+        return delaunay2DBoyerWatsonMeshRefine<T,dim,_Func>(faces_lst, crit_max, dist_mesh, max_inner_points, tol, batch_size);
     }
 
 /**
@@ -308,28 +979,16 @@ namespace gbs
  * @param nu A size_t value specifying the number of divisions along the U direction (default is 5).
  * @param nv A size_t value specifying the number of divisions along the V direction (default is 5).
  * @param deviation A floating-point value specifying the deviation for mesh surface boundary (default is 0.01).
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
  * @return A container of triangulated faces forming the base Delaunay triangulation of the surface.
  */
     template < std::floating_point T, size_t dim>
-    auto delaunay2DBoyerWatsonSurfaceBase(const Surface<T,dim> &srf, size_t nu = 5, size_t nv = 5, T deviation = 0.01, T tol = 1e-10)
+    auto delaunay2DBoyerWatsonSurfaceBase(const Surface<T,dim> &srf, size_t nu = 5, size_t nv = 5, T deviation = 0.01, T tol = 0)
     {
     
         auto coords = meshSurfaceBoundary(srf, nu ,nv, deviation);
-        auto faces_lst = getEncompassingMesh(coords);
-        auto vertices = getVerticesVectorFromFaces<T,2>(faces_lst);
-        // insert boundary points
-        for(const auto &xy : coords)
-        {
-            boyerWatson<T>(faces_lst, xy, tol);
-        }
-        // remove external mesh, i.ei faces attached to initial vertices
-        // This work because surface coordinate are convex ( rectangle )
-        for(const auto &vtx : vertices)
-        {
-            remove_faces(faces_lst, vtx);
-        }
-        return faces_lst;
+        // removing the external mesh works because surface coordinate are convex ( rectangle )
+        return delaunay2DBoyerWatson(coords, tol);
     }
 /**
  * @brief Computes the refined 2D Delaunay triangulation of a surface mesh using the Boyer-Watson algorithm.
@@ -343,54 +1002,130 @@ namespace gbs
  * @param nu A size_t value specifying the number of divisions along the U direction (default is 5).
  * @param nv A size_t value specifying the number of divisions along the V direction (default is 5).
  * @param deviation A floating-point value specifying the deviation for mesh surface boundary (default is 0.01).
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
+ * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 0, i.e. exact test).
+ * @param batch_size Maximum number of independent points inserted per refinement step (default is 1).
  * @return A container of triangulated faces forming the refined Delaunay triangulation of the surface mesh.
  */
     template < std::floating_point T, size_t dim, typename _Func >
-    auto delaunay2DBoyerWatsonSurfaceMesh(const Surface<T,dim> &srf, T crit_max, size_t max_inner_points = 500, size_t nu = 5, size_t nv = 5, T deviation = 0.01, T tol = 1e-10)
+    auto delaunay2DBoyerWatsonSurfaceMesh(const Surface<T,dim> &srf, T crit_max, size_t max_inner_points = 500, size_t nu = 5, size_t nv = 5, T deviation = 0.01, T tol = 0, size_t batch_size = 1)
     {
         auto faces_lst = delaunay2DBoyerWatsonSurfaceBase(srf, nu, nv, deviation, tol);
-        return delaunay2DBoyerWatsonSurfaceMeshRefine<T, dim, _Func>(srf, faces_lst, crit_max, max_inner_points, tol); 
+        return delaunay2DBoyerWatsonSurfaceMeshRefine<T, dim, _Func>(srf, faces_lst, crit_max, max_inner_points, tol, batch_size); 
     }
+/**
+ * @brief Inserts a closed constrained loop into an existing 2D Delaunay triangulation.
+ *
+ * The loop's points are inserted using the Boyer-Watson algorithm, then its segments are recovered, see insertConstraint.
+ *
+ * @tparam T A floating-point type used for coordinates and tolerance values.
+ * @param faces_lst A reference to the container of triangulated faces, the loop must lie inside the mesh.
+ * @param coords The loop's points, the last point is not repeated.
+ * @param tol A floating-point value used as tolerance for the Delaunay condition.
+ * @return A pair ( faces along the loop's inner side, faces along the loop's outer side).
+ */
+    template <std::floating_point T>
+    auto insertConstrainedLoop(auto &faces_lst, const std::vector<std::array<T, 2>> &coords, T tol)
+    {
+        using Face = std::shared_ptr<HalfEdgeFace<T, 2>>;
+
+        std::vector<std::shared_ptr<HalfEdgeVertex<T, 2>>> vertices;
+        for (const auto &xy : coords)
+        {
+            auto vtx = std::get<0>(boyerWatson<T>(faces_lst, xy, tol));
+            if (!vtx && !faces_lst.empty())
+            {
+                auto h_f_xy = locateFace(faces_lst.back(), xy);
+                vtx = h_f_xy ? getClosestFaceVertex(h_f_xy, xy) : nullptr;
+            }
+            vertices.push_back(vtx);
+        }
+
+        // Loop's orientation
+        T area{};
+        for (size_t i{}; i < coords.size(); i++)
+        {
+            const auto &a = coords[i];
+            const auto &b = coords[(i + 1) % coords.size()];
+            area += a[0] * b[1] - a[1] * b[0];
+        }
+
+        // Recover segments, keeping for each half-edge whether the loop's inside is on its left
+        std::list<std::pair<std::shared_ptr<HalfEdge<T, 2>>, bool>> loop_edges;
+        std::unordered_set<Face> removed;
+        std::list<Face> added;
+        for (size_t i{}; i < vertices.size(); i++)
+        {
+            const auto &h_v_a = vertices[i];
+            const auto &h_v_b = vertices[(i + 1) % vertices.size()];
+            if (!h_v_a || !h_v_b || h_v_a == h_v_b)
+            {
+                continue;
+            }
+            auto [h_e_lst, deleted, added_segment] = insertConstraint(h_v_a, h_v_b);
+            for (const auto &h_e : h_e_lst)
+            {
+                auto forward = (h_e->vertex->coords - h_e->previous->vertex->coords) * (h_v_b->coords - h_v_a->coords) > 0;
+                loop_edges.emplace_back(h_e, forward == (area > 0));
+            }
+            removed.insert(deleted.begin(), deleted.end());
+            added.splice(added.end(), added_segment);
+        }
+
+        // Update faces' container
+        std::erase_if(faces_lst, [&removed](const auto &h_f) { return removed.contains(h_f); });
+        std::erase_if(added, [&removed](const auto &h_f) { return removed.contains(h_f); });
+        faces_lst.insert(faces_lst.end(), added.begin(), added.end());
+
+        std::list<Face> inner_side, outer_side;
+        for (const auto &[h_e, inside_on_left] : loop_edges)
+        {
+            (inside_on_left ? inner_side : outer_side).push_back(h_e->face);
+            if (h_e->opposite)
+            {
+                (inside_on_left ? outer_side : inner_side).push_back(h_e->opposite->face);
+            }
+        }
+
+        return std::make_pair(std::move(inner_side), std::move(outer_side));
+    }
+
 /**
  * @brief Adds an inner boundary to an existing 2D Delaunay triangulation using the Boyer-Watson algorithm.
  *
+ * The boundary is constrained, see insertConstrainedLoop, the faces inside it are found by flooding from the boundary.
+ *
  * @tparam T A floating-point type used for coordinates and tolerance values.
  * @tparam dim A size_t value representing the dimension of the surface.
  * @param faces_lst A reference to the container of triangulated faces forming the initial Delaunay triangulation.
  * @param coords_inner A vector containing the coordinates of the inner boundary points.
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
- * @return A container of triangulated faces forming the Delaunay triangulation with the added inner boundary.
+ * @param tol Tolerance for the Delaunay condition of the boundary's points, a point failing it is merged with the closest vertex (default is 1e-10).
+ * @return The faces removed from faces_lst, i.e. inside the inner boundary.
  */
     template < std::floating_point T, size_t dim>
     auto delaunay2DBoyerWatsonAddInnerBound(auto &faces_lst, const std::vector<std::array<T,dim>> &coords_inner, T tol = 1e-10)
     {
-        for (const auto &xy : coords_inner)
-        {
-            boyerWatson<T>(faces_lst, xy, tol);
-        }
-        auto boundary_inner = make_HalfEdges<T>(coords_inner);
-        return takeInternalFaces<T>(faces_lst,boundary_inner, tol);
+        static_assert(dim == 2);
+        auto depths = getConstrainedDepths<T>(insertConstrainedLoop(faces_lst, coords_inner, tol).first);
+        return takeFaces(faces_lst, [&depths](const auto &h_f) { auto it = depths.find(h_f.get()); return it != depths.end() && it->second == 0; });
     }
 /**
  * @brief Adds an outer boundary to an existing 2D Delaunay triangulation using the Boyer-Watson algorithm.
  *
+ * The boundary is constrained, see insertConstrainedLoop, the faces outside it are found by flooding from the boundary.
+ *
  * @tparam T A floating-point type used for coordinates and tolerance values.
  * @tparam dim A size_t value representing the dimension of the surface.
  * @param faces_lst A reference to the container of triangulated faces forming the initial Delaunay triangulation.
  * @param coords_outer A vector containing the coordinates of the outer boundary points.
- * @param tol A floating-point value used as tolerance for the Delaunay condition (default is 1e-10).
- * @return A container of triangulated faces forming the Delaunay triangulation with the added outer boundary.
+ * @param tol Tolerance for the Delaunay condition of the boundary's points, a point failing it is merged with the closest vertex (default is 1e-10).
+ * @return The faces removed from faces_lst, i.e. outside the outer boundary.
  */
     template <std::floating_point T, size_t dim>
     auto delaunay2DBoyerWatsonAddOuterBound(auto &faces_lst, const std::vector<std::array<T,dim>> &coords_outer, T tol = 1e-10)
     {
-        for (const auto &xy : coords_outer)
-        {
-            boyerWatson<T>(faces_lst, xy, tol);
-        }
-        auto boundary_outer = make_HalfEdges<T>(coords_outer);
-        return takeExternalFaces<T>(faces_lst,boundary_outer, tol);
+        static_assert(dim == 2);
+        auto depths = getConstrainedDepths<T>(insertConstrainedLoop(faces_lst, coords_outer, tol).second);
+        return takeFaces(faces_lst, [&depths](const auto &h_f) { auto it = depths.find(h_f.get()); return it != depths.end() && it->second == 0; });
     }
 
 // TODO remove
@@ -467,4 +1202,44 @@ namespace gbs
         }
         return faces_lst;
     }
+
+/**
+ * @brief Exports triangular faces of the parametric plane as an indexed triangle mesh of the surface.
+ *
+ * Vertices are indexed in a single pass by order of appearance, then evaluated on the surface in parallel.
+ * Non triangular faces are split into fans.
+ *
+ * @tparam T Floating point type used for coordinates.
+ * @tparam dim Surface's dimension.
+ * @param faces_lst Faces of the parametric plane.
+ * @param srf The surface.
+ * @return SurfaceTessellation<T, dim> Points, parameters and triangles, counterclockwise in the parametric plane.
+ */
+    template <std::floating_point T, size_t dim>
+    auto make_surface_tessellation(const auto &faces_lst, const Surface<T, dim> &srf) -> SurfaceTessellation<T, dim>
+    {
+        auto mesh = getIndexedFaces<T, 2>(faces_lst);
+        auto n_vertices = mesh.vertices.size();
+
+        SurfaceTessellation<T, dim> tessellation;
+        tessellation.uv.resize(n_vertices);
+        std::transform(mesh.vertices.begin(), mesh.vertices.end(), tessellation.uv.begin(),
+                       [](const auto &h_v) { return h_v->coords; });
+        tessellation.points.resize(n_vertices);
+        std::transform(std::execution::par, tessellation.uv.begin(), tessellation.uv.end(), tessellation.points.begin(),
+                       [&srf](const auto &uv) { return srf(uv[0], uv[1]); });
+
+        auto n_faces = mesh.offsets.size() - 1;
+        tessellation.triangles.reserve(mesh.indices.size() - 2 * n_faces);
+        for (size_t i{}; i < n_faces; i++)
+        {
+            auto first = mesh.offsets[i];
+            for (auto j = first + 1; j + 1 < mesh.offsets[i + 1]; j++)
+            {
+                tessellation.triangles.push_back({mesh.indices[first], mesh.indices[j], mesh.indices[j + 1]});
+            }
+        }
+
+        return tessellation;
+    }
 }
\ No newline at end of file
@@ -49,7 +49,8 @@ inline auto declare_bscurve(py::module_ &m)
         .def("insertKnot", &Class::insertKnot, "Insert knot with the given multiplicity", py::arg("u"), py::arg("m") = 1)
         .def("removeKnot", &Class::removeKnot, "Try to remove m times the given knot", py::arg("u"), py::arg("tol"), py::arg("m") = 1)
         .def("poles", &Class::poles, "Curve's poles")
-        .def("pole",py::overload_cast<size_t>(&Class::pole),"Edit specified pole")
+        .def("setPole",&Class::setPole,"Replace specified pole")
+        .def("pole",[](Class &crv, size_t id, const std::array<T, dim + rational> &P){ crv.setPole(id, P); },"Edit specified pole")
         .def("pole",py::overload_cast<size_t>(&Class::pole,py::const_),"Access specified pole")
         .def("copyKnots",&Class::copyKnots,"Replace curve's knots")
         .def("copyPoles",&Class::copyPoles,"Replace curve's poles")
@@ -74,7 +74,8 @@ inline auto declare_bssurface(py::module_ &m)
         .def("multsU", &Class::multsU,"Surface's U knots multiplicities")
         .def("multsV", &Class::multsV,"Surface's V knots multiplicities")
         .def("poles", &Class::poles,"Surface's poles")
-        .def("pole",py::overload_cast<size_t, size_t>(&Class::pole),"Edit specified pole")
+        .def("setPole",&Class::setPole,"Replace specified pole")
+        .def("pole",[](Class &srf, size_t i, size_t j, const std::array<T, dim + rational> &P){ srf.setPole(i, j, P); },"Edit specified pole")
         .def("pole",py::overload_cast<size_t, size_t>(&Class::pole,py::const_),"Access specified pole")
         .def("bounds", &Class::bounds,"Returns surface's start stop values")
         .def("insertKnotU", &Class::insertKnotU,"Insert U knot at multiplicity m",py::arg("u"), py::arg("m")=1)
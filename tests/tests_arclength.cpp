@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <gbs/bscanalysis.h>
+#include <gbs/bscbuild.h>
+#include <gbs/bscinterp.h>
+#include <gbs/curvearclength.h>
+#include <numbers>
+
+using gbs::operator-;
+using gbs::operator*;
+using gbs::operator/;
+using std::numbers::pi;
+
+TEST(tests_arclength, circle)
+{
+    auto c = gbs::build_circle<double, 2>(2.);
+    gbs::ArcLengthTable<double, 2> table{c, 1e-10};
+    ASSERT_NEAR(table.length(), 4. * pi, 1e-7);
+
+    auto u = gbs::make_range(0., 1., 101);
+    auto s = table.lengths(u);
+    auto u_back = table.parameters(s);
+    for (size_t i{}; i < u.size(); i++)
+    {
+        auto [x, y] = c(u[i]);
+        auto theta = std::atan2(y, x);
+        if (theta < 0. || (i == u.size() - 1))
+            theta += 2. * pi;
+        ASSERT_NEAR(s[i], 2. * theta, 1e-8);
+        ASSERT_NEAR(u_back[i], u[i], 1e-7);
+    }
+}
+
+TEST(tests_arclength, uniform_parameters)
+{
+    gbs::points_vector<double, 3> pts{{0., 0., 0.}, {1., 0.2, 0.}, {1.5, 1., 0.3}, {3., 1.2, 0.2}, {4., 0., 0.}};
+    auto crv = gbs::interpolate(pts, 3, gbs::KnotsCalcMode::CHORD_LENGTH);
+    gbs::ArcLengthTable<double, 3> table{crv};
+    auto [u1, u2] = crv.bounds();
+    auto u = table.uniformParameters(u1, u2, 50);
+    auto dm = gbs::length(crv) / 49.;
+    for (size_t i{1}; i < u.size(); i++)
+        ASSERT_NEAR(gbs::length(crv, u[i - 1], u[i]), dm, 1e-7);
+
+    auto u_lst = gbs::uniform_distrib_params(table, u1, u2, 50);
+    ASSERT_TRUE(std::equal(u.begin(), u.end(), u_lst.begin()));
+}
+
+TEST(tests_arclength, invalidation)
+{
+    auto crv = gbs::build_segment<double, 2>({0., 0.}, {1., 0.}, true);
+    gbs::ArcLengthTable<double, 2> table{crv};
+    ASSERT_NEAR(table.length(), 1., 1e-12);
+    ASSERT_NEAR(table.parameter(0.25), 0.25, 1e-12);
+
+    crv.copyPoles({{0., 0.}, {3., 4.}});
+    ASSERT_NEAR(table.length(), 5., 1e-12);
+    ASSERT_NEAR(table.parameter(2.5), 0.5, 1e-12);
+
+    crv.changeBounds(0., 2.);
+    ASSERT_NEAR(table.parameter(2.5), 1., 1e-12);
+
+    crv.setPole(1, {6., 8.});
+    ASSERT_NEAR(table.length(), 10., 1e-12);
+
+    crv.trim(0., 1.);
+    ASSERT_NEAR(table.length(), 5., 1e-12);
+    ASSERT_NEAR(table.parameter(2.5), 0.5, 1e-12);
+
+    auto crv_cpy = crv; // same definition, shares revision
+    ASSERT_EQ(crv_cpy.revision(), crv.revision());
+    crv_cpy.insertKnot(0.5);
+    ASSERT_NE(crv_cpy.revision(), crv.revision());
+}
+
+TEST(tests_arclength, curve_arc_length)
+{
+    gbs::points_vector<double, 3> pts{{0., 0., 0.}, {1., 0.2, 0.}, {1.5, 1., 0.3}, {3., 1.2, 0.2}, {4., 0., 0.}};
+    auto p_crv = std::make_shared<gbs::BSCurve<double, 3>>(gbs::interpolate(pts, 3, gbs::KnotsCalcMode::CHORD_LENGTH));
+    auto [u1, u2] = p_crv->bounds();
+    auto ua = u1 + 0.2 * (u2 - u1), ub = u1 + 0.9 * (u2 - u1);
+    gbs::CurveArcLength<double, 3> crv{p_crv, ua, ub};
+    auto l = gbs::length(*p_crv, ua, ub);
+    ASSERT_NEAR(crv.bounds()[1], l, 1e-7);
+    ASSERT_LT(gbs::distance(crv.begin(), p_crv->value(ua)), 1e-12);
+    ASSERT_LT(gbs::distance(crv.end(), p_crv->value(ub)), 1e-12);
+
+    auto s_lst = gbs::make_range(0., l, 41);
+    auto pts_s = crv.values(s_lst);
+    auto h = 1e-4;
+    for (size_t i{}; i < s_lst.size(); i++)
+    {
+        auto s = s_lst[i];
+        ASSERT_LT(gbs::distance(pts_s[i], crv(s)), 1e-14);
+        ASSERT_NEAR(gbs::length(*p_crv, ua, crv.parameter(s)), s, 1e-7);
+        // unit speed, and derivatives consistent with finite differences
+        ASSERT_NEAR(gbs::norm(crv(s, 1)), 1., 1e-12);
+        ASSERT_NEAR(crv(s, 1) * crv(s, 2), 0., 1e-10);
+        if (s > h && s < l - h)
+        {
+            for (size_t d{1}; d <= 3; d++)
+            {
+                auto fd = (crv(s + h, d - 1) - crv(s - h, d - 1)) / (2. * h);
+                ASSERT_LT(gbs::norm(fd - crv(s, d)), 1e-3 * (1. + gbs::norm(crv(s, d))));
+            }
+        }
+    }
+    ASSERT_THROW(crv(0.5, 4), std::runtime_error);
+
+    auto pts_u = crv.uniformPoints(20);
+    ASSERT_EQ(pts_u.size(), 20);
+    ASSERT_LT(gbs::distance(pts_u.back(), crv.end()), 1e-12);
+
+    auto cpy = crv;
+    ASSERT_NEAR(cpy.length(), crv.length(), 1e-14);
+    ASSERT_NEAR(cpy.parameter(0.3 * l), crv.parameter(0.3 * l), 1e-14);
+}
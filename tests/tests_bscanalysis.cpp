@@ -167,4 +167,144 @@ TEST(tests_bscanalysis, max_curvature_pos)
                 .show_curvature=true,
                 },
             gbs::points_vector<double,2>{e(u)});
-}
\ No newline at end of file
+}
+TEST(tests_bscanalysis, curvature_critical_points)
+{
+    // y = x^2, vertex at u = 0.5
+    gbs::BSCurve<double,2> parabola{ {{-1.,1.},{0.,-1.},{1.,1.}}, {0.,0.,0.,1.,1.,1.}, 2};
+    auto extrema = gbs::curvature_extrema(parabola);
+    ASSERT_EQ(extrema.size(), 1);
+    ASSERT_NEAR(extrema[0][0], 0.5, 1e-8);
+    ASSERT_NEAR(extrema[0][1], 2., 1e-6);
+    ASSERT_TRUE(gbs::inflection_points(parabola).empty());
+
+    // y = x^3, inflection at x = 0, curvature extrema at x^4 = 1/45, x = 2u -1
+    gbs::BSCurve<double,2> cubic{ {{-1.,-1.},{-1./3.,1.},{1./3.,-1.},{1.,1.}}, {0.,0.,0.,0.,1.,1.,1.,1.}, 3};
+    cubic.insertKnot(0.3);
+    cubic.insertKnot(0.6, 2);
+    auto [cubic_extrema, inflections] = gbs::curvature_critical_points(cubic);
+    auto x_ext = std::pow(1. / 45., 0.25);
+    ASSERT_EQ(inflections.size(), 1);
+    ASSERT_NEAR(inflections[0], 0.5, 1e-8);
+    ASSERT_EQ(cubic_extrema.size(), 2);
+    ASSERT_NEAR(cubic_extrema[0][0], 0.5 * (1. - x_ext), 1e-8);
+    ASSERT_NEAR(cubic_extrema[1][0], 0.5 * (1. + x_ext), 1e-8);
+    ASSERT_LT(cubic_extrema[0][1], 0.);
+    ASSERT_GT(cubic_extrema[1][1], 0.);
+}
+
+TEST(tests_bscanalysis, bezier_roots)
+{
+    // without subdivision, (t - 0.5)^2 + 1e-6 keeps sign changes in its coefficients yet has no root
+    ASSERT_TRUE(gbs::bezier_roots<double>({0.25 + 1e-6, -0.25 + 1e-6, 0.25 + 1e-6}, 1e-12, 0).empty());
+    // while the double root of (t - 0.5)^2 is found
+    auto roots = gbs::bezier_roots<double>({0.25, -0.25, 0.25}, 1e-12, 0);
+    ASSERT_EQ(roots.size(), 1);
+    ASSERT_NEAR(roots[0], 0.5, 1e-12);
+    // (t - 0.2) (t - 0.7), a root per bracketing sub-interval
+    roots = gbs::bezier_roots<double>({0.14, -0.31, 0.24}, 1e-12);
+    ASSERT_EQ(roots.size(), 2);
+    ASSERT_NEAR(roots[0], 0.2, 1e-10);
+    ASSERT_NEAR(roots[1], 0.7, 1e-10);
+}
+
+TEST(tests_bscanalysis, curvature_extrema_3d)
+{
+    gbs::points_vector<double,3> pts{
+        {0.,0.,0.},{1.,0.5,0.2},{2.,-0.3,0.5},{3.,0.4,-0.2},{4.,1.,0.3},{5.,0.,0.}};
+    auto crv = gbs::interpolate(pts, 3, gbs::KnotsCalcMode::CHORD_LENGTH);
+    auto extrema = gbs::curvature_extrema(crv);
+    ASSERT_FALSE(extrema.empty());
+    // compare with sampled curvature's local extrema
+    auto [u1, u2] = crv.bounds();
+    size_t n = 20000;
+    auto u = gbs::make_range(u1, u2, n);
+    std::vector<double> k(n);
+    std::transform(u.begin(), u.end(), k.begin(), [&crv](double u_) { return gbs::curvature(crv, u_); });
+    // curvature's derivative jumps at knots, those kinks are not roots
+    auto knots = crv.knots();
+    auto near_knot = [&knots, du = (u2 - u1) / n](double u_)
+    {
+        return std::any_of(knots.begin(), knots.end(), [u_, du](double k_) { return std::fabs(u_ - k_) < 2 * du; });
+    };
+    std::vector<double> u_sampled;
+    for (size_t i{1}; i < n - 1; i++)
+    {
+        if ((k[i] - k[i - 1]) * (k[i + 1] - k[i]) < 0. && !near_knot(u[i]))
+            u_sampled.push_back(u[i]);
+    }
+    ASSERT_EQ(extrema.size(), u_sampled.size());
+    for (size_t i{}; i < extrema.size(); i++)
+    {
+        ASSERT_NEAR(extrema[i][0], u_sampled[i], 2 * (u2 - u1) / n);
+        ASSERT_NEAR(extrema[i][1], gbs::curvature(crv, extrema[i][0]), 1e-12);
+    }
+}
+
+TEST(tests_bscanalysis, rolling_balls)
+{
+    // wedge: the ball touching y = 0 at x has radius (0.2 x + 1) / (1 + sqrt(1.04))
+    auto crv1 = gbs::build_segment<double,2>({0., 0.}, {10., 0.});
+    auto crv2 = gbs::build_segment<double,2>({0., 1.}, {10., 3.});
+    auto u1_lst = gbs::make_range(1., 9., 100);
+    auto balls = gbs::rolling_balls<double>(crv1, crv2, u1_lst, 1e-10, 16);
+    ASSERT_EQ(balls.size(), u1_lst.size());
+    for (const auto &b : balls)
+    {
+        auto r = (0.2 * b.u1 + 1.) / (1. + std::sqrt(1.04));
+        ASSERT_NEAR(b.radius, r, 1e-8);
+        ASSERT_NEAR(b.center[0], b.u1, 1e-8);
+        ASSERT_NEAR(b.center[1], r, 1e-8);
+        ASSERT_FALSE(b.parallel);
+    }
+
+    // curved profiles: contacts are equidistant and normal to both curves
+    auto ext = gbs::interpolate(gbs::points_vector<double,2>{{0., 0.}, {1., 0.3}, {2., 0.4}, {3., 0.3}, {4., 0.}}, 3, gbs::KnotsCalcMode::CHORD_LENGTH);
+    auto in  = gbs::interpolate(gbs::points_vector<double,2>{{0., -0.1}, {1., 0.}, {2., 0.05}, {3., 0.}, {4., -0.1}}, 3, gbs::KnotsCalcMode::CHORD_LENGTH);
+    auto [u_min, u_max] = ext.bounds();
+    auto balls_crv = gbs::rolling_balls<double>(ext, in, gbs::make_range(u_min + 0.1 * (u_max - u_min), u_max - 0.1 * (u_max - u_min), 50), 1e-10);
+    for (const auto &b : balls_crv)
+    {
+        auto d1 = b.center - ext(b.u1);
+        auto d2 = b.center - in(b.u2);
+        ASSERT_NEAR(gbs::norm(d1), b.radius, 1e-8);
+        ASSERT_NEAR(gbs::norm(d2), b.radius, 1e-6);
+        ASSERT_NEAR(gbs::operator*(d2, in(b.u2, 1)), 0., 1e-6);
+    }
+    auto camber = gbs::rolling_ball_camber<double>(ext, in, gbs::make_range(u_min + 0.1 * (u_max - u_min), u_max - 0.1 * (u_max - u_min), 50));
+    for (const auto &b : balls_crv)
+        ASSERT_LT(gbs::extrema_curve_point(camber, b.center, 1e-8)[1], 1e-3);
+}
+
+TEST(tests_bscanalysis, tessellate)
+{
+    auto c = gbs::build_circle<double,2>(1.);
+    gbs::CurveTessellationCriteria<double> criteria{.chord_height = 1e-3};
+    auto samples = gbs::tessellate(c, criteria);
+    ASSERT_NEAR(samples.front().u, 0., tol);
+    ASSERT_NEAR(samples.back().u, 1., tol);
+    for (size_t i{1}; i < samples.size(); i++)
+    {
+        ASSERT_LT(samples[i - 1].u, samples[i].u);
+        ASSERT_LT(gbs::distance(samples[i].pt, c(samples[i].u)), tol);
+        // sagitta of a chord of length l on unit circle
+        auto l = gbs::distance(samples[i - 1].pt, samples[i].pt);
+        ASSERT_LT(1. - std::sqrt(1. - 0.25 * l * l), 1e-3);
+    }
+
+    criteria.chord_height = 1.;
+    criteria.max_angle = PI / 18.;
+    criteria.max_length = 0.05;
+    auto samples_tg = gbs::tessellate(c, criteria, 2, true);
+    for (size_t i{1}; i < samples_tg.size(); i++)
+    {
+        ASSERT_LT(gbs::distance(samples_tg[i - 1].pt, samples_tg[i].pt), 0.05);
+        ASSERT_LT(gbs::distance(samples_tg[i].tg, c(samples_tg[i].u, 1)), tol);
+    }
+
+    // legacy deviation criterion keeps the knots
+    auto u_lst = gbs::deviation_based_params(c, 3, 0.01);
+    for (auto k : c.knots())
+        ASSERT_TRUE(std::find(u_lst.begin(), u_lst.end(), k) != u_lst.end());
+    ASSERT_TRUE(std::is_sorted(u_lst.begin(), u_lst.end()));
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <gbs/bscarithmetic.h>
+
+using gbs::operator-;
+
+namespace
+{
+    const double tol = 1e-12;
+
+    auto f_law()
+    {
+        return gbs::BSCfunction<double>{std::vector<double>{0.5, 2., -1., 1.5}, {0., 0., 0., 0.3, 1., 1., 1.}, 2};
+    }
+
+    auto g_crv()
+    {
+        gbs::points_vector<double, 2> poles{{0., 0.}, {1., 2.}, {2., -1.}, {3., 0.5}, {4., 1.}};
+        return gbs::BSCurve<double, 2>{poles, {0., 0., 0., 0., 0.6, 1., 1., 1., 1.}, 3};
+    }
+}
+
+TEST(tests_bscarithmetic, product)
+{
+    auto f = f_law();
+    auto g = g_crv();
+    auto fg = gbs::product(f, g);
+    ASSERT_EQ(fg.degree(), 5);
+    // C1 at 0.3 and C2 at 0.6 give multiplicities 4 and 3
+    ASSERT_EQ(fg.poles().size(), 6 + 4 + 3);
+    auto ff = gbs::product(f, f);
+    for (auto u : gbs::make_range(0., 1., 101))
+    {
+        ASSERT_LT(gbs::norm(fg(u) - gbs::operator*(f(u), g(u))), tol);
+        ASSERT_NEAR(ff(u), f(u) * f(u), tol);
+    }
+    auto h = gbs::dot_product(g, g);
+    for (auto u : gbs::make_range(0., 1., 101))
+        ASSERT_NEAR(h(u), gbs::sq_norm(g(u)), 1e-11);
+}
+
+TEST(tests_bscarithmetic, sum)
+{
+    auto g1 = g_crv();
+    gbs::points_vector<double, 2> poles{{1., 0.}, {0., 1.}, {2., 2.}};
+    gbs::BSCurve<double, 2> g2{poles, {0., 0., 0.5, 1., 1.}, 1};
+    auto s = gbs::sum(g1, g2, 2., -0.5);
+    auto g3 = gbs::scaled(g1, -3.);
+    for (auto u : gbs::make_range(0., 1., 101))
+    {
+        ASSERT_LT(gbs::norm(s(u) - (gbs::operator*(2., g1(u)) - gbs::operator*(0.5, g2(u)))), tol);
+        ASSERT_LT(gbs::norm(g3(u) - gbs::operator*(-3., g1(u))), tol);
+    }
+    auto f = f_law();
+    auto f2 = gbs::sum(f, f, 1., 1.);
+    ASSERT_NEAR(f2(0.7), 2. * f(0.7), tol);
+
+    gbs::BSCurve<double, 2> g4{poles, {0., 0., 1., 2., 2.}, 1};
+    ASSERT_THROW(gbs::sum(g1, g4), std::invalid_argument);
+}
+
+TEST(tests_bscarithmetic, compose)
+{
+    auto g = g_crv();
+    // non monotonic law crossing g's knot 0.6 three times
+    gbs::BSCfunction<double> f{std::vector<double>{0., 1.2, -0.2, 1.}, {0., 0., 0., 0., 1., 1., 1., 1.}, 3};
+    auto gf = gbs::compose(g, f);
+    ASSERT_EQ(gf.degree(), 9);
+    for (auto u : gbs::make_range(0., 1., 201))
+        ASSERT_LT(gbs::norm(gf(u) - g(f(u))), 1e-11);
+    // chain rule holds since the composition is exact
+    for (auto u : gbs::make_range(0.05, 0.95, 19))
+        ASSERT_LT(gbs::norm(gf(u, 1) - gbs::operator*(f(u, 1), g(f(u), 1))), 1e-9);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <gbs/bscbvh.h>
+#include <gbs/bscbuild.h>
+#include <random>
+
+using gbs::operator-;
+
+TEST(tests_bscbvh, closest_segments)
+{
+    std::vector<gbs::BSCurve<double, 2>> crvs;
+    for (int i{}; i < 50; i++)
+        for (int j{}; j < 10; j++)
+            crvs.push_back(gbs::build_segment<double, 2>({i * 1., j * 1.}, {i + 0.5, j + 0.7}));
+
+    gbs::CurvesBVH<double, 2> bvh{crvs.begin(), crvs.end()};
+    ASSERT_EQ(bvh.size(), crvs.size());
+
+    std::mt19937 gen{0};
+    std::uniform_real_distribution<double> dist_x(-1., 51.), dist_y(-1., 11.);
+    gbs::points_vector<double, 2> pts(50);
+    std::generate(pts.begin(), pts.end(), [&]() { return gbs::point<double, 2>{dist_x(gen), dist_y(gen)}; });
+
+    auto res = bvh.closest(pts);
+    for (size_t k{}; k < pts.size(); k++)
+    {
+        auto d_min = std::numeric_limits<double>::max();
+        for (const auto &crv : crvs)
+        {
+            auto u = gbs::extrema_curve_point(crv, pts[k], 1e-6)[0];
+            d_min = std::min(d_min, gbs::distance(crv(u), pts[k]));
+        }
+        auto [i, u, d] = res[k];
+        ASSERT_NEAR(d, d_min, 1e-5);
+        ASSERT_NEAR(gbs::distance(crvs[i](u), pts[k]), d, 1e-10);
+    }
+}
+
+TEST(tests_bscbvh, closest_curves_pointers)
+{
+    std::vector<std::shared_ptr<gbs::BSCurveRational<double, 2>>> crvs{
+        std::make_shared<gbs::BSCurveRational<double, 2>>(gbs::build_circle<double, 2>(1.)),
+        std::make_shared<gbs::BSCurveRational<double, 2>>(gbs::build_circle<double, 2>(1., {5., 0.}))};
+
+    auto res = gbs::closest_curves(gbs::points_vector<double, 2>{{5., 2.}, {0., 0.5}}, crvs.begin(), crvs.end(), 1e-6);
+
+    ASSERT_EQ(std::get<0>(res[0]), 1);
+    ASSERT_NEAR(std::get<2>(res[0]), 1., 1e-5);
+    ASSERT_EQ(std::get<0>(res[1]), 0);
+    ASSERT_NEAR(std::get<2>(res[1]), 0.5, 1e-5);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <gbs/bsconvert.h>
+
+using gbs::operator-;
+
+namespace
+{
+    auto bicubic_surface()
+    {
+        std::vector<double> ku{0., 0., 0., 0., 0.4, 1., 1., 1., 1.};
+        std::vector<double> kv{0., 0., 0., 0., 0.3, 0.7, 1., 1., 1., 1.};
+        gbs::points_vector<double, 3> poles;
+        for (size_t j{}; j < 6; j++)
+            for (size_t i{}; i < 5; i++)
+                poles.push_back({double(i), double(j), 0.5 * std::sin(double(i * j))});
+        return gbs::BSSurface<double, 3>{poles, ku, kv, 3, 3};
+    }
+}
+
+TEST(tests_bsconvert, build_arc)
+{
+    auto a1 = 0.3, a2 = 4.;
+    auto arc = gbs::build_arc<double, 2>(2., a1, a2, {1., -1.});
+    ASSERT_EQ(arc.knots().size(), 4);
+    ASSERT_LT(gbs::norm(arc(0.) - gbs::point<double, 2>{1. + 2. * std::cos(a1), -1. + 2. * std::sin(a1)}), 1e-12);
+    ASSERT_LT(gbs::norm(arc(1.) - gbs::point<double, 2>{1. + 2. * std::cos(a2), -1. + 2. * std::sin(a2)}), 1e-12);
+    for (auto u : gbs::make_range(0., 1., 100))
+        ASSERT_NEAR(gbs::norm(arc(u) - gbs::point<double, 2>{1., -1.}), 2., 1e-12);
+    auto cir = gbs::build_circle<double, 2>(1.);
+    auto full = gbs::build_arc<double, 2>(1., 0., 2. * std::numbers::pi);
+    for (auto u : gbs::make_range(0., 1., 100))
+        ASSERT_LT(gbs::norm(cir(u) - full(u)), 1e-12);
+    ASSERT_THROW((gbs::build_arc<double, 2>(1., 1., 0.)), std::invalid_argument);
+}
+
+TEST(tests_bsconvert, surface_of_revolution)
+{
+    gbs::ax2<double, 3> ax{{{0., 0., 0.}, {0., 0., 1.}, {1., 0., 0.}}};
+    gbs::BSCurve<double, 2> profile{gbs::points_vector<double, 2>{{0., 1.}, {0.5, 2.}, {1., 0.5}, {2., 1.5}}, {0., 0., 0., 0.5, 1., 1., 1.}, 2};
+    auto circle = gbs::build_circle<double, 2>(0.2, {0., 1.});
+    auto analytic = std::make_shared<gbs::Circle2d<double>>(0.3, gbs::point<double, 2>{0., 1.});
+    std::vector<gbs::SurfaceOfRevolution<double>> sors{
+        {profile, ax},
+        {profile, ax, 0.5, 2.},
+        {std::make_shared<gbs::BSCurveRational<double, 2>>(circle), ax, 0., 5.},
+        {analytic, ax, -1., 1.}};
+    for (const auto &sor : sors)
+    {
+        auto srf = gbs::to_bs_surface(sor);
+        auto [u1, u2, v1, v2] = sor.bounds();
+        auto [U1, U2, V1, V2] = srf.bounds();
+        ASSERT_NEAR(u1, U1, 1e-12);
+        ASSERT_NEAR(u2, U2, 1e-12);
+        ASSERT_NEAR(v1, V1, 1e-12);
+        ASSERT_NEAR(v2, V2, 1e-12);
+        for (auto u : gbs::make_range(u1, u2, 31))
+        {
+            // v knots are at the same angles
+            for (auto v : srf.knotsV())
+                ASSERT_LT(gbs::distance(srf(u, v), sor(u, v)), 1e-6);
+            // every point lies on the parallel circle
+            auto P0 = sor(u, v1);
+            for (auto v : gbs::make_range(v1, v2, 37))
+            {
+                auto P = srf(u, v);
+                ASSERT_NEAR(P[2], P0[2], 1e-6);
+                ASSERT_NEAR(std::hypot(P[0], P[1]), std::hypot(P0[0], P0[1]), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(tests_bsconvert, curve_on_surface_exact)
+{
+    auto srf = bicubic_surface();
+    // crosses the surface's knots several times
+    gbs::BSCurve<double, 2> uv{gbs::points_vector<double, 2>{{0.05, 0.1}, {1.2, 0.2}, {-0.2, 0.9}, {0.95, 0.8}}, {0., 0., 0., 0.6, 2., 2., 2.}, 2};
+    gbs::CurveOnSurface<double, 3> c_on_s{uv, srf};
+    auto crv = gbs::to_bs_curve(c_on_s);
+    ASSERT_EQ(crv.degree(), 12);
+    auto [u1, u2] = crv.bounds();
+    ASSERT_NEAR(u1, 0., 1e-12);
+    ASSERT_NEAR(u2, 2., 1e-12);
+    for (auto u : gbs::make_range(u1, u2, 301))
+        ASSERT_LT(gbs::distance(crv(u), c_on_s(u)), 1e-10);
+}
+
+TEST(tests_bsconvert, curve_on_surface_approx)
+{
+    auto sor = std::make_shared<gbs::SurfaceOfRevolution<double>>(
+        gbs::build_segment<double, 2>({0., 1.}, {1., 2.}, true),
+        gbs::ax2<double, 3>{{{0., 0., 0.}, {0., 0., 1.}, {1., 0., 0.}}});
+    auto uv = std::make_shared<gbs::BSCurve<double, 2>>(gbs::build_segment<double, 2>({0., 0.}, {1., 3.}, true));
+    gbs::CurveOnSurface<double, 3> c_on_s{uv, sor};
+    auto tol = 1e-6;
+    auto crv = gbs::to_bs_curve(c_on_s, tol);
+    ASSERT_EQ(crv.degree(), 3);
+    for (auto u : gbs::make_range(0., 1., 301))
+        ASSERT_LT(gbs::distance(crv(u), c_on_s(u)), tol);
+}
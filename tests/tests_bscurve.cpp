@@ -214,4 +214,29 @@ TEST(tests_bscurve, eval_except)
 {
     auto crv =  gbs::build_segment<double,2>({0.,0.},{1.,0.});
     ASSERT_THROW(crv.value(2.), gbs::OutOfBoundsCurveEval<double>);
-}
\ No newline at end of file
+}
+TEST(tests_bscurve, hodographs_cache)
+{
+    std::vector<double> k = {0., 0., 0., 0., 1., 2., 2., 3., 3., 3., 3.};
+    gbs::points_vector<double, 3> poles{{0., 0., 0.}, {0., 1., 0.}, {1., 1., 0.}, {1., 1., 1.}, {1., 1., 2.}, {3., 1., 1.}, {0., 4., 1.}};
+    gbs::BSCurve<double, 3> crv{poles, k, 3};
+    auto ref{crv};
+    crv.enableHodographs();
+    ASSERT_EQ(crv.hodographsOrder(), 3);
+    ASSERT_EQ(crv.hodograph(1).degree(), 2);
+    ASSERT_EQ(crv.hodograph(3).degree(), 0);
+    ASSERT_THROW(crv.hodograph(4), std::out_of_range);
+
+    auto u_lst = gbs::make_range(0., 3., 101);
+    for (auto u : u_lst)
+        for (size_t d{}; d <= 4; d++)
+            ASSERT_LT(gbs::norm(crv(u, d) - ref(u, d)), tol);
+
+    // hodographs follow curve's modifications and copies keep the setting
+    crv.insertKnot(0.5);
+    crv.copyPoles(gbs::points_vector<double, 3>(crv.poles().size(), {1., 2., 3.}));
+    ASSERT_LT(gbs::norm(crv(1.3, 1)), tol);
+    auto crv_cpy{crv};
+    ASSERT_EQ(crv_cpy.hodographsOrder(), 3);
+    ASSERT_LT(gbs::norm(crv_cpy(1.3, 2)), tol);
+}
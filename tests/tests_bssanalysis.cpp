@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <gbs/bssanalysis.h>
+#include <map>
 using gbs::operator-;
+using gbs::operator+;
+using gbs::operator*;
+using gbs::operator^;
 const double tol = 1e-10;
 TEST(tests_bssanalysis, discretize_basic)
 {
@@ -39,4 +43,115 @@ TEST(tests_bssanalysis, discretize_basic)
 
     auto pts = gbs::discretize(srf,20,30);
 
-}
\ No newline at end of file
+}
+TEST(tests_bssanalysis, tessellate_crack_free)
+{
+    // saddle with a bump, on a non uniform knot grid
+    std::vector<double> ku = {0., 0., 0., 0., 0.3, 1., 1., 1., 1.};
+    std::vector<double> kv = {0., 0., 0., 0.5, 1., 1., 1.};
+    size_t p = 3, q = 2;
+    gbs::points_vector<double, 3> poles;
+    for (size_t j{}; j < 4; j++)
+        for (size_t i{}; i < 5; i++)
+            poles.push_back({i * 1., j * 1., (i == 2 && j == 1 ? 3. : 0.) + 0.2 * (i - 2.) * (j - 1.5)});
+    gbs::BSSurface<double, 3> srf(poles, ku, kv, p, q);
+
+    gbs::SurfaceTessellationCriteria<double> criteria;
+    criteria.chord_height = 1e-3;
+    criteria.max_angle = 0.2;
+    auto mesh = gbs::tessellate(srf, criteria);
+
+    ASSERT_EQ(mesh.points.size(), mesh.uv.size());
+    ASSERT_GT(mesh.triangles.size(), 2 * (4 * 3));
+
+    // every edge is shared by two triangles with opposite orientations, except the boundary ones
+    std::map<std::pair<size_t, size_t>, int> edges;
+    double area_uv{};
+    for (const auto &t : mesh.triangles)
+    {
+        for (size_t i{}; i < 3; i++)
+        {
+            auto a = t[i], b = t[(i + 1) % 3];
+            ASSERT_NE(a, b);
+            edges[{std::min(a, b), std::max(a, b)}] += a < b ? 1 : -1;
+        }
+        auto e1 = mesh.uv[t[1]] - mesh.uv[t[0]];
+        auto e2 = mesh.uv[t[2]] - mesh.uv[t[0]];
+        auto a = 0.5 * (e1[0] * e2[1] - e1[1] * e2[0]);
+        ASSERT_GT(a, 0.);
+        area_uv += a;
+    }
+    ASSERT_NEAR(area_uv, 1., 1e-12);
+    for (const auto &[e, count] : edges)
+    {
+        if (count != 0)
+        {
+            auto [u1, v1] = mesh.uv[e.first];
+            auto [u2, v2] = mesh.uv[e.second];
+            auto on_bound = [](double a, double b) { return (a == 0. && b == 0.) || (a == 1. && b == 1.); };
+            ASSERT_TRUE(on_bound(u1, u2) || on_bound(v1, v2));
+        }
+    }
+
+    // vertices lie on surface and triangles' centers are close to it
+    for (size_t k{}; k < mesh.points.size(); k++)
+        ASSERT_LT(gbs::distance(mesh.points[k], srf(mesh.uv[k][0], mesh.uv[k][1])), tol);
+    for (const auto &t : mesh.triangles)
+    {
+        auto uv = (1. / 3.) * (mesh.uv[t[0]] + mesh.uv[t[1]] + mesh.uv[t[2]]);
+        auto pt = (1. / 3.) * (mesh.points[t[0]] + mesh.points[t[1]] + mesh.points[t[2]]);
+        ASSERT_LT(gbs::distance(pt, srf(uv[0], uv[1])), 5 * criteria.chord_height);
+    }
+}
+
+TEST(tests_bssanalysis, tessellate_rational)
+{
+    // quarter of a cylinder, exact circle arcs in u
+    std::vector<double> ku = {0., 0., 0., 1., 1., 1.};
+    std::vector<double> kv = {0., 0., 1., 1.};
+    gbs::points_vector<double, 3> poles;
+    std::vector<double> weights;
+    for (size_t j{}; j < 2; j++)
+    {
+        for (const auto &[x, y, w] : std::vector<std::array<double, 3>>{{1., 0., 1.}, {1., 1., std::sqrt(0.5)}, {0., 1., 1.}})
+        {
+            poles.push_back({x, y, 2. * j});
+            weights.push_back(w);
+        }
+    }
+    gbs::BSSurfaceRational<double, 3> srf(poles, weights, ku, kv, 2, 1);
+
+    // normals are obtained from the homogeneous surface, checked against finite differences
+    double h = 1e-6;
+    for (auto [u, v] : std::vector<std::array<double, 2>>{{0.2, 0.3}, {0.5, 0.5}, {0.9, 0.1}})
+    {
+        auto n = gbs::detail::surface_normal(srf, u, v);
+        auto s_u = (1. / (2. * h)) * (srf(u + h, v) - srf(u - h, v));
+        auto s_v = (1. / (2. * h)) * (srf(u, v + h) - srf(u, v - h));
+        ASSERT_LT(gbs::norm(n - (s_u ^ s_v)), 1e-6);
+        // radial on a cylinder
+        auto pt = srf(u, v);
+        ASSERT_NEAR(gbs::norm(n ^ gbs::point<double, 3>{pt[0], pt[1], 0.}), 0., 1e-9);
+    }
+
+    gbs::SurfaceTessellationCriteria<double> criteria;
+    criteria.chord_height = 1e-2;
+    auto mesh = gbs::tessellate(srf, criteria);
+    criteria.max_angle = 0.05;
+    auto mesh_angle = gbs::tessellate(srf, criteria);
+    ASSERT_GT(mesh_angle.triangles.size(), mesh.triangles.size());
+
+    for (const auto *m : {&mesh, &mesh_angle})
+    {
+        ASSERT_EQ(m->points.size(), m->uv.size());
+        for (const auto &pt : m->points)
+        {
+            ASSERT_NEAR(pt[0] * pt[0] + pt[1] * pt[1], 1., tol);
+        }
+        for (const auto &t : m->triangles)
+        {
+            auto pt = (1. / 3.) * (m->points[t[0]] + m->points[t[1]] + m->points[t[2]]);
+            ASSERT_LT(1. - std::sqrt(pt[0] * pt[0] + pt[1] * pt[1]), 5 * criteria.chord_height);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <gbs/bssintegrals.h>
+#include <gbs/bscbuild.h>
+
+using gbs::operator-;
+
+namespace
+{
+    const double PI = acos(-1.);
+
+    // bilinear face, u along a and v along b, normal a^b
+    auto build_face(const gbs::point<double, 3> &o, const gbs::point<double, 3> &a, const gbs::point<double, 3> &b)
+    {
+        gbs::points_vector<double, 3> poles{o, gbs::operator+(o, a), gbs::operator+(o, b), gbs::operator+(gbs::operator+(o, a), b)};
+        return gbs::BSSurface<double, 3>{poles, {0., 0., 1., 1.}, {0., 0., 1., 1.}, 1, 1};
+    }
+}
+
+TEST(tests_bssintegrals, cube)
+{
+    gbs::point<double, 3> c{1., 2., 3.};
+    gbs::point<double, 3> ex{1., 0., 0.}, ey{0., 1., 0.}, ez{0., 0., 1.};
+    std::vector<std::shared_ptr<gbs::BSSurface<double, 3>>> faces{
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(c, ey, ex)),
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(gbs::operator+(c, ez), ex, ey)),
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(c, ez, ey)),
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(gbs::operator+(c, ex), ey, ez)),
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(c, ex, ez)),
+        std::make_shared<gbs::BSSurface<double, 3>>(build_face(gbs::operator+(c, ey), ez, ex))};
+
+    auto res = gbs::surfaces_integrals<double>(faces.begin(), faces.end());
+    ASSERT_EQ(res.size(), faces.size());
+    auto total = std::accumulate(res.begin(), res.end(), gbs::SurfaceIntegrals<double>{});
+
+    ASSERT_NEAR(total.area, 6., 1e-12);
+    ASSERT_NEAR(total.volume, 1., 1e-12);
+    for (size_t i{}; i < 3; i++)
+    {
+        ASSERT_NEAR(total.volume_moment[i] / total.volume, c[i] + 0.5, 1e-12);
+        ASSERT_NEAR(total.area_moment[i] / total.area, c[i] + 0.5, 1e-12);
+    }
+    auto I = gbs::inertia_tensor(total.volume_second_moments, total.volume_moment, total.volume);
+    for (size_t i{}; i < 3; i++)
+        for (size_t j{}; j < 3; j++)
+            ASSERT_NEAR(I[i][j], i == j ? 1. / 6. : 0., 1e-12);
+
+    // batched results match single surface ones exactly
+    for (size_t k{}; k < faces.size(); k++)
+        ASSERT_EQ(gbs::surface_integrals(*faces[k]).volume, res[k].volume);
+}
+
+TEST(tests_bssintegrals, cylinder)
+{
+    auto r = 2., h = 3.;
+    auto circle = gbs::build_circle<double, 3>(r);
+    std::vector<std::array<double, 4>> poles;
+    for (auto z : {0., h})
+        for (auto P : circle.poles())
+            poles.push_back({P[0], P[1], z * P[3], P[3]});
+    gbs::BSSurfaceRational<double, 3> srf{poles, circle.knotsFlats(), {0., 0., 1., 1.}, circle.degree(), 1};
+
+    // fused derivatives against finite differences, value doesn't support rational derivatives
+    auto [S, Su, Sv] = gbs::eval_d1(srf, 0.3, 0.6);
+    auto eps = 1e-6;
+    ASSERT_LT(gbs::norm(S - srf(0.3, 0.6)), 1e-12);
+    ASSERT_LT(gbs::norm(Su - gbs::operator*(1. / (2. * eps), srf(0.3 + eps, 0.6) - srf(0.3 - eps, 0.6))), 1e-6);
+    ASSERT_LT(gbs::norm(Sv - gbs::operator*(1. / (2. * eps), srf(0.3, 0.6 + eps) - srf(0.3, 0.6 - eps))), 1e-6);
+
+    auto res = gbs::surface_integrals(srf, 4);
+    ASSERT_NEAR(res.area, 2. * PI * r * h, 1e-10);
+    // lateral part of the closed cylinder's volume, the top cap contributing the remaining third
+    ASSERT_NEAR(std::fabs(res.volume), 2. / 3. * PI * r * r * h, 1e-10);
+    ASSERT_NEAR(res.area_moment[2] / res.area, 0.5 * h, 1e-10);
+    ASSERT_NEAR(res.area_second_moments[0][0], PI * r * r * r * h, 1e-9);
+}
@@ -685,3 +685,30 @@ TEST(tests_bssurf, approx_constrained)
     if(PLOT_ON)
         gbs::plot(srf,pts);
 }
+
+TEST(tests_bssurf, hodographs_cache)
+{
+    std::vector<double> ku = {0., 0., 0., 0., 0.5, 1., 1., 1., 1.};
+    std::vector<double> kv = {0., 0., 0., 1., 2., 2., 2.};
+    gbs::points_vector<double, 3> poles;
+    for (size_t j{}; j < 4; j++)
+        for (size_t i{}; i < 5; i++)
+            poles.push_back({i * 1., j * 1., std::sin(1. * i * j)});
+    gbs::BSSurface<double, 3> srf{poles, ku, kv, 3, 2};
+    auto ref{srf};
+    srf.enableHodographs();
+    ASSERT_TRUE(srf.hodographsEnabled());
+    ASSERT_EQ(srf.hodograph(1, 1).degreeU(), 2);
+    ASSERT_EQ(srf.hodograph(1, 1).degreeV(), 1);
+    ASSERT_THROW(srf.hodograph(2, 0), std::out_of_range);
+
+    for (auto u : gbs::make_range(0., 1., 11))
+        for (auto v : gbs::make_range(0., 2., 11))
+            for (auto [du, dv] : std::vector<std::pair<size_t, size_t>>{{0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}})
+                ASSERT_LT(gbs::norm(srf(u, v, du, dv) - ref(u, v, du, dv)), 1e-10);
+
+    srf.insertKnotV(0.5);
+    srf.setPole(0, 0, {0., 0., 5.});
+    gbs::BSSurface<double, 3> ref_mod{srf.poles(), srf.knotsFlatsU(), srf.knotsFlatsV(), 3, 2};
+    ASSERT_LT(gbs::norm(srf(0.05, 0.1, 1, 1) - ref_mod(0.05, 0.1, 1, 1)), 1e-10);
+}
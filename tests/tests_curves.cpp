@@ -3,6 +3,7 @@
 #include <gbs/maths.h>
 #include <gbs/bscbuild.h>
 #include <gbs/bscapprox.h>
+#include <gbs/bsctools.h>
 #include <gbs/vecop.h>
 #include <gbs/bscanalysis.h>
 #include <gbs-io/print.h>
@@ -338,6 +339,51 @@ TEST(tests_curves,composite)
         );
 }
 
+TEST(tests_curves,composite_flatten)
+{
+    auto seg1 = gbs::build_segment<double,2>({0.,0.},{2.,1.});
+    auto circle = gbs::Circle2d<double>(1., {1.,1.});
+    gbs::BSCurve<double,2> seg3 {
+        gbs::points_vector<double,2>{{2.,1.},{2.,2.},{3.,2.},{3.,3.}},
+        std::vector<double>{0.,0.,0.,0.,1.,1.,1.,1.},
+        3
+    };
+    std::vector<std::shared_ptr<gbs::Curve<double,2>>> crv_lst {
+        std::make_shared<gbs::BSCurve<double,2>>(seg1),
+        std::make_shared<gbs::Circle2d<double>>(circle),
+        std::make_shared<gbs::BSCurve<double,2>>(seg3)
+    };
+    gbs::CurveComposite<double,2> cc(crv_lst);
+    auto tol = 1e-6;
+    auto flat = gbs::flatten(crv_lst, tol);
+    ASSERT_EQ(flat.degree(), 3);
+    auto [u1, u2] = cc.bounds();
+    ASSERT_NEAR(flat.bounds()[0], u1, 1e-12);
+    ASSERT_NEAR(flat.bounds()[1], u2, 1e-12);
+    std::vector<double> u_lst = gbs::make_range(u1, u2, 1000);
+    std::vector<gbs::point<double,2>> pts(u_lst.size());
+    std::transform(u_lst.begin(), u_lst.end(), pts.begin(), [&cc](double u){return cc(u);});
+
+    ASSERT_EQ(cc.flatCurve(), nullptr);
+    cc.enableFlat(tol);
+    ASSERT_NE(cc.flatCurve(), nullptr);
+    for (size_t i{}; i < u_lst.size(); i++)
+    {
+        ASSERT_LT(gbs::distance(cc(u_lst[i]), pts[i]), tol);
+        ASSERT_LT(gbs::distance(flat(u_lst[i]), pts[i]), tol);
+    }
+    cc.disableFlat();
+    ASSERT_EQ(cc.flatCurve(), nullptr);
+
+    auto seg4 = gbs::build_segment<double,2>({3.,3.},{4.,3.});
+    auto joined = gbs::join(std::vector<gbs::BSCurve<double,2>>{seg1, seg3, seg4});
+    ASSERT_EQ(joined.degree(), 3);
+    ASSERT_EQ(joined.poles().size(), 4 + 3 + 3);
+    auto l1 = seg1.bounds()[1]; // segments are chord length parametrized
+    ASSERT_LT(gbs::distance(joined(l1 + 0.5), seg3(0.5)), 1e-12);
+    ASSERT_LT(gbs::distance(joined(l1 + 1.5), seg4(0.5)), 1e-12);
+}
+
 TEST(tests_curves,HardPoints)
 {
     auto crv = gbs::BSCurve<double,2>(
@@ -487,6 +487,47 @@ TEST(tests_knotsfunctions, remove_knot)
 
 }
 
+TEST(tests_knotsfunctions, remove_knot_multiple)
+{
+    points_vector<double,2> poles{{0.,0.},{1.,2.},{2.,-1.},{3.,0.5},{4.,1.},{5.,3.},{6.,0.}};
+    std::vector<double> k{0., 0., 0., 0., 0., 1. / 3., 2. / 3., 1., 1., 1., 1., 1.};
+    size_t p = 4;
+    BSCurve<double,2> c_ref{poles, k, p};
+    auto u = k[p+1];
+
+    auto check_curve = [&](const auto &crv)
+    {
+        int n = 1000;
+        for( int i = 0 ; i < n; i++)
+        {
+            auto u_ = i / (n-1.);
+            ASSERT_LT(gbs::distance(c_ref(u_), crv(u_)), tol);
+        }
+    };
+
+    // m = 1, the inserted knot is removed
+    auto c1 = c_ref;
+    c1.insertKnot(u, 1);
+    c1.removeKnot(u, 1e-8, 1);
+    ASSERT_EQ(c1.poles().size(), poles.size());
+    check_curve(c1);
+
+    // m = 2, the second removal fails and the curve stays as the first one left it
+    auto c2 = c_ref;
+    c2.insertKnot(u, 1);
+    c2.removeKnot(u, 1e-8, 2);
+    ASSERT_EQ(c2.poles().size(), poles.size());
+    ASSERT_EQ(c2.knotsFlats().size(), k.size());
+    check_curve(c2);
+
+    // m = 2 on a twice inserted knot, both are removed
+    auto c3 = c_ref;
+    c3.insertKnot(u, 2);
+    c3.removeKnot(u, 1e-8, 2);
+    ASSERT_EQ(c3.poles().size(), poles.size());
+    check_curve(c3);
+}
+
 TEST(tests_knotsfunctions, reparam1)
 {
     std::vector<double> k1 = {0., 0., 0., 1, 2, 3, 4, 5., 5., 5.};
@@ -705,4 +705,95 @@ TEST(tests_mesh, tfi_mesh_2d_no_hard_vtx_opt)
     if(PLOT_ON)
         gbs::plot( iso_eth, iso_ksi, pts);
 }
- 
\ No newline at end of file
+ 
+TEST(tests_mesh, tfi_mesh_2d_blend_tables)
+{
+    using T = double;
+    using namespace gbs;
+    const size_t P = 2;
+    const size_t Q = 2;
+
+    std::vector<T> knots{0., 0., 0., 1., 1., 1.};
+    points_vector<T, 3> poles;
+    for (size_t j{}; j < 3; j++)
+    {
+        for (size_t i{}; i < 3; i++)
+        {
+            poles.push_back({i * 0.5, j * 0.5, (i == 1 && j == 1 ? 0.5 : 0.)});
+        }
+    }
+    auto p_srf = std::make_shared<BSSurface<T, 3>>(poles, knots, knots, 2, 2);
+
+    std::vector<T> ksi_i{0., 0.3, 0.7, 1.};
+    std::vector<T> eth_j{0., 0.4, 1.};
+    std::vector<std::shared_ptr<Curve<T, 3>>> iso_eth, iso_ksi;
+    for (auto eth : eth_j)
+    {
+        iso_eth.push_back(std::make_shared<CurveOnSurface<T, 3>>(std::make_shared<BSCurve<T, 2>>(build_segment(point<T, 2>{0., eth}, point<T, 2>{1., eth})), p_srf));
+    }
+    for (auto ksi : ksi_i)
+    {
+        iso_ksi.push_back(std::make_shared<CurveOnSurface<T, 3>>(std::make_shared<BSCurve<T, 2>>(build_segment(point<T, 2>{ksi, 0.}, point<T, 2>{ksi, 1.})), p_srf));
+    }
+    auto alpha_i = build_tfi_blend_function_with_derivatives<T, P, false>(ksi_i);
+    auto beta_j = build_tfi_blend_function_with_derivatives<T, Q, false>(eth_j);
+
+    // meshes the lattice and checks the nodes of every stride-th mesh line against the direct evaluation of the blends
+    auto check = [&](size_t n_ksi, size_t n_eth, size_t stride)
+    {
+        auto n_iso_eth = msh_curves_set_sizes(iso_eth, ksi_i, n_eth);
+        auto n_iso_ksi = msh_curves_set_sizes(iso_ksi, eth_j, n_ksi);
+        auto [X_ksi, X_eth, X_ksi_eth, ksi, eth] = msh_curves_lattice<T, 3, P, Q>(iso_ksi, iso_eth, ksi_i, eth_j, n_iso_ksi, n_iso_eth, p_srf);
+        auto pts = tfi_mesh_2d<T, 3, P, Q>(X_ksi, X_eth, X_ksi_eth, ksi_i, eth_j, ksi, eth);
+        auto ni_ = X_eth.size();
+        auto nj_ = X_ksi.size();
+        ASSERT_EQ(pts.size(), ni_ * nj_);
+        for (size_t i_{}; i_ < ni_; i_++)
+        {
+            for (size_t j_{}; j_ < nj_; j_++)
+            {
+                if (i_ % stride != 0 && j_ % stride != 0 && i_ != ni_ - 1 && j_ != nj_ - 1)
+                {
+                    continue;
+                }
+                point<T, 3> U{}, V{}, UV{};
+                auto ksi_i_{ksi(i_)};
+                auto eth_j_{eth(j_)};
+                for (size_t i{}; i < ksi_i.size(); i++)
+                {
+                    for (size_t n{}; n < P; n++)
+                    {
+                        U += alpha_i[i][n](ksi_i_) * X_ksi[j_][i][n];
+                    }
+                }
+                for (size_t j{}; j < eth_j.size(); j++)
+                {
+                    for (size_t m{}; m < Q; m++)
+                    {
+                        V += beta_j[j][m](eth_j_) * X_eth[i_][j][m];
+                    }
+                }
+                for (size_t i{}; i < ksi_i.size(); i++)
+                {
+                    for (size_t j{}; j < eth_j.size(); j++)
+                    {
+                        for (size_t n{}; n < P; n++)
+                        {
+                            for (size_t m{}; m < Q; m++)
+                            {
+                                UV += alpha_i[i][n](ksi_i_) * beta_j[j][m](eth_j_) * X_ksi_eth[i][j][n][m];
+                            }
+                        }
+                    }
+                }
+                ASSERT_LT(distance(pts[j_ + nj_ * i_], U + V - UV), 1e-12);
+            }
+        }
+    };
+    check(23, 37, 1);
+    check(1000, 1000, 97);
+
+    // the surface overload builds the same lattice
+    auto [pts, ni, nj, n_iso_eth, n_iso_ksi] = tfi_mesh_2d<T, 3, P, Q>(p_srf, ksi_i, eth_j, 23, 37);
+    ASSERT_EQ(pts.size(), ni * nj);
+}
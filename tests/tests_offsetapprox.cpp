@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <gbs/offsetapprox.h>
+#include <gbs/bscbuild.h>
+
+using gbs::operator-;
+
+TEST(tests_offsetapprox, curve2d_offset)
+{
+    auto circle = gbs::build_circle<double, 2>(1.);
+    auto p_circle = std::make_shared<gbs::BSCurveRational<double, 2>>(circle);
+    auto f_offset = [](auto u, size_t d = 0) { return d == 0 ? 0.2 * std::sin(u * 2. * std::numbers::pi * 3) - 0.3 : 0.2 * 2. * std::numbers::pi * 3 * std::cos(u * 2. * std::numbers::pi * 3); };
+    gbs::CurveOffset2D<double, decltype(f_offset)> offset{p_circle, f_offset};
+
+    auto tol = 1e-6;
+    auto crv = gbs::approx_offset(offset, tol);
+    ASSERT_EQ(crv.degree(), 3);
+    auto [u1, u2] = crv.bounds();
+    for (auto u : gbs::make_range(u1, u2, 1000))
+        ASSERT_LT(gbs::distance(crv(u), offset(u)), tol);
+}
+
+TEST(tests_offsetapprox, curve3d_offset)
+{
+    auto circle = gbs::build_circle<double, 3>(1.);
+    auto p_circle = std::make_shared<gbs::BSCurveRational<double, 3>>(circle);
+    auto f_offset = gbs::BSCfunction<double>(gbs::build_segment<double, 1>({-0.2}, {-0.2}, true));
+    gbs::CurveOffset3D<double, gbs::BSCfunction<double>> offset{p_circle, f_offset, {0., 0., 1.}};
+
+    auto tol = 1e-5;
+    auto crv = gbs::approx_offset(offset, tol, 5);
+    ASSERT_EQ(crv.degree(), 5);
+    auto [u1, u2] = crv.bounds();
+    for (auto u : gbs::make_range(u1, u2, 1000))
+    {
+        ASSERT_LT(gbs::distance(crv(u), offset(u)), tol);
+        ASSERT_NEAR(gbs::norm(crv(u)), 1.2, tol);
+    }
+}
+
+TEST(tests_offsetapprox, surface_offset)
+{
+    std::vector<double> ku{0., 0., 0., 0.5, 1., 1., 1.};
+    std::vector<double> kv{0., 0., 0., 1., 1., 1.};
+    gbs::points_vector<double, 3> poles;
+    for (size_t j{}; j < 3; j++)
+        for (size_t i{}; i < 4; i++)
+            poles.push_back({double(i), double(j), 0.3 * std::sin(double(i + j))});
+    gbs::BSSurface<double, 3> srf{poles, ku, kv, 2, 2};
+    auto f_offset = [](double u, double v) { return 0.1 + 0.05 * u * v; };
+    gbs::SurfaceOffset<double, 3, decltype(f_offset)> offset{srf, f_offset};
+
+    auto tol = 1e-5;
+    auto approx = gbs::approx_offset(offset, tol);
+    ASSERT_EQ(approx.degreeU(), 3);
+    ASSERT_EQ(approx.degreeV(), 3);
+    for (auto u : gbs::make_range(0., 1., 37))
+        for (auto v : gbs::make_range(0., 1., 41))
+            ASSERT_LT(gbs::distance(approx(u, v), offset(u, v)), tol);
+    ASSERT_THROW(offset(0.5, 0.5, 1, 0), std::runtime_error);
+}
@@ -182,4 +182,55 @@ TEST(tests_solvers, solve_D_nlop)
             nlopt::LD_CCSAQ
             );
         ASSERT_NEAR(minf,0.,tol);
-    }
\ No newline at end of file
+    }
+TEST(tests_solvers, solve_LM)
+{
+    // same system as solve_D_nlop, with analytic Jacobian
+    double a = 2., b = 1., c = 3., d = 1., Y1 = 2., Y2 = 6.;
+    auto f = [=](const std::array<double, 2> &X)
+    {
+        auto [x, y] = X;
+        return std::array<double, 2>{a * x * x + b * y - Y1, c * x + d * exp(y) - Y2};
+    };
+    auto jac = [=](const std::array<double, 2> &X, const std::array<double, 2> &)
+    {
+        auto [x, y] = X;
+        return gbs::jacobian<double, 2, 2>{{{2. * a * x, b}, {c, d * exp(y)}}};
+    };
+    std::array<double, 2> x{0., 0.};
+    auto tol = 1.e-10;
+    auto [cost, converged] = gbs::solve_LM(f, jac, x, {-10., -10.}, {10., 10.}, tol);
+    ASSERT_TRUE(converged);
+    ASSERT_NEAR(cost, 0., tol);
+    auto r = f(x);
+    ASSERT_NEAR(r[0], 0., 1e-8);
+    ASSERT_NEAR(r[1], 0., 1e-8);
+
+    // finite differences Jacobian
+    std::array<double, 2> x_fd{0., 0.};
+    auto [cost_fd, converged_fd] = gbs::solve_LM(f, x_fd, {-10., -10.}, {10., 10.}, tol);
+    ASSERT_TRUE(converged_fd);
+    ASSERT_NEAR(x_fd[0], x[0], 1e-7);
+    ASSERT_NEAR(x_fd[1], x[1], 1e-7);
+}
+
+TEST(tests_solvers, solve_least_squares_bounded)
+{
+    // closest point from circle to 3d line, with over determined residuals (3 for 2 unknowns) and active bound
+    auto r = 0.2;
+    auto f = [r](const std::array<double, 2> &X)
+    {
+        auto [th, u] = X;
+        return std::array<double, 3>{r * cos(th) - u, r * sin(th) + 1., -0.5 * u};
+    };
+    auto jac = [r](const std::array<double, 2> &X, const std::array<double, 3> &)
+    {
+        auto [th, u] = X;
+        return gbs::jacobian<double, 2, 3>{{{-r * sin(th), -1.}, {r * cos(th), 0.}, {0., -0.5}}};
+    };
+    std::array<double, 2> x{4., 0.5};
+    auto cost = gbs::solve_least_squares(f, jac, x, {0., -1.}, {2 * pi, 1.}, 1e-10, nlopt::LD_CCSAQ);
+    ASSERT_NEAR(cost, 0.8 * 0.8, 1e-8);
+    ASSERT_NEAR(x[0], 3. * pi / 2., 1e-5);
+    ASSERT_NEAR(x[1], 0., 1e-5);
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <topology/halfEdgeMeshCompact.h>
+#include <topology/halfEdgeMeshEditors.h>
+
+using namespace gbs;
+
+namespace
+{
+    // links' consistency of all the elements in use
+    template <std::floating_point T, size_t dim>
+    void check_links(const CompactHalfEdgeMesh<T, dim> &msh)
+    {
+        size_t n_edges{};
+        for (auto f : msh.faces())
+        {
+            for (auto e : msh.getFaceEdges(f))
+            {
+                n_edges++;
+                ASSERT_TRUE(msh.isEdge(e));
+                ASSERT_EQ(msh.face(e), f);
+                ASSERT_EQ(msh.previous(msh.next(e)), e);
+                auto opp = msh.opposite(e);
+                if (opp != he_null)
+                {
+                    ASSERT_EQ(msh.opposite(opp), e);
+                    ASSERT_EQ(msh.vertex(opp), msh.tail(e));
+                    ASSERT_EQ(msh.tail(opp), msh.vertex(e));
+                }
+            }
+        }
+        ASSERT_EQ(n_edges, msh.nEdges());
+        for (auto v : msh.vertices())
+        {
+            auto e = msh.vertexEdge(v);
+            if (e != he_null)
+            {
+                ASSERT_TRUE(msh.isEdge(e));
+                ASSERT_EQ(msh.vertex(e), v);
+            }
+        }
+    }
+    // n x n squares split in two ccw triangles
+    auto make_grid(size_t n)
+    {
+        CompactHalfEdgeMesh<double, 2> msh;
+        msh.reserve((n + 1) * (n + 1), 2 * n * n);
+        for (size_t j{}; j <= n; j++)
+            for (size_t i{}; i <= n; i++)
+                msh.addVertex({double(i), double(j)});
+        auto id = [n](size_t i, size_t j) { return HeIndex(i + j * (n + 1)); };
+        for (size_t j{}; j < n; j++)
+            for (size_t i{}; i < n; i++)
+            {
+                msh.addFace({id(i, j), id(i + 1, j), id(i + 1, j + 1)});
+                msh.addFace({id(i, j), id(i + 1, j + 1), id(i, j + 1)});
+            }
+        msh.linkOpposites();
+        return msh;
+    }
+}
+
+TEST(HalfEdgeMeshCompactTest, Getters)
+{
+    auto msh = make_grid(4);
+    check_links(msh);
+    ASSERT_EQ(msh.nVertices(), 25);
+    ASSERT_EQ(msh.nFaces(), 32);
+    ASSERT_EQ(msh.nEdges(), 96);
+
+    HeIndex center = 12, corner = 0;
+    ASSERT_EQ(msh.getFacesAttachedToVertex(center).size(), 6);
+    ASSERT_EQ(msh.getNeighboringVertices(center).size(), 6);
+    ASSERT_EQ(msh.getFacesAttachedToVertex(corner).size(), 2);
+    ASSERT_EQ(msh.getNeighboringVertices(corner).size(), 3);
+    auto corner_neighbors = msh.getNeighboringVertices(corner);
+    for (HeIndex v : {1, 5, 6})
+        ASSERT_NE(std::ranges::find(corner_neighbors, v), corner_neighbors.end());
+
+    // first square's triangles share the diagonal
+    auto f = msh.faces()[0], f_diag = msh.faces()[1];
+    auto neighbors = msh.getNeighboringFaces(f);
+    ASSERT_EQ(neighbors.size(), 2);
+    ASSERT_NE(std::ranges::find(neighbors, f_diag), neighbors.end());
+    auto e = msh.getCommonEdge(f, f_diag);
+    ASSERT_NE(e, he_null);
+    ASSERT_EQ(msh.getNextFace(e), f_diag);
+    auto [e1, e2] = msh.getCommonEdges(f, f_diag);
+    ASSERT_EQ(msh.opposite(e1), e2);
+    ASSERT_NEAR(msh.edgeSqLength(e), 2., 1e-14);
+    auto [x, y] = msh.edgeMidpoint(e);
+    ASSERT_NEAR(x, 0.5, 1e-14);
+    ASSERT_NEAR(y, 0.5, 1e-14);
+
+    auto boundary = msh.getFacesBoundary(msh.faces());
+    ASSERT_EQ(boundary.size(), 16);
+}
+
+TEST(HalfEdgeMeshCompactTest, Editors)
+{
+    auto msh = make_grid(3);
+    auto f_lst = msh.faces();
+    auto f1 = f_lst[8], f2 = f_lst[9];
+    auto v_lst = msh.getTriangleVertices(f1);
+    msh.flip(f1, f2);
+    check_links(msh);
+    ASSERT_NE(msh.getCommonEdge(f1, f2), he_null);
+    ASSERT_NE(v_lst, msh.getTriangleVertices(f1));
+
+    auto n_faces = msh.nFaces();
+    auto v = msh.addVertex({1.6, 1.3});
+    auto fan = msh.addVertex(f1, v);
+    ASSERT_EQ(fan.size(), 3);
+    ASSERT_EQ(msh.nFaces(), n_faces + 2);
+    ASSERT_EQ(msh.getFacesAttachedToVertex(v).size(), 3);
+    check_links(msh);
+
+    auto e = msh.faceEdge(f_lst[0]);
+    msh.setConstrained(e);
+    if (msh.opposite(e) != he_null)
+        msh.setConstrained(msh.opposite(e));
+    auto v_mid = msh.splitHalfEdge(e);
+    check_links(msh);
+    // both halves keep the constraint
+    size_t n_constrained{};
+    for (auto f : msh.getFacesAttachedToVertex(v_mid))
+        for (auto e_f : msh.getFaceEdges(f))
+            n_constrained += msh.constrained(e_f);
+    ASSERT_EQ(n_constrained, msh.opposite(e) != he_null ? 4 : 2);
+    ASSERT_EQ(msh.nFaces(), n_faces + 2 + (msh.opposite(e) != he_null ? 2 : 1));
+    ASSERT_EQ(msh.getFacesAttachedToVertex(v_mid).size(), msh.opposite(e) != he_null ? 4 : 2);
+
+    // free lists reuse removed elements
+    auto n_removed = msh.removeFaces(v);
+    ASSERT_EQ(n_removed, 3);
+    check_links(msh);
+    auto n_edges = msh.nEdges();
+    auto boundary = msh.getFacesBoundary(msh.faces());
+    auto f_new = msh.addFace(boundary.front(), {10., 10.});
+    ASSERT_NE(f_new, he_null);
+    ASSERT_LT(f_new, n_faces + 4);
+    ASSERT_EQ(msh.nEdges(), n_edges + 3);
+    check_links(msh);
+    ASSERT_EQ(msh.addFace(boundary.front(), {10., 10.}), he_null);
+}
+
+TEST(HalfEdgeMeshCompactTest, CavityInsertion)
+{
+    auto msh = make_grid(6);
+    // V - E + F of a disk, E counting boundary half-edges once and inner ones by pair
+    auto euler = [&msh]()
+    {
+        auto n_boundary = msh.getFacesBoundary(msh.faces()).size();
+        return long(msh.nVertices()) - long(msh.nEdges() + n_boundary) / 2 + long(msh.nFaces());
+    };
+    ASSERT_EQ(euler(), 1);
+
+    for (size_t i{}; i < 10; i++)
+    {
+        // inner triangle and its three neighbors, the inner triangle has no boundary half-edge
+        auto f_lst = msh.faces();
+        auto it = std::ranges::find_if(f_lst, [&msh](HeIndex f) {
+            std::unordered_set<HeIndex> v_set;
+            for (auto e : msh.getFaceEdges(f))
+            {
+                if (msh.opposite(e) == he_null)
+                    return false;
+                v_set.insert(msh.vertex(e));
+                v_set.insert(msh.vertex(msh.next(msh.opposite(e))));
+            }
+            return v_set.size() == 6; // simple boundary loop
+        });
+        ASSERT_NE(it, f_lst.end());
+        std::vector<HeIndex> boundary;
+        for (auto e : msh.getFaceEdges(*it))
+        {
+            auto opp = msh.opposite(e);
+            boundary.push_back(msh.next(opp));
+            boundary.push_back(msh.next(msh.next(opp)));
+        }
+        auto [a, b, c] = msh.getTriangleCoords(*it);
+        auto n_faces = msh.nFaces();
+        auto v = msh.addVertex({(a[0] + b[0] + c[0]) / 3., (a[1] + b[1] + c[1]) / 3.});
+        auto fan = msh.addVertex(boundary, v);
+        ASSERT_EQ(fan.size(), 6);
+        ASSERT_EQ(msh.nFaces(), n_faces + 2);
+        ASSERT_EQ(msh.faces().size(), msh.nFaces());
+        ASSERT_EQ(euler(), 1);
+        check_links(msh);
+    }
+}
+
+TEST(HalfEdgeMeshCompactTest, SharedConversion)
+{
+    std::vector<std::array<double, 2>> X_lst{{0., 0.}, {1., 0.}, {0.5, 1.}, {0.3, 0.4}};
+    auto faces_lst = getEncompassingMesh(X_lst);
+    auto h_v = make_shared_h_vertex<double, 2>({0.5, 0.3});
+    auto new_faces = add_vertex(faces_lst.front(), h_v);
+    faces_lst.pop_front();
+    faces_lst.insert(faces_lst.end(), new_faces.begin(), new_faces.end());
+    auto h_e_constrained = new_faces.front()->edge;
+    h_e_constrained->constrained = true;
+    if (h_e_constrained->opposite)
+    {
+        h_e_constrained->opposite->constrained = true;
+    }
+
+    auto msh = make_compact_h_mesh<double, 2>(faces_lst);
+    check_links(msh);
+    ASSERT_EQ(msh.nFaces(), faces_lst.size());
+    ASSERT_EQ(msh.nVertices(), 5);
+
+    auto faces_back = to_shared_h_faces(msh);
+    ASSERT_EQ(faces_back.size(), faces_lst.size());
+    auto it = faces_lst.begin();
+    size_t n_constrained{};
+    for (const auto &h_f : faces_back)
+    {
+        auto coords = getFaceCoords(h_f);
+        auto edges_ref = getFaceEdges(*it);
+        auto coords_ref = getFaceCoords(*it++);
+        ASSERT_EQ(coords, coords_ref);
+        auto h_e_ref = edges_ref.begin();
+        for (const auto &h_e : getFaceEdges(h_f))
+        {
+            ASSERT_EQ(h_e->constrained, (*h_e_ref++)->constrained);
+            n_constrained += h_e->constrained;
+            if (h_e->opposite)
+            {
+                ASSERT_EQ(h_e->opposite->opposite, h_e);
+                ASSERT_EQ(h_e->opposite->constrained, h_e->constrained);
+            }
+        }
+    }
+    ASSERT_EQ(n_constrained, h_e_constrained->opposite ? 2 : 1);
+    ASSERT_EQ((getVerticesVectorFromFaces<double, 2>(faces_back).size()), 5);
+}
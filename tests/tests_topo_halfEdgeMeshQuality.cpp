@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <topology/tessellations.h>
+#include <topology/halfEdgeMeshQuality.h>
+
+using namespace gbs;
+
+namespace
+{
+    // Per triangle measures from the sides' lengths and the law of cosines
+    auto reference_measures(const SurfaceTessellation<double, 3> &mesh, const std::array<size_t, 3> &t) -> std::array<double, 4>
+    {
+        const auto &a = mesh.points[t[0]];
+        const auto &b = mesh.points[t[1]];
+        const auto &c = mesh.points[t[2]];
+        std::array<double, 3> l{distance(b, c), distance(a, c), distance(a, b)};
+        auto area = 0.5 * norm((b - a) ^ (c - a));
+        std::array<double, 3> angles;
+        for (size_t k{}; k < 3; k++)
+        {
+            auto l1 = l[(k + 1) % 3];
+            auto l2 = l[(k + 2) % 3];
+            angles[k] = std::acos((l1 * l1 + l2 * l2 - l[k] * l[k]) / (2. * l1 * l2)) * 180. / std::numbers::pi;
+        }
+        auto [a_min, a_max] = std::minmax_element(angles.begin(), angles.end());
+        auto [l_min, l_max] = std::minmax_element(l.begin(), l.end());
+        return {
+            *a_min,
+            *l_max * (l[0] + l[1] + l[2]) / (4. * std::sqrt(3.) * area),
+            std::max((*a_max - 60.) / 120., (60. - *a_min) / 60.),
+            *l_max / *l_min};
+    }
+}
+
+TEST(tests_topo_halfEdgeMeshQuality, triangle_measures)
+{
+    // equilateral, right isosceles and flat triangles
+    SurfaceTessellation<double, 2> mesh;
+    mesh.points = {{0., 0.}, {1., 0.}, {0.5, std::sqrt(3.) / 2.}, {0., 1.}, {2., 0.}};
+    mesh.triangles = {{0, 1, 2}, {0, 1, 3}, {0, 1, 4}};
+
+    auto measures = getTriangleQualityMeasures(mesh);
+    ASSERT_NEAR(measures.min_angle[0], 60., 1e-12);
+    ASSERT_NEAR(measures.aspect_ratio[0], 1., 1e-12);
+    ASSERT_NEAR(measures.skewness[0], 0., 1e-12);
+    ASSERT_NEAR(measures.edge_ratio[0], 1., 1e-12);
+
+    ASSERT_NEAR(measures.min_angle[1], 45., 1e-12);
+    ASSERT_NEAR(measures.aspect_ratio[1], (std::sqrt(2.) + 1.) / std::sqrt(3.), 1e-12);
+    ASSERT_NEAR(measures.skewness[1], 0.25, 1e-12);
+    ASSERT_NEAR(measures.edge_ratio[1], std::sqrt(2.), 1e-12);
+
+    ASSERT_EQ(measures.min_angle[2], 0.);
+    ASSERT_TRUE(std::isinf(measures.aspect_ratio[2]));
+    ASSERT_NEAR(measures.skewness[2], 1., 1e-12);
+    ASSERT_NEAR(measures.edge_ratio[2], 2., 1e-12);
+    ASSERT_TRUE(measures.chord_deviation.empty());
+
+    auto report = make_quality_report(measures, 6, 2);
+    ASSERT_EQ(report.n_triangles, 3);
+    ASSERT_EQ(report.min_angle.worst.size(), 2);
+    ASSERT_EQ(report.min_angle.worst[0].second, 2);
+    ASSERT_EQ(report.min_angle.worst[1].second, 1);
+    ASSERT_EQ(report.min_angle.histogram.counts, (std::vector<size_t>{1, 0, 0, 0, 1, 1}));
+    ASSERT_EQ(report.aspect_ratio.worst[0].second, 2);
+    // finite values' range
+    ASSERT_NEAR(report.aspect_ratio.histogram.upper, measures.aspect_ratio[1], 1e-12);
+    ASSERT_EQ(report.aspect_ratio.histogram.counts.front(), 1);
+    ASSERT_EQ(report.aspect_ratio.histogram.counts.back(), 2);
+    ASSERT_NEAR(report.edge_ratio.mean, (1. + std::sqrt(2.) + 2.) / 3., 1e-12);
+    ASSERT_TRUE(report.chord_deviation.worst.empty());
+}
+
+TEST(tests_topo_halfEdgeMeshQuality, surface_report)
+{
+    std::vector<double> k = {0., 0., 0., 1., 1., 1.};
+    points_vector<double, 3> poles;
+    for (size_t j{}; j < 3; j++)
+    {
+        for (size_t i{}; i < 3; i++)
+        {
+            poles.push_back({i * 0.5, j * 0.5, (i == 1 && j == 1 ? 0.5 : 0.)});
+        }
+    }
+    BSSurface<double, 3> srf(poles, k, k, 2, 2);
+
+    std::mt19937 gen{5};
+    std::uniform_real_distribution<double> dist{0., 1.};
+    std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+    for (size_t i{}; i < 500; i++)
+    {
+        coords.push_back({dist(gen), dist(gen)});
+    }
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+    auto mesh = make_surface_tessellation(faces_lst, srf);
+
+    auto report = getMeshQualityReport(mesh, srf, 10, 5);
+    ASSERT_EQ(report.n_triangles, mesh.triangles.size());
+    for (const auto *stats : {&report.min_angle, &report.aspect_ratio, &report.skewness, &report.edge_ratio, &report.chord_deviation})
+    {
+        ASSERT_EQ(std::reduce(stats->histogram.counts.begin(), stats->histogram.counts.end()), mesh.triangles.size());
+        ASSERT_EQ(stats->worst.size(), 5);
+        ASSERT_LE(stats->min, stats->mean);
+        ASSERT_LE(stats->mean, stats->max);
+    }
+    ASSERT_EQ(report.min_angle.worst.front().first, report.min_angle.min);
+    ASSERT_EQ(report.chord_deviation.worst.front().first, report.chord_deviation.max);
+    for (size_t i{1}; i < 5; i++)
+    {
+        ASSERT_GE(report.chord_deviation.worst[i - 1].first, report.chord_deviation.worst[i].first);
+    }
+
+    // the worst chord deviation is checked against the surface's mid points
+    auto t = mesh.triangles[report.chord_deviation.worst.front().second];
+    ASSERT_GT(report.chord_deviation.max, 0.);
+    auto uv = (mesh.uv[t[0]] + mesh.uv[t[1]] + mesh.uv[t[2]]) / 3.;
+    auto pt = (mesh.points[t[0]] + mesh.points[t[1]] + mesh.points[t[2]]) / 3.;
+    ASSERT_LE(distance(pt, srf(uv)), report.chord_deviation.max);
+
+    // no deviation on a plane
+    BSSurface<double, 3> plane(points_vector<double, 3>{{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}, {1., 1., 0.}}, {0., 0., 1., 1.}, {0., 0., 1., 1.}, 1, 1);
+    ASSERT_NEAR(getMeshQualityReport(make_surface_tessellation(faces_lst, plane), plane).chord_deviation.max, 0., 1e-12);
+}
+
+TEST(tests_topo_halfEdgeMeshQuality, performance)
+{
+    size_t n = 700;
+    std::mt19937 gen{6};
+    std::uniform_real_distribution<double> dist{-0.3, 0.3};
+    SurfaceTessellation<double, 3> mesh;
+    for (size_t j{}; j <= n; j++)
+    {
+        for (size_t i{}; i <= n; i++)
+        {
+            mesh.points.push_back({i + dist(gen), j + dist(gen), dist(gen)});
+        }
+    }
+    for (size_t j{}; j < n; j++)
+    {
+        for (size_t i{}; i < n; i++)
+        {
+            auto id = i + j * (n + 1);
+            mesh.triangles.push_back({id, id + 1, id + n + 2});
+            mesh.triangles.push_back({id, id + n + 2, id + n + 1});
+        }
+    }
+
+    auto measures = getTriangleQualityMeasures(mesh);
+    auto report = make_quality_report(measures);
+    ASSERT_EQ(report.n_triangles, 2 * n * n);
+
+    // every triangle, across blocks, against the one triangle at a time computation
+    std::array<double, 4> min{}, max{}, sum{};
+    min.fill(std::numeric_limits<double>::max());
+    for (size_t i{}; i < mesh.triangles.size(); i++)
+    {
+        auto ref = reference_measures(mesh, mesh.triangles[i]);
+        std::array<double, 4> res{measures.min_angle[i], measures.aspect_ratio[i], measures.skewness[i], measures.edge_ratio[i]};
+        for (size_t k{}; k < 4; k++)
+        {
+            ASSERT_NEAR(res[k], ref[k], 1e-8 * std::max(1., ref[k]));
+            min[k] = std::min(min[k], ref[k]);
+            max[k] = std::max(max[k], ref[k]);
+            sum[k] += ref[k];
+        }
+    }
+    std::array<const QualityStats<double> *, 4> stats{&report.min_angle, &report.aspect_ratio, &report.skewness, &report.edge_ratio};
+    for (size_t k{}; k < 4; k++)
+    {
+        ASSERT_NEAR(stats[k]->min, min[k], 1e-8 * std::max(1., min[k]));
+        ASSERT_NEAR(stats[k]->max, max[k], 1e-8 * std::max(1., max[k]));
+        ASSERT_NEAR(stats[k]->mean, sum[k] / mesh.triangles.size(), 1e-8 * std::max(1., max[k]));
+    }
+}
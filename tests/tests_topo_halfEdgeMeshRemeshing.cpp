@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <numbers>
+#include <set>
+#include <topology/tessellations.h>
+#include <topology/halfEdgeMeshRemeshing.h>
+
+using namespace gbs;
+
+namespace
+{
+    // links' consistency and orientation of a triangles' list
+    template <std::floating_point T>
+    void check_mesh(const std::list<std::shared_ptr<HalfEdgeFace<T, 2>>> &faces_lst)
+    {
+        std::unordered_set<HalfEdgeFace<T, 2> *> faces;
+        for (const auto &h_f : faces_lst)
+            ASSERT_TRUE(faces.insert(h_f.get()).second);
+        for (const auto &h_f : faces_lst)
+        {
+            ASSERT_GT(is_ccw(h_f), 0.);
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                ASSERT_EQ(h_e->face, h_f);
+                ASSERT_EQ(h_e->next->previous, h_e);
+                ASSERT_TRUE(h_e->vertex->edge);
+                ASSERT_EQ(h_e->vertex->edge->vertex, h_e->vertex);
+                ASSERT_TRUE(faces.contains(h_e->vertex->edge->face.get()));
+                if (h_e->opposite)
+                {
+                    ASSERT_EQ(h_e->opposite->opposite, h_e);
+                    ASSERT_EQ(h_e->opposite->vertex, h_e->previous->vertex);
+                    ASSERT_TRUE(faces.contains(h_e->opposite->face.get()));
+                }
+            }
+        }
+    }
+
+    auto random_points(size_t n, unsigned int seed)
+    {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<double> dist{0., 1.};
+        std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+        for (size_t i{}; i < n; i++)
+            coords.push_back({dist(gen), dist(gen)});
+        return coords;
+    }
+
+    auto sorted_triangles(const std::list<std::shared_ptr<HalfEdgeFace<double, 2>>> &faces_lst)
+    {
+        std::vector<std::vector<std::array<double, 2>>> triangles;
+        for (const auto &h_f : faces_lst)
+        {
+            auto coords = getFaceCoords(h_f);
+            std::vector<std::array<double, 2>> tri(coords.begin(), coords.end());
+            std::ranges::rotate(tri, std::ranges::min_element(tri));
+            triangles.push_back(tri);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+
+    auto make_surface()
+    {
+        std::vector<double> k = {0., 0., 0., 1., 1., 1.};
+        points_vector<double, 3> poles;
+        for (size_t j{}; j < 3; j++)
+            for (size_t i{}; i < 3; i++)
+                poles.push_back({i * i * 0.5, j * 1., (i == 1 && j == 1 ? 0.5 : 0.)});
+        return BSSurface<double, 3>(poles, k, k, 2, 2);
+    }
+}
+
+TEST(tests_topo_halfEdgeMeshRemeshing, collapse)
+{
+    // a fan around a center vertex, collapsed onto one of its neighbors
+    std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}, {0.5, 0.5}, {0.55, 0.45}};
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+    auto n_faces = faces_lst.size();
+    auto area = getTriangle2dMeshArea(faces_lst);
+    std::shared_ptr<HalfEdge<double, 2>> h_e;
+    for (const auto &h_f : faces_lst)
+        for (const auto &h_e_f : getFaceEdges(h_f))
+            if (h_e_f->vertex->coords == coords[4] && h_e_f->previous->vertex->coords == coords[5])
+                h_e = h_e_f;
+    ASSERT_TRUE(h_e);
+    auto removed = collapseHalfEdge(h_e);
+    std::erase_if(faces_lst, [&removed](const auto &h_f) { return std::ranges::find(removed, h_f) != removed.end(); });
+    ASSERT_EQ(faces_lst.size(), n_faces - 2);
+    check_mesh(faces_lst);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-12);
+    ASSERT_EQ((getVerticesVectorFromFaces<double, 2>(faces_lst).size()), 5);
+}
+
+TEST(tests_topo_halfEdgeMeshRemeshing, remesh)
+{
+    auto srf = make_surface();
+    std::mt19937 gen{4};
+    std::uniform_real_distribution<double> dist{0., 1.};
+    std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+    for (size_t i{}; i < 300; i++)
+        coords.push_back({dist(gen), dist(gen)});
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+    auto area = getTriangle2dMeshArea(faces_lst);
+
+    // graded size field
+    auto size = [](const std::array<double, 2> &uv) { return 0.02 + 0.08 * uv[0]; };
+
+    auto counts = remesh(faces_lst, srf, size, 5);
+
+    check_mesh(faces_lst);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-12);
+    ASSERT_GT(counts.splits, 0);
+    ASSERT_GT(counts.collapses, 0);
+    ASSERT_GT(counts.flips, 0);
+
+    // inner edges' lengths on the surface fit the size field
+    size_t n_edges{}, n_fit{};
+    for (const auto &h_f : faces_lst)
+        for (const auto &h_e : getFaceEdges(h_f))
+            if (h_e->opposite)
+            {
+                auto ratio = std::sqrt(edge_sq_length(h_e, srf)) / size(edge_midpoint(h_e));
+                n_edges++;
+                n_fit += ratio > 0.5 && ratio < 4. / 3.;
+            }
+    ASSERT_GT(double(n_fit) / n_edges, 0.95);
+    ASSERT_GT(getTriangleMeshMinQuality(faces_lst), 0.);
+}
+
+TEST(tests_topo_halfEdgeMeshRemeshing, split)
+{
+    auto srf = make_surface();
+    auto size = [](const std::array<double, 2> &) { return 0.2; };
+    LongestEdgeOnSurface<double, 3, decltype(size)> crit{srf, size};
+
+    // one split at a time gives the same mesh as the former loop, which scanned the faces for the longest edge at each step
+    auto faces_lst = delaunay2DBoyerWatson<double>(random_points(50, 5));
+    auto faces_ref = delaunay2DBoyerWatson<double>(random_points(50, 5));
+    auto n_splits = splitLongEdges(faces_lst, srf, size, 1);
+    size_t n_splits_ref{};
+    auto worst = [&crit](const auto &h_f) { return crit(h_f).first; };
+    for (auto it = std::ranges::max_element(faces_ref, {}, worst); crit(*it).first > remeshing::split_ratio<double>; it = std::ranges::max_element(faces_ref, {}, worst))
+    {
+        auto h_e = crit(*it).second;
+        std::list<std::shared_ptr<HalfEdgeFace<double, 2>>> h_f_lst_new;
+        splitHalfEdge(h_e, h_f_lst_new);
+        faces_ref.insert(faces_ref.end(), h_f_lst_new.begin(), h_f_lst_new.end());
+        n_splits_ref++;
+    }
+    ASSERT_GT(n_splits, 50);
+    ASSERT_EQ(n_splits, n_splits_ref);
+    ASSERT_EQ(sorted_triangles(faces_lst), sorted_triangles(faces_ref));
+
+    // concurrent splits
+    auto faces_par = delaunay2DBoyerWatson<double>(random_points(50, 5));
+    auto area = getTriangle2dMeshArea(faces_par);
+    ASSERT_GT(splitLongEdges(faces_par, srf, size, 256), 50);
+    check_mesh(faces_par);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_par), area, 1e-12);
+    for (const auto &h_f : faces_par)
+        ASSERT_LE(crit(h_f).first, remeshing::split_ratio<double>);
+}
+
+TEST(tests_topo_halfEdgeMeshRemeshing, constrained)
+{
+    auto srf = make_surface();
+    auto faces_lst = delaunay2DBoyerWatson<double>(random_points(300, 6));
+    std::vector<std::array<double, 2>> loop;
+    for (size_t i{}; i < 40; i++)
+    {
+        auto t = 2. * std::numbers::pi * double(i) / 40.;
+        loop.push_back({0.5 + 0.3 * std::cos(t), 0.5 + 0.3 * std::sin(t)});
+    }
+    insertConstrainedLoop(faces_lst, loop, 0.);
+
+    auto size = [](const std::array<double, 2> &uv) { return 0.02 + 0.08 * uv[0]; };
+    auto counts = remesh(faces_lst, srf, size, 3);
+    ASSERT_GT(counts.moves, 0);
+    check_mesh(faces_lst);
+
+    // constrained edges are split along the loop's segments, which keep their vertices
+    double length{}, length_ref{};
+    for (size_t i{}; i < loop.size(); i++)
+        length_ref += 2. * norm(loop[(i + 1) % loop.size()] - loop[i]);
+    std::set<std::array<double, 2>> vertices;
+    for (const auto &h_f : faces_lst)
+        for (const auto &h_e : getFaceEdges(h_f))
+            if (h_e->constrained)
+            {
+                const auto &a = h_e->previous->vertex->coords;
+                const auto &b = h_e->vertex->coords;
+                ASSERT_TRUE(h_e->opposite && h_e->opposite->constrained);
+                // on a segment, between its ends
+                auto on_segment = [&a, &b](const auto &p, const auto &q) {
+                    return std::abs(orient_2d(p, q, a)) < 1e-12 && std::abs(orient_2d(p, q, b)) < 1e-12 &&
+                           (a - p) * (q - p) > -1e-12 && (b - p) * (q - p) > -1e-12 && (a - q) * (p - q) > -1e-12 && (b - q) * (p - q) > -1e-12;
+                };
+                size_t n_segments{};
+                for (size_t i{}; i < loop.size(); i++)
+                    n_segments += on_segment(loop[i], loop[(i + 1) % loop.size()]);
+                ASSERT_EQ(n_segments, 1);
+                length += norm(b - a);
+                vertices.insert(b);
+            }
+    ASSERT_NEAR(length, length_ref, 1e-12);
+    for (const auto &p : loop)
+        ASSERT_TRUE(vertices.contains(p));
+}
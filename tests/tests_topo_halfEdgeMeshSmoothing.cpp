@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <map>
+#include <numbers>
+#include <topology/halfEdgeMeshSmoothing.h>
+#include <topology/tessellations.h>
+
+using namespace gbs;
+
+namespace
+{
+    // n x n squares split in two ccw triangles, inner vertices randomly moved
+    auto make_perturbed_grid(size_t n, double amplitude, unsigned int seed = 0)
+    {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<double> dist{-amplitude, amplitude};
+        CompactHalfEdgeMesh<double, 2> msh;
+        msh.reserve((n + 1) * (n + 1), 2 * n * n);
+        for (size_t j{}; j <= n; j++)
+            for (size_t i{}; i <= n; i++)
+            {
+                bool inner = i > 0 && j > 0 && i < n && j < n;
+                msh.addVertex({(i + (inner ? dist(gen) : 0.)) / n, (j + (inner ? dist(gen) : 0.)) / n});
+            }
+        auto id = [n](size_t i, size_t j) { return HeIndex(i + j * (n + 1)); };
+        for (size_t j{}; j < n; j++)
+            for (size_t i{}; i < n; i++)
+            {
+                msh.addFace({id(i, j), id(i + 1, j), id(i + 1, j + 1)});
+                msh.addFace({id(i, j), id(i + 1, j + 1), id(i, j + 1)});
+            }
+        msh.linkOpposites();
+        return msh;
+    }
+
+    auto min_quality(const CompactHalfEdgeMesh<double, 2> &msh)
+    {
+        double q{1.};
+        for (auto f : msh.faces())
+        {
+            auto x = msh.getFaceCoords(f);
+            q = std::min(q, tri_quality(x[0], x[1], x[2]));
+        }
+        return q;
+    }
+}
+
+TEST(tests_topo_halfEdgeMeshSmoothing, coloring)
+{
+    auto msh = make_perturbed_grid(20, 0.3);
+    auto faces_lst = to_shared_h_faces(msh);
+    auto stars = make_vertex_stars(getIndexedFaces<double, 2>(faces_lst));
+    ASSERT_EQ(stars.links.size(), 3 * faces_lst.size());
+    ASSERT_EQ(std::ranges::count(stars.free, true), 19 * 19);
+
+    auto colors = color_vertices(stars);
+    ASSERT_LE(colors.size(), 7);
+    std::vector<size_t> color_of(stars.free.size(), colors.size());
+    size_t n_colored{};
+    for (size_t c{}; c < colors.size(); c++)
+        for (auto v : colors[c])
+        {
+            color_of[v] = c;
+            n_colored++;
+        }
+    ASSERT_EQ(n_colored, 19 * 19);
+    for (size_t v{}; v < stars.free.size(); v++)
+        for (auto k = stars.offsets[v]; k < stars.offsets[v + 1]; k++)
+            for (auto w : stars.links[k])
+                ASSERT_TRUE(!stars.free[v] || color_of[v] != color_of[w]);
+}
+
+TEST(tests_topo_halfEdgeMeshSmoothing, planar)
+{
+    for (auto method : {SmoothingMethod::laplacian, SmoothingMethod::angle_based})
+    {
+        auto msh = make_perturbed_grid(40, 0.25, 1);
+        auto boundary = msh.coords(0);
+        auto q_ini = min_quality(msh);
+        ASSERT_GT(q_ini, 0.);
+        auto n_moves = smooth_vertices(msh, method, 20);
+        ASSERT_GT(n_moves, 39 * 39);
+        ASSERT_EQ(msh.coords(0), boundary);
+        ASSERT_GT(min_quality(msh), 2. * q_ini);
+        // a regular grid's inner vertex moves back to its place
+        ASSERT_NEAR(msh.coords(20 + 20 * 41)[0], 0.5, 0.02);
+        ASSERT_NEAR(msh.coords(20 + 20 * 41)[1], 0.5, 0.02);
+    }
+
+    // shared pointers' structure
+    auto faces_lst = delaunay2DBoyerWatson<double>(std::vector<std::array<double, 2>>{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}, {0.9, 0.9}, {0.85, 0.92}, {0.2, 0.5}});
+    auto area = getTriangle2dMeshArea(faces_lst);
+    auto q_ini = getTriangleMeshMinQuality(faces_lst);
+    ASSERT_GT(smooth_vertices(faces_lst, SmoothingMethod::laplacian, 10), 0);
+    ASSERT_GT(getTriangleMeshMinQuality(faces_lst), q_ini);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-12);
+}
+
+TEST(tests_topo_halfEdgeMeshSmoothing, on_surface)
+{
+    // strongly stretched parametrization
+    std::vector<double> k = {0., 0., 0., 1., 1., 1.};
+    points_vector<double, 3> poles;
+    for (size_t j{}; j < 3; j++)
+        for (size_t i{}; i < 3; i++)
+            poles.push_back({i * i * 0.5, j * 1., (i == 1 && j == 1 ? 0.5 : 0.)});
+    BSSurface<double, 3> srf(poles, k, k, 2, 2);
+
+    std::mt19937 gen{2};
+    std::uniform_real_distribution<double> dist{0., 1.};
+    std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+    for (size_t i{}; i < 2000; i++)
+        coords.push_back({dist(gen), dist(gen)});
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+
+    auto quality_3d = [&srf](const auto &faces_lst) {
+        auto mesh = make_surface_tessellation(faces_lst, srf);
+        std::vector<double> q(mesh.triangles.size());
+        std::transform(mesh.triangles.begin(), mesh.triangles.end(), q.begin(), [&mesh](const auto &t) {
+            return tri_quality(mesh.points[t[0]], mesh.points[t[1]], mesh.points[t[2]]);
+        });
+        std::sort(q.begin(), q.end());
+        return q;
+    };
+    auto q_ini = quality_3d(faces_lst);
+    auto n_moves = smooth_vertices_on_surface(faces_lst, srf, 10);
+    ASSERT_GT(n_moves, 0);
+    auto q_end = quality_3d(faces_lst);
+    ASSERT_GE(q_end.front(), q_ini.front());
+    // the median triangle got better
+    ASSERT_GT(q_end[q_end.size() / 2], q_ini[q_ini.size() / 2]);
+    for (const auto &h_f : faces_lst)
+        ASSERT_GT(is_ccw(h_f), 0.);
+}
+
+TEST(tests_topo_halfEdgeMeshSmoothing, performance)
+{
+    auto msh = make_perturbed_grid(700, 0.3, 3);
+    auto v_lst = msh.vertices();
+    auto f_lst = msh.faces();
+    std::vector<std::array<HeIndex, 3>> triangles(f_lst.size());
+    std::transform(f_lst.begin(), f_lst.end(), triangles.begin(), [&msh](HeIndex f) {
+        auto e = msh.faceEdge(f);
+        return std::array<HeIndex, 3>{msh.vertex(e), msh.vertex(msh.next(e)), msh.vertex(msh.previous(e))};
+    });
+    auto stars = make_vertex_stars(v_lst.size(), triangles);
+    auto colors = color_vertices(stars);
+
+    // sequential sweep, one vertex at a time in colors' order, each move reading the previous ones
+    std::vector<std::array<double, 2>> coords_ref(v_lst.size());
+    std::transform(v_lst.begin(), v_lst.end(), coords_ref.begin(), [&msh](HeIndex v) { return msh.coords(v); });
+    size_t n_moves_ref{};
+    for (const auto &color : colors)
+    {
+        for (auto v : color)
+        {
+            auto first = stars.offsets[v], last = stars.offsets[v + 1];
+            auto star_quality = [&](const std::array<double, 2> &X) {
+                double q{1.};
+                for (auto k = first; k < last; k++)
+                    q = std::min(q, tri_quality<double, 2>(X, coords_ref[stars.links[k][0]], coords_ref[stars.links[k][1]]));
+                return q;
+            };
+            std::array<double, 2> X{};
+            for (auto k = first; k < last; k++)
+                X = X + coords_ref[stars.links[k][0]];
+            X = X / static_cast<double>(last - first);
+            if (X != coords_ref[v] && star_quality(X) >= star_quality(coords_ref[v]))
+            {
+                coords_ref[v] = X;
+                n_moves_ref++;
+            }
+        }
+    }
+
+    auto n_moves = smooth_vertices<double>(stars, colors, [&msh](HeIndex v) -> auto & { return msh.coords(v); });
+    ASSERT_GT(n_moves, 0);
+    ASSERT_EQ(n_moves, n_moves_ref);
+    for (auto v : v_lst)
+    {
+        ASSERT_EQ(msh.coords(v), coords_ref[v]);
+    }
+}
+
+TEST(tests_topo_halfEdgeMeshSmoothing, constrained)
+{
+    std::mt19937 gen{4};
+    std::uniform_real_distribution<double> dist{0., 1.};
+    std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+    for (size_t i{}; i < 2000; i++)
+        coords.push_back({dist(gen), dist(gen)});
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+    std::vector<std::array<double, 2>> loop;
+    for (size_t i{}; i < 40; i++)
+    {
+        auto t = 2. * std::numbers::pi * double(i) / 40.;
+        loop.push_back({0.5 + 0.3 * std::cos(t), 0.5 + 0.3 * std::sin(t)});
+    }
+    insertConstrainedLoop(faces_lst, loop, 0.);
+    auto msh = make_compact_h_mesh<double, 2>(faces_lst);
+
+    // constrained vertices stay in place
+    std::map<HalfEdgeVertex<double, 2> *, std::array<double, 2>> fixed;
+    for (const auto &h_f : faces_lst)
+        for (const auto &h_e : getFaceEdges(h_f))
+            if (h_e->constrained)
+            {
+                fixed[h_e->vertex.get()] = h_e->vertex->coords;
+                fixed[h_e->previous->vertex.get()] = h_e->previous->vertex->coords;
+            }
+    ASSERT_EQ(fixed.size(), loop.size());
+    ASSERT_GT(smooth_vertices(faces_lst, SmoothingMethod::laplacian, 10), 0);
+    for (const auto &[h_v, X] : fixed)
+        ASSERT_EQ(h_v->coords, X);
+
+    // compact structure
+    std::map<HeIndex, std::array<double, 2>> fixed_compact;
+    for (auto f : msh.faces())
+        for (auto e : msh.getFaceEdges(f))
+            if (msh.constrained(e))
+                fixed_compact[msh.vertex(e)] = msh.coords(msh.vertex(e));
+    ASSERT_EQ(fixed_compact.size(), loop.size());
+    ASSERT_GT(smooth_vertices(msh, SmoothingMethod::laplacian, 10), 0);
+    for (const auto &[v, X] : fixed_compact)
+        ASSERT_EQ(msh.coords(v), X);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <topology/tessellations.h>
+#include <topology/halfEdgeMeshQuality.h>
+
+using namespace gbs;
+
+TEST(tests_topo_robustPredicates, expansion)
+{
+    using namespace gbs::expansion;
+    auto u = std::ldexp(1., -30);
+    auto e = product(std::vector<double>{u, 1.}, std::vector<double>{u, 1.});
+    // (1 + 2^-30)^2 = (1 + 2^-29) + 2^-60, the first term fits in a double
+    ASSERT_EQ(e.size(), 2);
+    ASSERT_EQ(e[0], u * u);
+    ASSERT_EQ(e[1], 1. + 2. * u);
+    ASSERT_TRUE(sum(e, negate(e)).empty());
+    ASSERT_EQ(sign_component(difference(1., 1e-30)), 1.);
+    ASSERT_EQ(sign_component(sum(difference(1e-30, 1.), std::vector<double>{1.})), 1e-30);
+}
+
+TEST(tests_topo_robustPredicates, orient_2d)
+{
+    // Points of a tiny grid around the line y = x
+    auto u = std::numeric_limits<double>::epsilon();
+    std::array<double, 2> q{12., 12.}, r{24., 24.};
+    size_t naive_errors{};
+    for (int i{}; i < 64; i++)
+    {
+        for (int j{}; j < 64; j++)
+        {
+            std::array<double, 2> p{0.5 + i * u, 0.5 + j * u};
+            auto det = orient_2d(p, q, r);
+            auto expected = (j > i) - (j < i);
+            ASSERT_EQ((det > 0) - (det < 0), expected);
+            auto naive = (p[0] - r[0]) * (q[1] - r[1]) - (p[1] - r[1]) * (q[0] - r[0]);
+            if ((naive > 0) - (naive < 0) != expected)
+                naive_errors++;
+        }
+    }
+    // the floating point filter alone fails on this configuration
+    ASSERT_GT(naive_errors, 0);
+    // regular cases return the floating point determinant
+    ASSERT_EQ(orient_2d<double>({0., 0.}, {1., 0.}, {0., 1.}), 1.);
+}
+
+TEST(tests_topo_robustPredicates, in_circle)
+{
+    for (auto offset : {0., 1e3, 1e8})
+    {
+        std::array<double, 2> a{offset + 1., offset}, b{offset, offset + 1.}, c{offset - 1., offset};
+        ASSERT_EQ(in_circle(a, b, c, {offset, offset - 1.}), 0.);
+        ASSERT_GT(in_circle(a, b, c, {offset, offset}), 0.);
+        ASSERT_LT(in_circle(a, b, c, {offset + 2., offset}), 0.);
+    }
+    std::array<double, 2> a{1., 0.}, b{0., 1.}, c{-1., 0.};
+    ASSERT_GT(in_circle(a, b, c, {0., std::nextafter(-1., 0.)}), 0.);
+    ASSERT_LT(in_circle(a, b, c, {0., std::nextafter(-1., -2.)}), 0.);
+}
+
+TEST(tests_topo_robustPredicates, delaunay_grid)
+{
+    // Parametric grid: every square's vertices are cocircular
+    size_t n = 40;
+    std::vector<std::array<double, 2>> coords;
+    for (size_t j{}; j < n; j++)
+        for (size_t i{}; i < n; i++)
+            coords.push_back({0.1 * double(i) / double(n - 1), 1e4 + 0.1 * double(j) / double(n - 1)});
+
+    for (auto spatial_sort : {false, true})
+    {
+        auto faces_lst = delaunay2DBoyerWatson<double>(coords, 0., spatial_sort);
+        ASSERT_EQ((getVerticesVectorFromFaces<double, 2>(faces_lst).size()), n * n);
+        ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), 0.01, 1e-12);
+        for (const auto &h_f : faces_lst)
+        {
+            ASSERT_GT(is_ccw(h_f), 0.);
+            for (const auto &h_e : getFaceEdges(h_f))
+                ASSERT_LE(is_locally_delaunay(h_e), 0.);
+        }
+    }
+}
@@ -0,0 +1,446 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <topology/tessellations.h>
+#include <topology/halfEdgeMeshQuality.h>
+#include <topology/halfEdgeMeshQueue.h>
+
+using namespace gbs;
+
+namespace
+{
+    auto random_unit_square_points(size_t n, unsigned int seed = 0)
+    {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<double> dist{0., 1.};
+        std::vector<std::array<double, 2>> coords{{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+        for (size_t i{}; i < n; i++)
+            coords.push_back({dist(gen), dist(gen)});
+        return coords;
+    }
+
+    auto unit_square_boundary(size_t n)
+    {
+        std::vector<std::array<double, 2>> coords;
+        for (size_t i{}; i < n; i++)
+        {
+            auto t = double(i) / double(n);
+            coords.push_back({t, 0.});
+            coords.push_back({1., t});
+            coords.push_back({1. - t, 1.});
+            coords.push_back({0., 1. - t});
+        }
+        return coords;
+    }
+
+    void check_delaunay(const auto &faces_lst, double tol)
+    {
+        for (const auto &h_f : faces_lst)
+        {
+            ASSERT_GT(is_ccw(h_f), 0.);
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                ASSERT_LE(is_locally_delaunay(h_e), tol);
+                if (h_e->opposite)
+                {
+                    ASSERT_EQ(h_e->opposite->opposite, h_e);
+                }
+            }
+        }
+    }
+    // faces' sorted vertices' coordinates, sorted, to compare triangulations regardless of the faces' order
+    auto sorted_triangles(const auto &faces_lst)
+    {
+        std::vector<std::vector<std::array<double, 2>>> triangles;
+        for (const auto &h_f : faces_lst)
+        {
+            auto coords_lst = getFaceCoords(h_f);
+            std::vector<std::array<double, 2>> coords(coords_lst.begin(), coords_lst.end());
+            std::ranges::sort(coords);
+            triangles.push_back(coords);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+    // triangle's area, refined at its centroid
+    struct AreaCentroid
+    {
+        auto operator()(const std::shared_ptr<HalfEdgeFace<double, 2>> &h_f) const
+        {
+            auto [a, b, c] = getTriangleCoords(h_f);
+            return std::make_pair(std::abs(orient_2d(a, b, c)) / 2., std::array<double, 2>{(a[0] + b[0] + c[0]) / 3., (a[1] + b[1] + c[1]) / 3.});
+        }
+    };
+    // V - E + F = 1 for a mesh without holes
+    auto euler_characteristic(const auto &faces_lst)
+    {
+        size_t n_half_edges{}, n_boundary{};
+        for (const auto &h_f : faces_lst)
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                n_half_edges++;
+                if (!h_e->opposite)
+                    n_boundary++;
+            }
+        auto n_vertices = getVerticesVectorFromFaces<double, 2>(faces_lst).size();
+        return long(n_vertices) - long(n_half_edges + n_boundary) / 2 + long(faces_lst.size());
+    }
+}
+
+TEST(tests_topo_tessellations, locate_face)
+{
+    // keeps the encompassing mesh, so that every point of the square is inside
+    auto coords = random_unit_square_points(500);
+    auto h_f_start = getEncompassingMesh(coords).back();
+    for (const auto &xy : coords)
+        h_f_start = std::get<2>(boyerWatson<double>(h_f_start, xy)).back();
+
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<double> dist{0., 1.};
+    for (size_t i{}; i < 100; i++)
+    {
+        std::array<double, 2> xy{dist(gen), dist(gen)};
+        auto h_f = locateFace(h_f_start, xy);
+        ASSERT_TRUE(h_f);
+        for (const auto &h_e : getFaceEdges(h_f))
+            ASSERT_GE(orient_2d(h_e->previous->vertex->coords, h_e->vertex->coords, xy), 0.);
+    }
+    ASSERT_FALSE(locateFace(h_f_start, std::array<double, 2>{2., 0.5}));
+}
+
+TEST(tests_topo_tessellations, delaunay_walk)
+{
+    size_t n = 20000;
+    auto coords = random_unit_square_points(n);
+
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords, 1e-10, false);
+
+    check_delaunay(faces_lst, 1e-10);
+    ASSERT_EQ(euler_characteristic(faces_lst), 1);
+    // the external faces' removal may loose some hull triangles
+    auto area = getTriangle2dMeshArea(faces_lst);
+    ASSERT_LE(area, 1. + 1e-10);
+    ASSERT_GT(area, 0.99);
+}
+
+TEST(tests_topo_tessellations, boyer_watson_container)
+{
+    auto coords = random_unit_square_points(200, 2);
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+    auto n_faces = faces_lst.size();
+    auto area = getTriangle2dMeshArea(faces_lst);
+
+    // inner point
+    auto [vtx, deleted, added] = boyerWatson<double>(faces_lst, {0.5, 0.5});
+    ASSERT_TRUE(vtx);
+    ASSERT_EQ(added.size(), deleted.size() + 2);
+    ASSERT_EQ(faces_lst.size(), n_faces + 2);
+    for (const auto &h_f : deleted)
+        ASSERT_TRUE(std::ranges::find(faces_lst, h_f) == faces_lst.end());
+    check_delaunay(faces_lst, 1e-10);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-10);
+
+    // duplicated point
+    ASSERT_FALSE(std::get<0>(boyerWatson<double>(faces_lst, {0.5, 0.5})));
+    ASSERT_EQ(faces_lst.size(), n_faces + 2);
+
+    // point outside the mesh, but inside some circumcircles
+    ASSERT_FALSE(std::get<0>(boyerWatson<double>(faces_lst, {0.5, -1e-3})));
+    ASSERT_EQ(faces_lst.size(), n_faces + 2);
+    check_delaunay(faces_lst, 1e-10);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-10);
+
+    // point outside every circumcircle
+    ASSERT_FALSE(std::get<0>(boyerWatson<double>(faces_lst, {5., 5.})));
+    ASSERT_EQ(faces_lst.size(), n_faces + 2);
+    ASSERT_EQ(euler_characteristic(faces_lst), 1);
+}
+
+TEST(tests_topo_tessellations, brio_order)
+{
+    size_t n = 100000;
+    auto coords = random_unit_square_points(n, 3);
+
+    auto order = brio_order(coords);
+    auto sorted = order;
+    std::ranges::sort(sorted);
+    for (size_t i{}; i < sorted.size(); i++)
+        ASSERT_EQ(sorted[i], i);
+
+    // consecutive points along the Hilbert curve are close
+    auto h_order = hilbert_order(coords);
+    double path{}, path_input{};
+    for (size_t i{1}; i < coords.size(); i++)
+    {
+        path += std::hypot(coords[h_order[i]][0] - coords[h_order[i - 1]][0], coords[h_order[i]][1] - coords[h_order[i - 1]][1]);
+        path_input += std::hypot(coords[i][0] - coords[i - 1][0], coords[i][1] - coords[i - 1][1]);
+    }
+    ASSERT_LT(path, path_input / 50.);
+
+    // in_circle's magnitude is in edge length^4, the default tolerance would skip points
+    auto faces_lst = delaunay2DBoyerWatson<double>(coords, 0.);
+
+    check_delaunay(faces_lst, 1e-16);
+    ASSERT_EQ(euler_characteristic(faces_lst), 1);
+    ASSERT_EQ((getVerticesVectorFromFaces<double, 2>(faces_lst).size()), coords.size());
+
+    // same triangulation as the insertion in input order, from any points' container
+    std::list<std::array<double, 2>> coords_ref(coords.begin(), std::next(coords.begin(), 10000));
+    auto triangles_ref = sorted_triangles(delaunay2DBoyerWatson<double>(coords_ref, 0., false));
+    ASSERT_EQ(sorted_triangles(delaunay2DBoyerWatson<double>(coords_ref, 0.)), triangles_ref);
+}
+
+TEST(tests_topo_tessellations, face_quality_queue)
+{
+    auto faces_lst = delaunay2DBoyerWatson<double>(random_unit_square_points(50));
+    // the criterion is kept by value, a temporary is fine
+    using Criterion = MaxEdgeSize<double, 2>;
+    FaceQualityQueue<double, 2, Criterion> queue{Criterion{}};
+    queue.push(faces_lst);
+    ASSERT_EQ(queue.size(), faces_lst.size());
+
+    // erased faces are skipped
+    auto worst = queue.top().face;
+    queue.erase(worst);
+    ASSERT_FALSE(queue.contains(worst));
+    ASSERT_NE(queue.top().face, worst);
+    // updated faces keep their last quality
+    queue.push(worst, {1e3, {}});
+    ASSERT_EQ(queue.top().face, worst);
+    queue.push(worst, {-1., {}});
+    ASSERT_NE(queue.top().face, worst);
+
+    double q_prev = std::numeric_limits<double>::max();
+    size_t count{};
+    while (!queue.empty())
+    {
+        auto e = queue.pop();
+        ASSERT_LE(e.quality.first, q_prev);
+        ASSERT_NEAR(e.quality.first, e.face == worst ? -1. : Criterion{}(e.face).first, 1e-15);
+        q_prev = e.quality.first;
+        count++;
+    }
+    ASSERT_EQ(count, faces_lst.size());
+}
+
+TEST(tests_topo_tessellations, delaunay_refine)
+{
+    double dm{0.02};
+    auto coords = unit_square_boundary(50);
+
+    // the queue refines the same faces as the former loop, which scanned the faces for the worst one at each step
+    {
+        AreaCentroid crit{};
+        double area_max{1e-3};
+        auto faces_ref = delaunay2DBoyerWatson<double>(random_unit_square_points(20, 4));
+        auto faces_lst = delaunay2DBoyerWatson<double>(random_unit_square_points(20, 4));
+        FaceQualityQueue<double, 2, AreaCentroid> queue{crit};
+        queue.push(faces_lst);
+        delaunay2DBoyerWatsonQueueRefine(faces_lst, queue, area_max, 100000, 0., 1,
+            [](const auto &) { return std::list<std::shared_ptr<HalfEdgeFace<double, 2>>>{}; });
+
+        auto worst = [&crit](const auto &h_f) { return crit(h_f).first; };
+        for (auto it = std::ranges::max_element(faces_ref, {}, worst); crit(*it).first > area_max; it = std::ranges::max_element(faces_ref, {}, worst))
+        {
+            ASSERT_TRUE(std::get<0>(boyerWatson<double>(faces_ref, crit(*it).second, 0.)));
+        }
+        ASSERT_GT(faces_lst.size(), 1000);
+        ASSERT_EQ(sorted_triangles(faces_lst), sorted_triangles(faces_ref));
+    }
+
+    for (size_t batch_size : {1, 64})
+    {
+        auto faces_lst = delaunay2DBoyerWatson<double>(coords);
+        delaunay2DBoyerWatsonMeshRefine<double, 2, MaxEdgeSize<double, 2>>(faces_lst, dm * dm, 100000, 1e-12, batch_size);
+
+        ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), 1., 1e-10);
+        ASSERT_EQ(euler_characteristic(faces_lst), 1);
+        for (const auto &h_f : faces_lst)
+        {
+            ASSERT_GT(is_ccw(h_f), 0.);
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                ASSERT_LE(is_locally_delaunay(h_e), 1e-12);
+                if (h_e->opposite)
+                {
+                    ASSERT_LE(edge_sq_length(h_e), dm * dm);
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+    auto circle_points(size_t n, double r, double x0 = 0.5, double y0 = 0.5)
+    {
+        std::vector<std::array<double, 2>> coords;
+        for (size_t i{}; i < n; i++)
+        {
+            auto t = 2. * std::numbers::pi * double(i) / double(n);
+            coords.push_back({x0 + r * std::cos(t), y0 + r * std::sin(t)});
+        }
+        return coords;
+    }
+
+    auto polygon_area(const std::vector<std::array<double, 2>> &coords)
+    {
+        double area{};
+        for (size_t i{}; i < coords.size(); i++)
+        {
+            const auto &a = coords[i];
+            const auto &b = coords[(i + 1) % coords.size()];
+            area += a[0] * b[1] - a[1] * b[0];
+        }
+        return std::abs(area) / 2.;
+    }
+
+    void check_constrained_delaunay(const auto &faces_lst)
+    {
+        for (const auto &h_f : faces_lst)
+        {
+            ASSERT_GT(is_ccw(h_f), 0.);
+            for (const auto &h_e : getFaceEdges(h_f))
+            {
+                if (h_e->opposite)
+                {
+                    ASSERT_EQ(h_e->opposite->opposite, h_e);
+                    ASSERT_EQ(h_e->opposite->constrained, h_e->constrained);
+                    if (!h_e->constrained)
+                    {
+                        ASSERT_LE(is_locally_delaunay(h_e), 0.);
+                    }
+                }
+                else
+                {
+                    // the domain's boundary is made of constraints
+                    ASSERT_TRUE(h_e->constrained);
+                }
+            }
+        }
+    }
+}
+
+TEST(tests_topo_tessellations, constrained_delaunay)
+{
+    // Spiky star around a hole, the star's sides are not Delaunay edges of the points
+    std::vector<std::array<double, 2>> star;
+    for (size_t i{}; i < 24; i++)
+    {
+        auto t = 2. * std::numbers::pi * double(i) / 24.;
+        auto r = i % 2 ? 0.15 : 0.5;
+        star.push_back({0.5 + r * std::cos(t), 0.5 + r * std::sin(t)});
+    }
+    auto hole = circle_points(32, 0.1);
+    std::ranges::reverse(hole);
+    auto coords_inner = random_unit_square_points(2000, 4);
+
+    auto faces_lst = delaunay2DConstrained<double>({star, hole}, coords_inner);
+    check_constrained_delaunay(faces_lst);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), polygon_area(star) - polygon_area(hole), 1e-12);
+    ASSERT_EQ(euler_characteristic(faces_lst), 0);
+    size_t n_boundary{};
+    for (const auto &h_f : faces_lst)
+        for (const auto &h_e : getFaceEdges(h_f))
+            n_boundary += !h_e->opposite;
+    ASSERT_EQ(n_boundary, star.size() + hole.size());
+
+    // Steiner points don't cross the constraints
+    auto area = getTriangle2dMeshArea(faces_lst);
+    MaxEdgeSize<double, 2> crit{};
+    FaceQualityQueue<double, 2, MaxEdgeSize<double, 2>> queue{crit};
+    queue.push(faces_lst);
+    delaunay2DBoyerWatsonQueueRefine(faces_lst, queue, 0.02 * 0.02, 5000, 0., 16, [](const auto &) { return std::list<std::shared_ptr<HalfEdgeFace<double, 2>>>{}; });
+    check_constrained_delaunay(faces_lst);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), area, 1e-12);
+
+    // Crossing constraints are rejected
+    ASSERT_THROW(delaunay2DConstrained<double>({star, circle_points(16, 0.3)}), std::invalid_argument);
+}
+
+TEST(tests_topo_tessellations, constrained_bounds)
+{
+    auto faces_lst = delaunay2DBoyerWatson<double>(random_unit_square_points(5000, 5));
+
+    auto area = getTriangle2dMeshArea(faces_lst);
+    auto coords_inner = circle_points(200, 0.2);
+    auto coords_outer = circle_points(100, 0.45);
+    auto internal_faces = delaunay2DBoyerWatsonAddInnerBound(faces_lst, coords_inner, 0.);
+    auto external_faces = delaunay2DBoyerWatsonAddOuterBound(faces_lst, coords_outer, 0.);
+
+    check_constrained_delaunay(faces_lst);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_lst), polygon_area(coords_outer) - polygon_area(coords_inner), 1e-12);
+    ASSERT_NEAR(getTriangle2dMeshArea(internal_faces), polygon_area(coords_inner), 1e-12);
+    ASSERT_NEAR(getTriangle2dMeshArea(external_faces) + getTriangle2dMeshArea(faces_lst) + getTriangle2dMeshArea(internal_faces), area, 1e-12);
+    ASSERT_EQ(euler_characteristic(faces_lst), 0);
+
+    // Same faces as the former centroid tests, see takeInternalFaces, when the boundaries' segments are already Delaunay edges
+    std::vector<std::array<double, 2>> coords;
+    for (const auto &xy : random_unit_square_points(500, 5))
+    {
+        auto r = norm(xy - std::array<double, 2>{0.5, 0.5});
+        if (std::abs(r - 0.2) > 0.02 && std::abs(r - 0.45) > 0.02)
+            coords.push_back(xy);
+    }
+    auto faces_new = delaunay2DBoyerWatson<double>(coords);
+    delaunay2DBoyerWatsonAddInnerBound(faces_new, coords_inner, 0.);
+    delaunay2DBoyerWatsonAddOuterBound(faces_new, coords_outer, 0.);
+
+    auto coords_all = coords;
+    coords_all.insert(coords_all.end(), coords_inner.begin(), coords_inner.end());
+    coords_all.insert(coords_all.end(), coords_outer.begin(), coords_outer.end());
+    auto faces_ref = delaunay2DBoyerWatson<double>(coords_all, coords_inner, 0.);
+    takeExternalFaces<double>(faces_ref, make_HalfEdges<double>(coords_outer));
+    ASSERT_EQ(sorted_triangles(faces_new), sorted_triangles(faces_ref));
+
+    // Constrained counterpart of the inner boundary overload
+    auto faces_constrained = delaunay2DBoyerWatsonConstrained<double>(coords_outer, coords_inner, 0.);
+    check_constrained_delaunay(faces_constrained);
+    ASSERT_NEAR(getTriangle2dMeshArea(faces_constrained), polygon_area(coords_outer) - polygon_area(coords_inner), 1e-12);
+}
+
+TEST(tests_topo_tessellations, surface_tessellation_export)
+{
+    auto faces_lst = delaunay2DBoyerWatson<double>(random_unit_square_points(20000, 6));
+
+    std::vector<double> k = {0., 0., 0., 1., 1., 1.};
+    points_vector<double, 3> poles;
+    for (size_t j{}; j < 3; j++)
+        for (size_t i{}; i < 3; i++)
+            poles.push_back({i * 1., j * 1., (i == 1 && j == 1 ? 1. : 0.)});
+    BSSurface<double, 3> srf(poles, k, k, 2, 2);
+
+    auto mesh = make_surface_tessellation(faces_lst, srf);
+
+    ASSERT_EQ(mesh.points.size(), 20004);
+    ASSERT_EQ(mesh.uv.size(), mesh.points.size());
+    ASSERT_EQ(mesh.triangles.size(), faces_lst.size());
+    auto it = faces_lst.begin();
+    for (const auto &tri : mesh.triangles)
+    {
+        const auto &h_f = *(it++);
+        auto vertices = getFaceVertices(h_f);
+        auto h_v = vertices.begin();
+        for (auto i : tri)
+        {
+            ASSERT_LT(i, mesh.points.size());
+            ASSERT_EQ(mesh.uv[i], (*h_v)->coords);
+            ASSERT_LT(distance(mesh.points[i], srf(mesh.uv[i][0], mesh.uv[i][1])), 1e-14);
+            h_v++;
+        }
+    }
+
+    // Vertices' indices are shared with the mesh's vector of vertices
+    auto indexed = getIndexedFaces<double, 2>(faces_lst);
+    ASSERT_EQ(indexed.vertices.size(), mesh.points.size());
+    ASSERT_EQ(indexed.offsets.size(), faces_lst.size() + 1);
+    ASSERT_EQ(indexed.offsets.back(), 3 * faces_lst.size());
+    // same indices as the former export, through the vertices' map
+    auto vertices_map = getVerticesMapFromFaces<double, 2>(faces_lst);
+    ASSERT_EQ(vertices_map.size(), mesh.points.size());
+    for (const auto &[h_v, i] : vertices_map)
+    {
+        ASSERT_EQ(indexed.vertices[i], h_v);
+        ASSERT_EQ(mesh.uv[i], h_v->coords);
+    }
+    ASSERT_EQ((getEdgesMap<double, 2>(faces_lst).size()), 3 * faces_lst.size());
+}